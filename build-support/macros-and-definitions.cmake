@@ -646,6 +646,21 @@ macro(process_options)
     endif()
   endif()
 
+  set(ENABLE_ZLIB False)
+  if(${NS3_ZLIB})
+    find_external_library(
+      DEPENDENCY_NAME ZLIB HEADER_NAME zlib.h LIBRARY_NAME z
+    )
+
+    if(${ZLIB_FOUND})
+      set(ENABLE_ZLIB True)
+      add_definitions(-DHAVE_ZLIB)
+      include_directories(${ZLIB_INCLUDE_DIRS})
+    else()
+      message(${HIGHLIGHTED_STATUS} "zlib was not found")
+    endif()
+  endif()
+
   if(${NS3_NATIVE_OPTIMIZATIONS} AND ${GCC})
     add_compile_options(-march=native -mtune=native)
   endif()
@@ -1008,6 +1023,12 @@ macro(process_options)
     endif()
   endif()
 
+  set(ENABLE_MTP FALSE)
+  if(${NS3_MTP})
+    add_definitions(-DNS3_MTP)
+    set(ENABLE_MTP TRUE)
+  endif()
+
   mark_as_advanced(Boost_INCLUDE_DIR)
   find_package(Boost)
   if(${Boost_FOUND})
@@ -1334,6 +1355,10 @@ macro(process_options)
     list(REMOVE_ITEM libs_to_build mpi)
   endif()
 
+  if(NOT ${ENABLE_MTP})
+    list(REMOVE_ITEM libs_to_build mtp)
+  endif()
+
   if(NOT ${ENABLE_VISUALIZER})
     list(REMOVE_ITEM libs_to_build visualizer)
   endif()
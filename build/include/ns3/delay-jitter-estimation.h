@@ -0,0 +1 @@
+#include "/root/repo/src/network/helper/delay-jitter-estimation.h"
@@ -68,7 +68,7 @@ CallbackValue::SerializeToString(Ptr<const AttributeChecker> checker) const
 {
     NS_LOG_FUNCTION(this << checker);
     std::ostringstream oss;
-    oss << PeekPointer(m_value.GetImpl());
+    oss << m_value.GetImpl();
     return oss.str();
 }
 
@@ -81,6 +81,36 @@ CallbackValue::DeserializeFromString(std::string value, Ptr<const AttributeCheck
 
 ATTRIBUTE_CHECKER_IMPLEMENT(Callback);
 
+bool
+CallbackImplBase::IsEqual(const CallbackImplBase* other) const
+{
+    if (other == this)
+    {
+        return true;
+    }
+    std::size_t count = GetComponentCount();
+    if (other == nullptr || other->GetComponentCount() != count)
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < count; i++)
+    {
+        Component mine = GetComponent(i);
+        Component theirs = other->GetComponent(i);
+        // components shared by copies of a callback, such as lambdas,
+        // are only equal to themselves
+        if (mine.value == theirs.value)
+        {
+            continue;
+        }
+        if (*mine.type != *theirs.type || !mine.isEqual(mine.value, theirs.value))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace ns3
 
 #if (__GNUC__ >= 3)
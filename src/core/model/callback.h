@@ -27,8 +27,13 @@
 #include "ptr.h"
 #include "simple-ref-count.h"
 
+#include <array>
+#include <cstddef>
 #include <functional>
 #include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
 #include <typeinfo>
 #include <utility>
 #include <vector>
@@ -75,7 +80,7 @@ namespace ns3
 /**
  * \ingroup callbackimpl
  * Abstract base class for CallbackImpl
- * Provides reference counting and equality test.
+ * Provides reference counting, copy and equality test.
  */
 class CallbackImplBase : public SimpleRefCount<CallbackImplBase>
 {
@@ -86,17 +91,53 @@ class CallbackImplBase : public SimpleRefCount<CallbackImplBase>
     }
 
     /**
-     * Equality test
+     * Equality test.
      *
-     * \param [in] other Callback Ptr
+     * Two implementations are equal if they call the same function with
+     * bound arguments of the same types and values, regardless of how
+     * the arguments were bound.
+     *
+     * \param [in] other Callback implementation
      * \return \c true if we are equal
      */
-    virtual bool IsEqual(Ptr<const CallbackImplBase> other) const = 0;
+    bool IsEqual(const CallbackImplBase* other) const;
+
+    /**
+     * A component of a callback: the callable object or a bound argument.
+     */
+    struct Component
+    {
+        const std::type_info* type;                //!< The type of the value
+        const void* value;                         //!< The value
+        bool (*isEqual)(const void*, const void*); //!< Equality test of two values of this type
+    };
+
+    /**
+     * Get the number of components, i.e., the callable object and the
+     * bound arguments.
+     * \return The number of components
+     */
+    virtual std::size_t GetComponentCount() const = 0;
+    /**
+     * Get a component.
+     * \param [in] i The index of the component, the callable object being the first one
+     * \return The component
+     */
+    virtual Component GetComponent(std::size_t i) const = 0;
     /**
      * Get the name of this object type.
      * \return The object type as a string.
      */
     virtual std::string GetTypeid() const = 0;
+    /**
+     * Copy this object into the inline storage of a CallbackBase.
+     *
+     * Only called on objects small enough to be stored inline.
+     *
+     * \param [in] storage The storage.
+     * \return The copy.
+     */
+    virtual CallbackImplBase* CopyTo(void* storage) const = 0;
 
   protected:
     /**
@@ -130,262 +171,377 @@ class CallbackImplBase : public SimpleRefCount<CallbackImplBase>
 
 /**
  * \ingroup callbackimpl
- * Abstract base class for CallbackComponent.
- * Provides equality test.
+ * CallbackImpl class with varying numbers of argument types
+ *
+ * \tparam R \explicit The return type of the Callback.
+ * \tparam UArgs \explicit The types of any arguments to the Callback.
  */
-class CallbackComponentBase
+template <typename R, typename... UArgs>
+class CallbackImpl : public CallbackImplBase
 {
   public:
-    /** Virtual destructor */
-    virtual ~CallbackComponentBase()
-    {
-    }
-
     /**
-     * Equality test
+     * Function call operator.
      *
-     * \param [in] other CallbackComponent Ptr
-     * \return \c true if we are equal
+     * \param uargs The arguments to the Callback.
+     * \return Callback value
      */
-    virtual bool IsEqual(std::shared_ptr<const CallbackComponentBase> other) const = 0;
+    virtual R operator()(UArgs... uargs) const = 0;
+
+    std::string GetTypeid() const override
+    {
+        return DoGetTypeid();
+    }
+
+    /** \copydoc GetTypeid(). */
+    static std::string DoGetTypeid()
+    {
+        static std::vector<std::string> vec = {GetCppTypeid<R>(), GetCppTypeid<UArgs>()...};
+
+        static std::string id("CallbackImpl<");
+        for (auto& s : vec)
+        {
+            id.append(s + ",");
+        }
+        if (id.back() == ',')
+        {
+            id.pop_back();
+        }
+        id.push_back('>');
+
+        return id;
+    }
 };
 
 /**
  * \ingroup callbackimpl
- * Stores a component of a callback, i.e., the callable object
- * or a bound argument. The purpose of this class is to test
- * the equality of the components of two callbacks.
+ * Base class for Callback class.
  *
- * \tparam T The type of the callback component.
- * \tparam isComparable whether this callback component can be compared to others of the same type
+ * Holds the CallbackImpl.  Implementations which are small and can
+ * be compared by value, such as a function or method pointer with an
+ * object pointer and a few bound arguments, are stored inline and
+ * copied with the callback, so that building, copying and destroying
+ * such a callback does not allocate memory nor count references.
+ * Larger implementations, and the ones which hold a lambda or another
+ * callable object which cannot be compared, are allocated on the heap
+ * and shared by the copies of the callback.
  */
-template <typename T, bool isComparable = true>
-class CallbackComponent : public CallbackComponentBase
+class CallbackBase
 {
   public:
+    CallbackBase()
+        : m_impl(nullptr)
+    {
+    }
+
     /**
-     * Constructor
-     *
-     * \param [in] t The value of the callback component
+     * Copy constructor
+     * \param [in] other The callback to copy
      */
-    CallbackComponent(const T& t)
-        : m_comp(t)
+    CallbackBase(const CallbackBase& other)
+        : m_impl(nullptr)
     {
+        CopyFrom(other);
     }
 
     /**
-     * Equality test between the values of two components
-     *
-     * \param [in] other CallbackComponentBase Ptr
-     * \return \c true if we are equal
+     * Assignment operator
+     * \param [in] other The callback to copy
+     * \return This callback
      */
-    bool IsEqual(std::shared_ptr<const CallbackComponentBase> other) const override
+    CallbackBase& operator=(const CallbackBase& other)
     {
-        auto p = std::dynamic_pointer_cast<const CallbackComponent<T>>(other);
-
-        // other must have the same type and value as ours
-        if (p == nullptr || p->m_comp != m_comp)
+        if (this != &other)
         {
-            return false;
+            Release();
+            CopyFrom(other);
         }
+        return *this;
+    }
 
-        return true;
+    ~CallbackBase()
+    {
+        Release();
     }
 
-  private:
-    T m_comp; //!< the value of the callback component
-};
+    /**
+     * \return The impl pointer, valid until this callback is modified or destroyed
+     */
+    const CallbackImplBase* GetImpl() const
+    {
+        return m_impl;
+    }
+
+  protected:
+    /**
+     * Construct from a pimpl
+     * \param [in] impl The CallbackImplBase Ptr
+     */
+    CallbackBase(Ptr<CallbackImplBase> impl)
+        : m_impl(PeekPointer(impl))
+    {
+        if (m_impl != nullptr)
+        {
+            m_impl->Ref();
+        }
+    }
 
-/**
- * \ingroup callbackimpl
- * Partial specialization of class CallbackComponent with isComparable equal
- * to false. This is required to handle callable objects (such as lambdas and
- * objects returned by std::function and std::bind) that do not provide the
- * equality operator. Given that these objects cannot be compared and the only
- * purpose of the class CallbackComponent is to compare values, no object is
- * stored in this specialized class.
- *
- * \tparam T The type of the callback component.
- */
-template <typename T>
-class CallbackComponent<T, false> : public CallbackComponentBase
-{
-  public:
     /**
-     * Constructor
+     * Replace the implementation with a new one, inline if possible.
      *
-     * \param [in] t The value of the callback component
+     * \tparam Impl \explicit The type of the implementation.
+     * \tparam Args \deduced The types of the constructor arguments.
+     * \param [in] args The constructor arguments.
      */
-    CallbackComponent(const T& t)
+    template <typename Impl, typename... Args>
+    void Emplace(Args&&... args)
     {
+        Release();
+        if constexpr (IS_INLINE<Impl>)
+        {
+            m_impl = new (m_storage) Impl(std::forward<Args>(args)...);
+        }
+        else
+        {
+            m_impl = new Impl(std::forward<Args>(args)...);
+        }
+    }
+
+    /** Discard the implementation. */
+    void Release()
+    {
+        if (m_impl == nullptr)
+        {
+            return;
+        }
+        if (IsInline())
+        {
+            m_impl->~CallbackImplBase();
+        }
+        else
+        {
+            m_impl->Unref();
+        }
+        m_impl = nullptr;
     }
 
     /**
-     * Equality test between functions
+     * Copy, or share, the implementation of another callback.
+     * \param [in] other The other callback.
+     */
+    void CopyFrom(const CallbackBase& other)
+    {
+        if (other.m_impl == nullptr)
+        {
+            m_impl = nullptr;
+        }
+        else if (other.IsInline())
+        {
+            m_impl = other.m_impl->CopyTo(m_storage);
+        }
+        else
+        {
+            m_impl = other.m_impl;
+            m_impl->Ref();
+        }
+    }
+
+    /**
+     * The implementations are constructed at the start of the inline
+     * storage, and CallbackImplBase is their primary base, so they start
+     * at its address.  Unlike a range check, the equality lets GCC prove
+     * that an implementation allocated on the heap is not inline, instead
+     * of warning about its copy into the storage.
      *
-     * \param [in] other CallbackParam Ptr
-     * \return \c true if we are equal
+     * \return \c true if the implementation is stored inline
      */
-    bool IsEqual(std::shared_ptr<const CallbackComponentBase> other) const override
+    bool IsInline() const
     {
-        return false;
+        return static_cast<const void*>(m_impl) == m_storage;
     }
-};
 
-/// Vector of callback components
-typedef std::vector<std::shared_ptr<CallbackComponentBase>> CallbackComponentVector;
+    /// Friend class, copying its implementations into the inline storage
+    template <typename R, typename T, typename BTuple, typename... UArgs>
+    friend class CallbackFunctorImpl;
+
+    /** Size of the inline storage. */
+    static constexpr std::size_t INLINE_SIZE = 6 * sizeof(void*);
+
+    /**
+     * Whether an implementation is stored inline.
+     * \tparam Impl \explicit The type of the implementation.
+     */
+    template <typename Impl>
+    static constexpr bool IS_INLINE = Impl::IS_COMPARABLE && sizeof(Impl) <= INLINE_SIZE &&
+                                      alignof(Impl) <= alignof(void*);
+
+    alignas(void*) unsigned char m_storage[INLINE_SIZE]; //!< the inline storage
+    CallbackImplBase* m_impl;                            //!< the pimpl
+};
 
 /**
  * \ingroup callbackimpl
- * CallbackImpl class with varying numbers of argument types
+ * CallbackImpl holding a callable object and the values of the
+ * arguments bound to it.
  *
  * \tparam R \explicit The return type of the Callback.
- * \tparam UArgs \explicit The types of any arguments to the Callback.
+ * \tparam T \explicit The type of the callable object.
+ * \tparam BTuple \explicit The std::tuple of the types of the bound arguments.
+ * \tparam UArgs \explicit The types of the arguments left to the Callback.
  */
-template <typename R, typename... UArgs>
-class CallbackImpl : public CallbackImplBase
+template <typename R, typename T, typename BTuple, typename... UArgs>
+class CallbackFunctorImpl : public CallbackImpl<R, UArgs...>
 {
   public:
+    /** Whether the callable object is a Callback, whose components are ours. */
+    static constexpr bool IS_CALLBACK = std::is_base_of_v<CallbackBase, T>;
     /**
-     * Constructor.
-     *
-     * \param func the callable object
-     * \param components the callback components (callable object and bound arguments)
+     * Whether the callable object can be compared by value.  Function
+     * pointers, pointers to members and callbacks can; other callable
+     * objects, such as lambdas and the objects returned by std::function
+     * and std::bind, do not provide the equality operator and are only
+     * equal to themselves.
      */
-    CallbackImpl(std::function<R(UArgs...)> func, const CallbackComponentVector& components)
-        : m_func(func),
-          m_components(components)
-    {
-    }
+    static constexpr bool IS_COMPARABLE = IS_CALLBACK ||
+                                          std::is_function_v<std::remove_pointer_t<T>> ||
+                                          std::is_member_pointer_v<T>;
 
     /**
-     * Get the stored function.
-     * \return A const reference to the stored function.
+     * Constructor.
+     *
+     * \tparam BArgs \deduced The types of the bound arguments
+     * \param [in] func The callable object
+     * \param [in] bargs The values of the bound arguments
      */
-    const std::function<R(UArgs...)>& GetFunction() const
+    template <typename... BArgs>
+    CallbackFunctorImpl(const T& func, BArgs&&... bargs)
+        : m_func(func),
+          m_bargs(std::forward<BArgs>(bargs)...)
     {
-        return m_func;
     }
 
-    /**
-     * Get the vector of callback components.
-     * \return A const reference to the vector of callback components.
-     */
-    const CallbackComponentVector& GetComponents() const
+    R operator()(UArgs... uargs) const override
     {
-        return m_components;
+        return std::apply(
+            [this, &uargs...](auto&... bargs) -> R {
+                if constexpr (std::is_void_v<R>)
+                {
+                    std::invoke(m_func, bargs..., std::forward<UArgs>(uargs)...);
+                }
+                else
+                {
+                    return std::invoke(m_func, bargs..., std::forward<UArgs>(uargs)...);
+                }
+            },
+            m_bargs);
     }
 
-    /**
-     * Function call operator.
-     *
-     * \param uargs The arguments to the Callback.
-     * \return Callback value
-     */
-    R operator()(UArgs... uargs) const
+    std::size_t GetComponentCount() const override
     {
-        return m_func(uargs...);
+        return GetFunctionComponentCount() + std::tuple_size_v<BTuple>;
     }
 
-    bool IsEqual(Ptr<const CallbackImplBase> other) const override
+    CallbackImplBase::Component GetComponent(std::size_t i) const override
     {
-        const CallbackImpl<R, UArgs...>* otherDerived =
-            dynamic_cast<const CallbackImpl<R, UArgs...>*>(PeekPointer(other));
-
-        if (otherDerived == nullptr)
+        std::size_t functionCount = GetFunctionComponentCount();
+        if (i >= functionCount)
         {
-            return false;
+            return GetBoundComponent(i - functionCount,
+                                     std::make_index_sequence<std::tuple_size_v<BTuple>>{});
         }
-
-        // if the two callback implementations are made of a distinct number of
-        // components, they are different
-        if (m_components.size() != otherDerived->GetComponents().size())
+        if constexpr (IS_CALLBACK)
         {
-            return false;
+            return m_func.GetImpl()->GetComponent(i);
         }
-
-        // the two functions are equal if they compare equal or the shared pointers
-        // point to the same locations
-        if (!m_components.at(0)->IsEqual(otherDerived->GetComponents().at(0)) &&
-            m_components.at(0) != otherDerived->GetComponents().at(0))
-        {
-            return false;
-        }
-
-        // check if the remaining components are equal one by one
-        for (std::size_t i = 1; i < m_components.size(); i++)
+        else
         {
-            if (!m_components.at(i)->IsEqual(otherDerived->GetComponents().at(i)))
-            {
-                return false;
-            }
+            return {&typeid(T), &m_func, &IsEqualFunction};
         }
-
-        return true;
     }
 
-    std::string GetTypeid() const override
+    CallbackImplBase* CopyTo(void* storage) const override
     {
-        return DoGetTypeid();
+        // Only the implementations emplaced inline are copied inline.
+        if constexpr (CallbackBase::IS_INLINE<CallbackFunctorImpl>)
+        {
+            static_assert(sizeof(CallbackFunctorImpl) <= CallbackBase::INLINE_SIZE &&
+                              alignof(CallbackFunctorImpl) <= alignof(void*),
+                          "The implementation does not fit in the inline storage");
+            return new (storage) CallbackFunctorImpl(*this);
+        }
+        else
+        {
+            NS_FATAL_ERROR("Copy of a callback implementation not stored inline");
+        }
     }
 
-    /** \copydoc GetTypeid(). */
-    static std::string DoGetTypeid()
+  private:
+    /** \return The number of components of the callable object */
+    std::size_t GetFunctionComponentCount() const
     {
-        static std::vector<std::string> vec = {GetCppTypeid<R>(), GetCppTypeid<UArgs>()...};
-
-        static std::string id("CallbackImpl<");
-        for (auto& s : vec)
+        if constexpr (IS_CALLBACK)
         {
-            id.append(s + ",");
+            return m_func.IsNull() ? 0 : m_func.GetImpl()->GetComponentCount();
         }
-        if (id.back() == ',')
+        else
         {
-            id.pop_back();
+            return 1;
         }
-        id.push_back('>');
-
-        return id;
     }
 
-  private:
-    /// Stores the callable object associated with this callback (as a lambda)
-    std::function<R(UArgs...)> m_func;
-
-    /// Stores the original callable object and the bound arguments, if any
-    std::vector<std::shared_ptr<CallbackComponentBase>> m_components;
-};
-
-/**
- * \ingroup callbackimpl
- * Base class for Callback class.
- * Provides pimpl abstraction.
- */
-class CallbackBase
-{
-  public:
-    CallbackBase()
-        : m_impl()
+    /**
+     * Get the component of a bound argument.
+     *
+     * \tparam INDEX \deduced The indexes of the bound arguments
+     * \param [in] i The index of the bound argument
+     * \return The component
+     */
+    template <std::size_t... INDEX>
+    CallbackImplBase::Component GetBoundComponent(std::size_t i,
+                                                  std::index_sequence<INDEX...>) const
     {
+        std::array<CallbackImplBase::Component, sizeof...(INDEX)> components = {
+            {{&typeid(std::tuple_element_t<INDEX, BTuple>),
+              &std::get<INDEX>(m_bargs),
+              &IsEqualBound<std::tuple_element_t<INDEX, BTuple>>}...}};
+        return components[i];
     }
 
-    /** \return The impl pointer */
-    Ptr<CallbackImplBase> GetImpl() const
+    /**
+     * Equality test of two callable objects.
+     * \param [in] a The first object
+     * \param [in] b The second object
+     * \return \c true if the objects are equal
+     */
+    static bool IsEqualFunction(const void* a, const void* b)
     {
-        return m_impl;
+        if constexpr (IS_COMPARABLE && !IS_CALLBACK)
+        {
+            return *static_cast<const T*>(a) == *static_cast<const T*>(b);
+        }
+        else
+        {
+            return false;
+        }
     }
 
-  protected:
     /**
-     * Construct from a pimpl
-     * \param [in] impl The CallbackImplBase Ptr
+     * Equality test of two bound arguments.
+     * \tparam U \explicit The type of the arguments
+     * \param [in] a The first argument
+     * \param [in] b The second argument
+     * \return \c true if the arguments are equal
      */
-    CallbackBase(Ptr<CallbackImplBase> impl)
-        : m_impl(impl)
+    template <typename U>
+    static bool IsEqualBound(const void* a, const void* b)
     {
+        return !(*static_cast<const U*>(a) != *static_cast<const U*>(b));
     }
 
-    Ptr<CallbackImplBase> m_impl; //!< the pimpl
+    /// The callable object; mutable like the target of a std::function
+    mutable T m_func;
+    /// The values of the bound arguments
+    mutable BTuple m_bargs;
 };
 
 /**
@@ -423,8 +579,9 @@ class CallbackBase
  *   - the pimpl idiom: the Callback class is passed around by
  *     value and delegates the crux of the work to its pimpl
  *     pointer.
- *   - a reference list implementation to implement the Callback's
- *     value semantics.
+ *   - a small buffer in CallbackBase to hold small pimpls inline,
+ *     and a reference list implementation to implement the value
+ *     semantics of the larger ones.
  *
  * This code most notably departs from the alexandrescu
  * implementation in that it does not use type lists to specify
@@ -469,16 +626,10 @@ class Callback : public CallbackBase
     template <typename... BArgs>
     Callback(const Callback<R, BArgs..., UArgs...>& cb, BArgs... bargs)
     {
-        auto f = cb.DoPeekImpl()->GetFunction();
-
-        CallbackComponentVector components(cb.DoPeekImpl()->GetComponents());
-        components.insert(components.end(), {std::make_shared<CallbackComponent<BArgs>>(bargs)...});
-
-        m_impl = Create<CallbackImpl<R, UArgs...>>(
-            [f, bargs...](auto&&... uargs) -> R {
-                return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
-            },
-            components);
+        Emplace<CallbackFunctorImpl<R,
+                                    Callback<R, BArgs..., UArgs...>,
+                                    std::tuple<BArgs...>,
+                                    UArgs...>>(cb, bargs...);
     }
 
     /**
@@ -498,22 +649,7 @@ class Callback : public CallbackBase
               typename... BArgs>
     Callback(T func, BArgs... bargs)
     {
-        // store the function in a std::function object
-        std::function<R(BArgs..., UArgs...)> f(func);
-
-        // The original function is comparable if it is a function pointer or
-        // a pointer to a member function or a pointer to a member data.
-        constexpr bool isComp =
-            std::is_function_v<std::remove_pointer_t<T>> || std::is_member_pointer_v<T>;
-
-        CallbackComponentVector components({std::make_shared<CallbackComponent<T, isComp>>(func),
-                                            std::make_shared<CallbackComponent<BArgs>>(bargs)...});
-
-        m_impl = Create<CallbackImpl<R, UArgs...>>(
-            [f, bargs...](auto&&... uargs) -> R {
-                return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
-            },
-            components);
+        Emplace<CallbackFunctorImpl<R, T, std::tuple<BArgs...>, UArgs...>>(func, bargs...);
     }
 
   private:
@@ -533,17 +669,14 @@ class Callback : public CallbackBase
     {
         Callback<R, std::tuple_element_t<sizeof...(bargs) + INDEX, std::tuple<UArgs...>>...> cb;
 
-        const auto f = DoPeekImpl()->GetFunction();
-
-        CallbackComponentVector components(DoPeekImpl()->GetComponents());
-        components.insert(components.end(),
-                          {std::make_shared<CallbackComponent<BoundArgs>>(bargs)...});
-
-        cb.m_impl = Create<std::remove_pointer_t<decltype(cb.DoPeekImpl())>>(
-            [f, bargs...](auto&&... uargs) mutable {
-                return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
-            },
-            components);
+        cb.template Emplace<
+            CallbackFunctorImpl<R,
+                                Callback<R, UArgs...>,
+                                std::tuple<std::decay_t<BoundArgs>...>,
+                                std::tuple_element_t<sizeof...(bargs) + INDEX,
+                                                     std::tuple<UArgs...>>...>>(
+            *this,
+            std::forward<BoundArgs>(bargs)...);
 
         return cb;
     }
@@ -577,7 +710,7 @@ class Callback : public CallbackBase
     /** Discard the implementation, set it to null */
     void Nullify()
     {
-        m_impl = nullptr;
+        Release();
     }
 
     /**
@@ -588,7 +721,7 @@ class Callback : public CallbackBase
      */
     R operator()(UArgs... uargs) const
     {
-        return (*(DoPeekImpl()))(uargs...);
+        return (*(DoPeekImpl()))(std::forward<UArgs>(uargs)...);
     }
 
     /**
@@ -599,7 +732,11 @@ class Callback : public CallbackBase
      */
     bool IsEqual(const CallbackBase& other) const
     {
-        return m_impl->IsEqual(other.GetImpl());
+        if (m_impl == nullptr || other.GetImpl() == nullptr)
+        {
+            return m_impl == other.GetImpl();
+        }
+        return DoCheckType(other.GetImpl()) && m_impl->IsEqual(other.GetImpl());
     }
 
     /**
@@ -632,15 +769,15 @@ class Callback : public CallbackBase
                                 << "expected=" << myTid);
             return false;
         }
-        m_impl = const_cast<CallbackImplBase*>(PeekPointer(otherImpl));
+        CallbackBase::operator=(other);
         return true;
     }
 
   private:
     /** \return The pimpl pointer */
-    CallbackImpl<R, UArgs...>* DoPeekImpl() const
+    const CallbackImpl<R, UArgs...>* DoPeekImpl() const
     {
-        return static_cast<CallbackImpl<R, UArgs...>*>(PeekPointer(m_impl));
+        return static_cast<const CallbackImpl<R, UArgs...>*>(m_impl);
     }
 
     /**
@@ -649,9 +786,9 @@ class Callback : public CallbackBase
      * \param [in] other Callback Ptr
      * \return \c true if other can be dynamic_cast to my type
      */
-    bool DoCheckType(Ptr<const CallbackImplBase> other) const
+    bool DoCheckType(const CallbackImplBase* other) const
     {
-        if (other && dynamic_cast<const CallbackImpl<R, UArgs...>*>(PeekPointer(other)) != nullptr)
+        if (other && dynamic_cast<const CallbackImpl<R, UArgs...>*>(other) != nullptr)
         {
             return true;
         }
@@ -666,6 +803,32 @@ class Callback : public CallbackBase
     }
 };
 
+/**
+ * \ingroup makeboundcallback
+ * The type of the Callback left when the first arguments of a function are bound.
+ *
+ * \tparam N \explicit The number of bound arguments.
+ * \tparam R \explicit The return type of the function.
+ * \tparam Args \explicit The types of the arguments of the function.
+ */
+template <std::size_t N, typename R, typename... Args>
+struct BoundCallbackType
+{
+  private:
+    /**
+     * Compute the Callback type.
+     * \tparam INDEX \deduced 0..M-1, where M is the number of arguments left unbound.
+     * \return A Callback of the unbound arguments (never called).
+     */
+    template <std::size_t... INDEX>
+    static auto Make(std::index_sequence<INDEX...>)
+        -> Callback<R, std::tuple_element_t<N + INDEX, std::tuple<Args...>>...>;
+
+  public:
+    /** The Callback type. */
+    using Type = decltype(Make(std::make_index_sequence<sizeof...(Args) - N>{}));
+};
+
 /**
  * Inequality test.
  *
@@ -767,7 +930,7 @@ template <typename R, typename... Args, typename... BArgs>
 auto
 MakeBoundCallback(R (*fnPtr)(Args...), BArgs&&... bargs)
 {
-    return Callback<R, Args...>(fnPtr).Bind(std::forward<BArgs>(bargs)...);
+    return typename BoundCallbackType<sizeof...(BArgs), R, Args...>::Type(fnPtr, bargs...);
 }
 
 /**
@@ -788,14 +951,16 @@ template <typename T, typename OBJ, typename R, typename... Args, typename... BA
 auto
 MakeCallback(R (T::*memPtr)(Args...), OBJ objPtr, BArgs... bargs)
 {
-    return Callback<R, Args...>(memPtr, objPtr).Bind(bargs...);
+    using BoundCallback = typename BoundCallbackType<sizeof...(BArgs), R, Args...>::Type;
+    return BoundCallback(memPtr, objPtr, bargs...);
 }
 
 template <typename T, typename OBJ, typename R, typename... Args, typename... BArgs>
 auto
 MakeCallback(R (T::*memPtr)(Args...) const, OBJ objPtr, BArgs... bargs)
 {
-    return Callback<R, Args...>(memPtr, objPtr).Bind(bargs...);
+    using BoundCallback = typename BoundCallbackType<sizeof...(BArgs), R, Args...>::Type;
+    return BoundCallback(memPtr, objPtr, bargs...);
 }
 
 /**@}*/
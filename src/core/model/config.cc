@@ -24,9 +24,14 @@
 #include "object-ptr-container.h"
 #include "object.h"
 #include "pointer.h"
+#include "simple-ref-count.h"
 #include "singleton.h"
 
+#include <algorithm>
+#include <chrono>
+#include <map>
 #include <sstream>
+#include <unordered_map>
 
 /**
  * \file
@@ -197,6 +202,9 @@ MatchContainer::DisconnectWithoutContext(std::string name, const CallbackBase& c
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, into the list of index ranges it
+ * matches.
  */
 class ArrayMatcher
 {
@@ -214,8 +222,23 @@ class ArrayMatcher
      * \returns \c true if the index matches the Config Path.
      */
     bool Matches(std::size_t i) const;
+    /**
+     * Get the indexes lower than \pname{n} which match the Config Path.
+     *
+     * \param [in] n The number of indexes.
+     * \param [out] indexes The matching indexes, in increasing order.
+     * \returns \c false if every index matches the Config Path,
+     *          in which case \pname{indexes} is left empty.
+     */
+    bool GetIndexes(std::size_t n, std::vector<std::size_t>* indexes) const;
 
   private:
+    /**
+     * Parse a Config path specification, or one of its '|' separated terms.
+     *
+     * \param [in] element The Config path specification.
+     */
+    void Parse(std::string element);
     /**
      * Convert a string to an \c uint32_t.
      *
@@ -226,77 +249,108 @@ class ArrayMatcher
     bool StringToUint32(std::string str, uint32_t* value) const;
     /** The Config path element. */
     std::string m_element;
+    /** Whether every index matches. */
+    bool m_all;
+    /** The matching ranges of indexes, bounds included. */
+    std::vector<std::pair<uint32_t, uint32_t>> m_ranges;
 
 }; // class ArrayMatcher
 
 ArrayMatcher::ArrayMatcher(std::string element)
-    : m_element(element)
+    : m_element(element),
+      m_all(false)
 {
     NS_LOG_FUNCTION(this << element);
+    Parse(element);
 }
 
-bool
-ArrayMatcher::Matches(std::size_t i) const
+void
+ArrayMatcher::Parse(std::string element)
 {
-    NS_LOG_FUNCTION(this << i);
-    if (m_element == "*")
+    NS_LOG_FUNCTION(this << element);
+    if (element == "*")
     {
-        NS_LOG_DEBUG("Array " << i << " matches *");
-        return true;
+        m_all = true;
+        return;
     }
     std::string::size_type tmp;
-    tmp = m_element.find('|');
+    tmp = element.find('|');
     if (tmp != std::string::npos)
     {
-        std::string left = m_element.substr(0, tmp - 0);
-        std::string right = m_element.substr(tmp + 1, m_element.size() - (tmp + 1));
-        ArrayMatcher matcher = ArrayMatcher(left);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << left);
-            return true;
-        }
-        matcher = ArrayMatcher(right);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << right);
-            return true;
-        }
-        NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
-        return false;
+        std::string left = element.substr(0, tmp - 0);
+        std::string right = element.substr(tmp + 1, element.size() - (tmp + 1));
+        Parse(left);
+        Parse(right);
+        return;
     }
-    std::string::size_type leftBracket = m_element.find('[');
-    std::string::size_type rightBracket = m_element.find(']');
-    std::string::size_type dash = m_element.find('-');
-    if (leftBracket == 0 && rightBracket == m_element.size() - 1 && dash > leftBracket &&
+    std::string::size_type leftBracket = element.find('[');
+    std::string::size_type rightBracket = element.find(']');
+    std::string::size_type dash = element.find('-');
+    if (leftBracket == 0 && rightBracket == element.size() - 1 && dash > leftBracket &&
         dash < rightBracket)
     {
-        std::string lowerBound = m_element.substr(leftBracket + 1, dash - (leftBracket + 1));
-        std::string upperBound = m_element.substr(dash + 1, rightBracket - (dash + 1));
+        std::string lowerBound = element.substr(leftBracket + 1, dash - (leftBracket + 1));
+        std::string upperBound = element.substr(dash + 1, rightBracket - (dash + 1));
         uint32_t min;
         uint32_t max;
-        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && i >= min &&
-            i <= max)
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
-            return true;
-        }
-        else
+        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && min <= max)
         {
-            NS_LOG_DEBUG("Array " << i << " does not " << m_element);
-            return false;
+            m_ranges.emplace_back(min, max);
         }
+        return;
     }
     uint32_t value;
-    if (StringToUint32(m_element, &value) && i == value)
+    if (StringToUint32(element, &value))
     {
-        NS_LOG_DEBUG("Array " << i << " matches " << m_element);
+        m_ranges.emplace_back(value, value);
+    }
+}
+
+bool
+ArrayMatcher::Matches(std::size_t i) const
+{
+    NS_LOG_FUNCTION(this << i);
+    if (m_all)
+    {
+        NS_LOG_DEBUG("Array " << i << " matches *");
         return true;
     }
+    for (const auto& range : m_ranges)
+    {
+        if (i >= range.first && i <= range.second)
+        {
+            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
+            return true;
+        }
+    }
     NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
     return false;
 }
 
+bool
+ArrayMatcher::GetIndexes(std::size_t n, std::vector<std::size_t>* indexes) const
+{
+    NS_LOG_FUNCTION(this << n << indexes);
+    indexes->clear();
+    if (m_all)
+    {
+        return false;
+    }
+    std::vector<std::pair<uint32_t, uint32_t>> ranges = m_ranges;
+    std::sort(ranges.begin(), ranges.end());
+    std::size_t next = 0;
+    for (const auto& range : ranges)
+    {
+        std::size_t i = std::max<std::size_t>(next, range.first);
+        for (; i <= range.second && i < n; ++i)
+        {
+            indexes->push_back(i);
+        }
+        next = std::max(next, i);
+    }
+    return true;
+}
+
 bool
 ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
 {
@@ -307,6 +361,161 @@ ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
     return !iss.bad() && !iss.fail();
 }
 
+/**
+ * \ingroup config-impl
+ * A Config path, split into its elements and parsed once to be resolved
+ * any number of times.
+ */
+class CompiledPath : public SimpleRefCount<CompiledPath>
+{
+  public:
+    /** An element of the Config path. */
+    struct Element
+    {
+        /**
+         * Parse an element.
+         *
+         * \param [in] item The element.
+         */
+        Element(std::string item);
+
+        std::string item;     //!< The element.
+        ArrayMatcher matcher; //!< The element, as an index of an object container.
+        bool isTypeId;        //!< Whether the element is a "$TypeId" GetObject call.
+        bool hasTypeId;       //!< Whether the TypeId was registered when the path was compiled.
+        TypeId tid;           //!< The TypeId, if \c hasTypeId.
+    };
+
+    /**
+     * Compile a Config path.
+     *
+     * \param [in] path The Config path.
+     */
+    CompiledPath(std::string path);
+
+    /** The elements of the Config path. */
+    std::vector<Element> m_elements;
+
+}; // class CompiledPath
+
+CompiledPath::Element::Element(std::string item)
+    : item(item),
+      matcher(item),
+      isTypeId(item.find('$') == 0),
+      hasTypeId(false)
+{
+    if (isTypeId)
+    {
+        hasTypeId = TypeId::LookupByNameFailSafe(item.substr(1, item.size() - 1), &tid);
+    }
+}
+
+CompiledPath::CompiledPath(std::string path)
+{
+    NS_LOG_FUNCTION(this << path);
+
+    // ensure that we start and end with a '/'
+    std::string::size_type tmp = path.find('/');
+    if (tmp != 0)
+    {
+        // no slash at start
+        path = "/" + path;
+    }
+    tmp = path.find_last_of('/');
+    if (tmp != (path.size() - 1))
+    {
+        // no slash at end
+        path = path + "/";
+    }
+
+    std::string::size_type cur = 0;
+    std::string::size_type next;
+    while ((next = path.find('/', cur + 1)) != std::string::npos)
+    {
+        m_elements.emplace_back(path.substr(cur + 1, next - (cur + 1)));
+        cur = next;
+    }
+}
+
+/**
+ * \ingroup config-impl
+ * The Object pointer and Object container attributes of each TypeId,
+ * indexed by the Config path elements which select them.
+ */
+class AttributeIndex
+{
+  public:
+    /** An attribute which leads to other objects. */
+    struct Entry
+    {
+        std::string name;                            //!< The attribute name.
+        Ptr<const AttributeAccessor> accessor;       //!< The attribute accessor.
+        bool isContainer;                            //!< Whether this is an object container.
+        const ObjectPtrContainerAccessor* container; //!< The accessor of an object container.
+    };
+
+    /**
+     * Get the attributes of a TypeId and of its parents which match
+     * a Config path element.
+     *
+     * \param [in] tid The TypeId.
+     * \param [in] item The Config path element, an attribute name or "*".
+     * \returns The matching attributes, in the order of the TypeId hierarchy.
+     */
+    const std::vector<Entry>& Lookup(TypeId tid, const std::string& item);
+
+  private:
+    /** The attributes, by TypeId uid and Config path element. */
+    std::map<std::pair<uint16_t, std::string>, std::vector<Entry>> m_entries;
+
+}; // class AttributeIndex
+
+const std::vector<AttributeIndex::Entry>&
+AttributeIndex::Lookup(TypeId tid, const std::string& item)
+{
+    NS_LOG_FUNCTION(this << tid << item);
+    auto key = std::make_pair(tid.GetUid(), item);
+    auto it = m_entries.find(key);
+    if (it != m_entries.end())
+    {
+        return it->second;
+    }
+
+    std::vector<Entry> entries;
+    TypeId nextTid = tid;
+    do
+    {
+        tid = nextTid;
+        for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+        {
+            struct TypeId::AttributeInformation info;
+            info = tid.GetAttribute(i);
+            if (info.name != item && item != "*")
+            {
+                continue;
+            }
+            if (dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) != nullptr)
+            {
+                entries.push_back({info.name, info.accessor, false, nullptr});
+            }
+            if (dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker)) !=
+                nullptr)
+            {
+                entries.push_back(
+                    {info.name,
+                     info.accessor,
+                     true,
+                     dynamic_cast<const ObjectPtrContainerAccessor*>(PeekPointer(info.accessor))});
+            }
+            // this could be anything else and we don't know what to do with it.
+            // So, we just ignore it.
+        }
+        nextTid = tid.GetParent();
+    } while (nextTid != tid);
+
+    return m_entries.emplace(key, std::move(entries)).first->second;
+}
+
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
@@ -315,11 +524,12 @@ class Resolver
 {
   public:
     /**
-     * Construct from a base Config path.
+     * Construct from a compiled Config path.
      *
      * \param [in] path The Config path.
+     * \param [in] index The index of the attributes to use.
      */
-    Resolver(std::string path);
+    Resolver(Ptr<const CompiledPath> path, AttributeIndex* index);
     /** Destructor. */
     virtual ~Resolver();
 
@@ -333,23 +543,24 @@ class Resolver
     void Resolve(Ptr<Object> root);
 
   private:
-    /** Ensure the Config path starts and ends with a '/'. */
-    void Canonicalize();
     /**
      * Parse the next element in the Config path.
      *
-     * \param [in] path The remaining portion of the Config path.
+     * \param [in] element The index of the next element of the Config path.
      * \param [in] root The object corresponding to the current position
      *                  in the Config path.
      */
-    void DoResolve(std::string path, Ptr<Object> root);
+    void DoResolve(std::size_t element, Ptr<Object> root);
     /**
      * Parse an index on the Config path.
      *
-     * \param [in] path The remaining Config path.
-     * \param [in,out] vector The resulting list of matching objects.
+     * \param [in] element The index of the next element of the Config path.
+     * \param [in] root The object holding the object container.
+     * \param [in] attribute The object container attribute.
      */
-    void DoArrayResolve(std::string path, const ObjectPtrContainerValue& vector);
+    void DoArrayResolve(std::size_t element,
+                        Ptr<Object> root,
+                        const AttributeIndex::Entry& attribute);
     /**
      * Handle one object found on the path.
      *
@@ -373,15 +584,17 @@ class Resolver
     /** Current list of path tokens. */
     std::vector<std::string> m_workStack;
     /** The Config path. */
-    std::string m_path;
+    Ptr<const CompiledPath> m_path;
+    /** The index of the attributes. */
+    AttributeIndex* m_index;
 
 }; // class Resolver
 
-Resolver::Resolver(std::string path)
-    : m_path(path)
+Resolver::Resolver(Ptr<const CompiledPath> path, AttributeIndex* index)
+    : m_path(path),
+      m_index(index)
 {
-    NS_LOG_FUNCTION(this << path);
-    Canonicalize();
+    NS_LOG_FUNCTION(this << path << index);
 }
 
 Resolver::~Resolver()
@@ -389,32 +602,12 @@ Resolver::~Resolver()
     NS_LOG_FUNCTION(this);
 }
 
-void
-Resolver::Canonicalize()
-{
-    NS_LOG_FUNCTION(this);
-
-    // ensure that we start and end with a '/'
-    std::string::size_type tmp = m_path.find('/');
-    if (tmp != 0)
-    {
-        // no slash at start
-        m_path = "/" + m_path;
-    }
-    tmp = m_path.find_last_of('/');
-    if (tmp != (m_path.size() - 1))
-    {
-        // no slash at end
-        m_path = m_path + "/";
-    }
-}
-
 void
 Resolver::Resolve(Ptr<Object> root)
 {
     NS_LOG_FUNCTION(this << root);
 
-    DoResolve(m_path, root);
+    DoResolve(0, root);
 }
 
 std::string
@@ -441,13 +634,11 @@ Resolver::DoResolveOne(Ptr<Object> object)
 }
 
 void
-Resolver::DoResolve(std::string path, Ptr<Object> root)
+Resolver::DoResolve(std::size_t element, Ptr<Object> root)
 {
-    NS_LOG_FUNCTION(this << path << root);
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
+    NS_LOG_FUNCTION(this << element << root);
 
-    if (next == std::string::npos)
+    if (element == m_path->m_elements.size())
     {
         //
         // If root is zero, we're beginning to see if we can use the object name
@@ -463,8 +654,8 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
         }
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    const CompiledPath::Element& current = m_path->m_elements[element];
+    const std::string& item = current.item;
 
     //
     // If root is zero, we're beginning to see if we can use the object name
@@ -475,11 +666,11 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     //
     if (!root)
     {
-        std::string::size_type offset = path.find("/Names");
+        std::string::size_type offset = item.find("Names");
         if (offset == 0)
         {
             m_workStack.push_back(item);
-            DoResolve(pathLeft, root);
+            DoResolve(element + 1, root);
             m_workStack.pop_back();
             return;
         }
@@ -496,7 +687,7 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     {
         NS_LOG_DEBUG("Name system resolved item = " << item << " to " << namedObject);
         m_workStack.push_back(item);
-        DoResolve(pathLeft, namedObject);
+        DoResolve(element + 1, namedObject);
         m_workStack.pop_back();
         return;
     }
@@ -512,13 +703,12 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     {
         return;
     }
-    std::string::size_type dollarPos = item.find('$');
-    if (dollarPos == 0)
+    if (current.isTypeId)
     {
         // This is a call to GetObject
         std::string tidString = item.substr(1, item.size() - 1);
         NS_LOG_DEBUG("GetObject=" << tidString << " on path=" << GetResolvedPath());
-        TypeId tid = TypeId::LookupByName(tidString);
+        TypeId tid = current.hasTypeId ? current.tid : TypeId::LookupByName(tidString);
         Ptr<Object> object = root->GetObject<Object>(tid);
         if (!object)
         {
@@ -526,71 +716,46 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
             return;
         }
         m_workStack.push_back(item);
-        DoResolve(pathLeft, object);
+        DoResolve(element + 1, object);
         m_workStack.pop_back();
     }
     else
     {
         // this is a normal attribute.
-        TypeId tid;
-        TypeId nextTid = root->GetInstanceTypeId();
         bool foundMatch = false;
 
-        do
+        for (const auto& attribute : m_index->Lookup(root->GetInstanceTypeId(), item))
         {
-            tid = nextTid;
-
-            for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+            if (!attribute.isContainer)
             {
-                struct TypeId::AttributeInformation info;
-                info = tid.GetAttribute(i);
-                if (info.name != item && item != "*")
+                NS_LOG_DEBUG("GetAttribute(ptr)=" << attribute.name
+                                                  << " on path=" << GetResolvedPath());
+                PointerValue pValue;
+                attribute.accessor->Get(PeekPointer(root), pValue);
+                Ptr<Object> object = pValue.Get<Object>();
+                if (!object)
                 {
+                    NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
+                                                            << GetResolvedPath()
+                                                            << "\""
+                                                               " but is null.");
                     continue;
                 }
-                // attempt to cast to a pointer checker.
-                const PointerChecker* pChecker =
-                    dynamic_cast<const PointerChecker*>(PeekPointer(info.checker));
-                if (pChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(ptr)=" << info.name
-                                                      << " on path=" << GetResolvedPath());
-                    PointerValue pValue;
-                    root->GetAttribute(info.name, pValue);
-                    Ptr<Object> object = pValue.Get<Object>();
-                    if (!object)
-                    {
-                        NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
-                                                                << GetResolvedPath()
-                                                                << "\""
-                                                                   " but is null.");
-                        continue;
-                    }
-                    foundMatch = true;
-                    m_workStack.push_back(info.name);
-                    DoResolve(pathLeft, object);
-                    m_workStack.pop_back();
-                }
-                // attempt to cast to an object vector.
-                const ObjectPtrContainerChecker* vectorChecker =
-                    dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker));
-                if (vectorChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(vector)=" << info.name << " on path="
-                                                         << GetResolvedPath() << pathLeft);
-                    foundMatch = true;
-                    ObjectPtrContainerValue vector;
-                    root->GetAttribute(info.name, vector);
-                    m_workStack.push_back(info.name);
-                    DoArrayResolve(pathLeft, vector);
-                    m_workStack.pop_back();
-                }
-                // this could be anything else and we don't know what to do with it.
-                // So, we just ignore it.
+                foundMatch = true;
+                m_workStack.push_back(attribute.name);
+                DoResolve(element + 1, object);
+                m_workStack.pop_back();
             }
-
-            nextTid = tid.GetParent();
-        } while (nextTid != tid);
+            else
+            {
+                NS_LOG_DEBUG("GetAttribute(vector)=" << attribute.name
+                                                     << " on path=" << GetResolvedPath());
+                foundMatch = true;
+                m_workStack.push_back(attribute.name);
+                DoArrayResolve(element + 1, root, attribute);
+                m_workStack.pop_back();
+            }
+        }
 
         if (!foundMatch)
         {
@@ -602,20 +767,44 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
 }
 
 void
-Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& container)
+Resolver::DoArrayResolve(std::size_t element,
+                         Ptr<Object> root,
+                         const AttributeIndex::Entry& attribute)
 {
-    NS_LOG_FUNCTION(this << path << &container);
-    NS_ASSERT(!path.empty());
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
-    if (next == std::string::npos)
+    NS_LOG_FUNCTION(this << element << root << attribute.name);
+    if (element == m_path->m_elements.size())
     {
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    const ArrayMatcher& matcher = m_path->m_elements[element].matcher;
 
-    ArrayMatcher matcher = ArrayMatcher(item);
+    //
+    // When the index of every object is its position in the container,
+    // look up the matching objects directly instead of copying the whole
+    // container, so that resolving a single index does not depend on the
+    // size of the container.
+    //
+    std::size_t n;
+    if (attribute.container != nullptr && attribute.container->IsIndexedByPosition() &&
+        attribute.container->GetN(PeekPointer(root), &n))
+    {
+        std::vector<std::size_t> indexes;
+        bool some = matcher.GetIndexes(n, &indexes);
+        std::size_t count = some ? indexes.size() : n;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::size_t index;
+            Ptr<Object> object =
+                attribute.container->Get(PeekPointer(root), some ? indexes[i] : i, &index);
+            m_workStack.push_back(std::to_string(index));
+            DoResolve(element + 1, object);
+            m_workStack.pop_back();
+        }
+        return;
+    }
+
+    ObjectPtrContainerValue container;
+    root->GetAttribute(attribute.name, container);
     ObjectPtrContainerValue::Iterator it;
     for (it = container.Begin(); it != container.End(); ++it)
     {
@@ -624,7 +813,7 @@ Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& contai
             std::ostringstream oss;
             oss << (*it).first;
             m_workStack.push_back(oss.str());
-            DoResolve(pathLeft, (*it).second);
+            DoResolve(element + 1, (*it).second);
             m_workStack.pop_back();
         }
     }
@@ -664,6 +853,11 @@ class ConfigImpl : public Singleton<ConfigImpl>
     /** \copydoc ns3::Config::GetRootNamespaceObject() */
     Ptr<Object> GetRootNamespaceObject(std::size_t i) const;
 
+    /** \copydoc ns3::Config::GetResolutionStats() */
+    ResolutionStats GetResolutionStats() const;
+    /** \copydoc ns3::Config::ResetResolutionStats() */
+    void ResetResolutionStats();
+
   private:
     /**
      * Break a Config path into the leading path and the last leaf token.
@@ -680,6 +874,19 @@ class ConfigImpl : public Singleton<ConfigImpl>
     /** The list of Config path roots. */
     Roots m_roots;
 
+    /**
+     * Maximum number of compiled paths kept in #m_paths; the cache is
+     * emptied when it is full, to bound its size when every lookup uses
+     * a different path, such as in a loop over the nodes.
+     */
+    static constexpr std::size_t MAX_COMPILED_PATHS = 4096;
+    /** The compiled Config paths, by path. */
+    std::unordered_map<std::string, Ptr<const CompiledPath>> m_paths;
+    /** The index of the attributes used to resolve the paths. */
+    AttributeIndex m_index;
+    /** The resolution counters. */
+    ResolutionStats m_stats;
+
 }; // class ConfigImpl
 
 void
@@ -783,11 +990,23 @@ ConfigImpl::LookupMatches(std::string path)
 {
     NS_LOG_FUNCTION(this << path);
 
+    auto start = std::chrono::steady_clock::now();
+    auto it = m_paths.find(path);
+    if (it == m_paths.end())
+    {
+        if (m_paths.size() >= MAX_COMPILED_PATHS)
+        {
+            m_paths.clear();
+        }
+        it = m_paths.emplace(path, Create<CompiledPath>(path)).first;
+        m_stats.compiles++;
+    }
+
     class LookupMatchesResolver : public Resolver
     {
       public:
-        LookupMatchesResolver(std::string path)
-            : Resolver(path)
+        LookupMatchesResolver(Ptr<const CompiledPath> path, AttributeIndex* index)
+            : Resolver(path, index)
         {
         }
 
@@ -799,7 +1018,7 @@ ConfigImpl::LookupMatches(std::string path)
 
         std::vector<Ptr<Object>> m_objects;
         std::vector<std::string> m_contexts;
-    } resolver = LookupMatchesResolver(path);
+    } resolver = LookupMatchesResolver(it->second, &m_index);
 
     for (Roots::const_iterator i = m_roots.begin(); i != m_roots.end(); i++)
     {
@@ -813,6 +1032,13 @@ ConfigImpl::LookupMatches(std::string path)
     //
     resolver.Resolve(nullptr);
 
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    m_stats.lookups++;
+    m_stats.matches += resolver.m_objects.size();
+    m_stats.seconds += elapsed.count();
+    NS_LOG_INFO("Resolved " << path << " to " << resolver.m_objects.size() << " objects in "
+                            << elapsed.count() * 1e6 << " us");
+
     return MatchContainer(resolver.m_objects, resolver.m_contexts, path);
 }
 
@@ -852,6 +1078,20 @@ ConfigImpl::GetRootNamespaceObject(std::size_t i) const
     return m_roots[i];
 }
 
+ResolutionStats
+ConfigImpl::GetResolutionStats() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_stats;
+}
+
+void
+ConfigImpl::ResetResolutionStats()
+{
+    NS_LOG_FUNCTION(this);
+    m_stats = ResolutionStats();
+}
+
 void
 Reset()
 {
@@ -1030,6 +1270,20 @@ GetRootNamespaceObject(uint32_t i)
     return ConfigImpl::Get()->GetRootNamespaceObject(i);
 }
 
+ResolutionStats
+GetResolutionStats()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    return ConfigImpl::Get()->GetResolutionStats();
+}
+
+void
+ResetResolutionStats()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    ConfigImpl::Get()->ResetResolutionStats();
+}
+
 } // namespace Config
 
 } // namespace ns3
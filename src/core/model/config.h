@@ -390,6 +390,32 @@ std::size_t GetRootNamespaceObjectN();
  */
 Ptr<Object> GetRootNamespaceObject(uint32_t i);
 
+/**
+ * \ingroup config
+ * Counters of the resolution of Config paths into objects, by
+ * Config::Set, Config::Connect, Config::LookupMatches and friends.
+ */
+struct ResolutionStats
+{
+    uint64_t lookups{0};  //!< Number of paths resolved.
+    uint64_t compiles{0}; //!< Number of paths which were not found already compiled.
+    uint64_t matches{0};  //!< Number of objects matched by the resolved paths.
+    double seconds{0};    //!< Wall clock time spent resolving the paths.
+};
+
+/**
+ * \ingroup config
+ * \returns The counters of the paths resolved since the start of the
+ *          program or the last call to Config::ResetResolutionStats.
+ */
+ResolutionStats GetResolutionStats();
+
+/**
+ * \ingroup config
+ * Reset the counters returned by Config::GetResolutionStats.
+ */
+void ResetResolutionStats();
+
 } // namespace Config
 
 } // namespace ns3
@@ -20,11 +20,18 @@
 #include "default-simulator-impl.h"
 
 #include "assert.h"
+#include "boolean.h"
+#include "double.h"
+#include "global-value.h"
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
+#include "uinteger.h"
 
 #include <cmath>
+#include <iostream>
+#include <vector>
 
 /**
  * \file
@@ -45,10 +52,28 @@ NS_OBJECT_ENSURE_REGISTERED(DefaultSimulatorImpl);
 TypeId
 DefaultSimulatorImpl::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
-                            .SetParent<SimulatorImpl>()
-                            .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+    static TypeId tid =
+        TypeId("ns3::DefaultSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<DefaultSimulatorImpl>()
+            .AddAttribute("EagerCancel",
+                          "Physically remove events from the event list when they are cancelled.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&DefaultSimulatorImpl::m_eagerCancel),
+                          MakeBooleanChecker())
+            .AddAttribute("CompactionThreshold",
+                          "Fraction of cancelled events in the event list above which "
+                          "the list is compacted (0 disables compaction).",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&DefaultSimulatorImpl::m_compactionThreshold),
+                          MakeDoubleChecker<double>(0.0, 1.0))
+            .AddAttribute("CompactionMinEvents",
+                          "Minimum number of events in the event list before a compaction "
+                          "is considered.",
+                          UintegerValue(1024),
+                          MakeUintegerAccessor(&DefaultSimulatorImpl::m_compactionMinEvents),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
@@ -62,7 +87,9 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
-    m_eventsWithContextEmpty = true;
+    m_cancelledEvents = 0;
+    m_compactions = 0;
+    m_profiling = false;
     m_mainThreadId = std::this_thread::get_id();
 }
 
@@ -82,6 +109,7 @@ DefaultSimulatorImpl::DoDispose()
         Scheduler::Event next = m_events->RemoveNext();
         next.impl->Unref();
     }
+    m_cancelledEvents = 0;
     m_events = nullptr;
     SimulatorImpl::DoDispose();
 }
@@ -100,6 +128,16 @@ DefaultSimulatorImpl::Destroy()
             ev->Invoke();
         }
     }
+    if (m_profiler)
+    {
+        m_profiler->Print(std::clog);
+        StringValue traceFile;
+        GlobalValue::GetValueByName("EventProfilerTraceFile", traceFile);
+        if (!traceFile.Get().empty())
+        {
+            m_profiler->WriteTrace(traceFile.Get());
+        }
+    }
 }
 
 void
@@ -107,6 +145,7 @@ DefaultSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
 {
     NS_LOG_FUNCTION(this << schedulerFactory);
     Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler>();
+    m_schedulerFactory = schedulerFactory;
 
     if (m_events)
     {
@@ -136,12 +175,26 @@ DefaultSimulatorImpl::ProcessOneEvent()
     NS_ASSERT(next.key.m_ts >= m_currentTs);
     m_unscheduledEvents--;
     m_eventCount++;
+    if (m_cancelledEvents > 0 && next.impl->IsCancelled())
+    {
+        m_cancelledEvents--;
+    }
 
     NS_LOG_LOGIC("handle " << next.key.m_ts);
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
+    if (m_profiling)
+    {
+        uint64_t start = EventProfiler::GetTimestamp();
+        next.impl->Invoke();
+        uint64_t end = EventProfiler::GetTimestamp();
+        m_profiler->Record(next.impl, next.key.m_context, next.key.m_ts, start, end);
+    }
+    else
+    {
+        next.impl->Invoke();
+    }
     next.impl->Unref();
 
     ProcessEventsWithContext();
@@ -156,31 +209,18 @@ DefaultSimulatorImpl::IsFinished() const
 void
 DefaultSimulatorImpl::ProcessEventsWithContext()
 {
-    if (m_eventsWithContextEmpty)
-    {
-        return;
-    }
-
-    // swap queues
-    EventsWithContext eventsWithContext;
-    {
-        std::unique_lock lock{m_eventsWithContextMutex};
-        m_eventsWithContext.swap(eventsWithContext);
-        m_eventsWithContextEmpty = true;
-    }
-    while (!eventsWithContext.empty())
-    {
-        EventWithContext event = eventsWithContext.front();
-        eventsWithContext.pop_front();
+    // The delays are relative to the time the events are received at.
+    uint64_t now = m_currentTs;
+    m_eventsWithContext.Drain([this, now](const EventWithContext& event) {
         Scheduler::Event ev;
         ev.impl = event.event;
-        ev.key.m_ts = m_currentTs + event.timestamp;
+        ev.key.m_ts = now + event.timestamp;
         ev.key.m_context = event.context;
         ev.key.m_uid = m_uid;
         m_uid++;
         m_unscheduledEvents++;
         m_events->Insert(ev);
-    }
+    });
 }
 
 void
@@ -192,6 +232,16 @@ DefaultSimulatorImpl::Run()
     ProcessEventsWithContext();
     m_stop = false;
 
+    BooleanValue profiling;
+    GlobalValue::GetValueByName("EventProfiler", profiling);
+    m_profiling = profiling.Get();
+    if (m_profiling && !m_profiler)
+    {
+        StringValue traceFile;
+        GlobalValue::GetValueByName("EventProfilerTraceFile", traceFile);
+        m_profiler = std::make_unique<EventProfiler>(!traceFile.Get().empty());
+    }
+
     while (!m_events->IsEmpty() && !m_stop)
     {
         ProcessOneEvent();
@@ -264,11 +314,7 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
         // Current time added in ProcessEventsWithContext()
         ev.timestamp = delay.GetTimeStep();
         ev.event = event;
-        {
-            std::unique_lock lock{m_eventsWithContextMutex};
-            m_eventsWithContext.push_back(ev);
-            m_eventsWithContextEmpty = false;
-        }
+        m_eventsWithContext.Push(ev);
     }
 }
 
@@ -349,10 +395,58 @@ DefaultSimulatorImpl::Remove(const EventId& id)
 void
 DefaultSimulatorImpl::Cancel(const EventId& id)
 {
-    if (!IsExpired(id))
+    if (IsExpired(id))
+    {
+        return;
+    }
+    if (id.GetUid() == EventId::UID::DESTROY)
     {
         id.PeekEventImpl()->Cancel();
+        return;
+    }
+    if (m_eagerCancel)
+    {
+        Remove(id);
+        return;
+    }
+    id.PeekEventImpl()->Cancel();
+    m_cancelledEvents++;
+    if (m_compactionThreshold > 0 && m_unscheduledEvents >= 0 &&
+        static_cast<uint64_t>(m_unscheduledEvents) >= m_compactionMinEvents &&
+        m_cancelledEvents > m_compactionThreshold * m_unscheduledEvents)
+    {
+        CompactEvents();
+    }
+}
+
+void
+DefaultSimulatorImpl::CompactEvents()
+{
+    NS_LOG_FUNCTION(this << m_unscheduledEvents << m_cancelledEvents);
+    // Some schedulers (e.g. CalendarScheduler) assume that no event is
+    // inserted before the last removed one, so rebuild a fresh event list.
+    std::vector<Scheduler::Event> live;
+    live.reserve(m_unscheduledEvents - m_cancelledEvents);
+    while (!m_events->IsEmpty())
+    {
+        Scheduler::Event next = m_events->RemoveNext();
+        if (next.impl->IsCancelled())
+        {
+            next.impl->Unref();
+            m_unscheduledEvents--;
+        }
+        else
+        {
+            live.push_back(next);
+        }
+    }
+    m_events = m_schedulerFactory.Create<Scheduler>();
+    for (auto i = live.rbegin(); i != live.rend(); ++i)
+    {
+        m_events->Insert(*i);
     }
+    m_cancelledEvents = 0;
+    m_compactions++;
 }
 
 bool
@@ -405,4 +499,28 @@ DefaultSimulatorImpl::GetEventCount() const
     return m_eventCount;
 }
 
+uint64_t
+DefaultSimulatorImpl::GetCancelledEventCount() const
+{
+    return m_cancelledEvents;
+}
+
+uint64_t
+DefaultSimulatorImpl::GetLiveEventCount() const
+{
+    return m_unscheduledEvents - m_cancelledEvents;
+}
+
+uint64_t
+DefaultSimulatorImpl::GetCompactionCount() const
+{
+    return m_compactions;
+}
+
+const EventProfiler*
+DefaultSimulatorImpl::GetEventProfiler() const
+{
+    return m_profiler.get();
+}
+
 } // namespace ns3
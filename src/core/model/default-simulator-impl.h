@@ -20,10 +20,12 @@
 #ifndef DEFAULT_SIMULATOR_IMPL_H
 #define DEFAULT_SIMULATOR_IMPL_H
 
+#include "event-profiler.h"
+#include "mpsc-queue.h"
 #include "simulator-impl.h"
 
 #include <list>
-#include <mutex>
+#include <memory>
 #include <thread>
 
 /**
@@ -78,6 +80,38 @@ class DefaultSimulatorImpl : public SimulatorImpl
     uint32_t GetContext() const override;
     uint64_t GetEventCount() const override;
 
+    /**
+     * Get the number of cancelled events still held in the event list.
+     *
+     * Cancelled events stay in the Scheduler until their time stamp is
+     * reached, unless they are removed eagerly (\c EagerCancel attribute)
+     * or compacted away (\c CompactionThreshold attribute).
+     *
+     * \return The number of dead events in the event list.
+     */
+    uint64_t GetCancelledEventCount() const;
+    /**
+     * Get the number of live (not cancelled) events in the event list.
+     *
+     * \return The number of live events in the event list.
+     */
+    uint64_t GetLiveEventCount() const;
+    /**
+     * Get the number of times the event list has been compacted.
+     *
+     * \return The number of compactions.
+     */
+    uint64_t GetCompactionCount() const;
+    /**
+     * Get the event profiler.
+     *
+     * The profiler is created by Run() when the \c EventProfiler
+     * GlobalValue is \c true.
+     *
+     * \return The event profiler, or \c nullptr if profiling was never enabled.
+     */
+    const EventProfiler* GetEventProfiler() const;
+
   private:
     void DoDispose() override;
 
@@ -85,6 +119,14 @@ class DefaultSimulatorImpl : public SimulatorImpl
     void ProcessOneEvent();
     /** Move events from a different context into the main event queue. */
     void ProcessEventsWithContext();
+    /**
+     * Drop all cancelled events from the event list.
+     *
+     * The live events are drained and inserted in reverse order into a
+     * new Scheduler, which keeps the cost of rebuilding sorted-list based
+     * schedulers linear.
+     */
+    void CompactEvents();
 
     /** Wrap an event with its execution context. */
     struct EventWithContext
@@ -96,17 +138,11 @@ class DefaultSimulatorImpl : public SimulatorImpl
         /** The event implementation. */
         EventImpl* event;
     };
-    /** Container type for the events from a different context. */
-    typedef std::list<struct EventWithContext> EventsWithContext;
-    /** The container of events from a different context. */
-    EventsWithContext m_eventsWithContext;
     /**
-     * Flag \c true if all events with context have been moved to the
-     * primary event queue.
+     * The events scheduled from other threads, waiting to be moved
+     * to the primary event queue.
      */
-    bool m_eventsWithContextEmpty;
-    /** Mutex to control access to the list of events with context. */
-    std::mutex m_eventsWithContextMutex;
+    MpscQueue<EventWithContext> m_eventsWithContext;
 
     /** Container type for the events to run at Simulator::Destroy() */
     typedef std::list<EventId> DestroyEvents;
@@ -116,6 +152,8 @@ class DefaultSimulatorImpl : public SimulatorImpl
     bool m_stop;
     /** The event priority queue. */
     Ptr<Scheduler> m_events;
+    /** Factory of the event priority queue, used to rebuild it on compaction. */
+    ObjectFactory m_schedulerFactory;
 
     /** Next event unique id. */
     uint32_t m_uid;
@@ -132,6 +170,23 @@ class DefaultSimulatorImpl : public SimulatorImpl
      *  not counting the Destroy events; this is used for validation
      */
     int m_unscheduledEvents;
+    /** Number of cancelled events still held in the event list. */
+    uint64_t m_cancelledEvents;
+    /** Number of times the event list has been compacted. */
+    uint64_t m_compactions;
+    /** Remove cancelled events from the event list immediately. */
+    bool m_eagerCancel;
+    /**
+     * Fraction of cancelled events in the event list which triggers
+     * a compaction; zero disables compaction.
+     */
+    double m_compactionThreshold;
+    /** Minimum event list size before compaction is considered. */
+    uint32_t m_compactionMinEvents;
+    /** The event profiler, if profiling was ever enabled. */
+    std::unique_ptr<EventProfiler> m_profiler;
+    /** Whether the events of the current Run() are profiled. */
+    bool m_profiling;
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
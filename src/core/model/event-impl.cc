@@ -53,6 +53,12 @@ EventImpl::Invoke()
     }
 }
 
+uintptr_t
+EventImpl::GetFunctionId() const
+{
+    return 0;
+}
+
 void
 EventImpl::Cancel()
 {
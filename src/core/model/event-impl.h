@@ -66,6 +66,17 @@ class EventImpl : public SimpleRefCount<EventImpl>
      * Checked by the simulation engine before calling Invoke().
      */
     bool IsCancelled();
+    /**
+     * Get an identifier of the function or method called by the event.
+     *
+     * The events made by MakeEvent() from different functions, or
+     * methods, with the same signature have the same type: this
+     * identifier tells them apart.
+     *
+     * \returns The address of the function, the first word of the pointer
+     *          to member function, or 0 if the event type identifies it.
+     */
+    virtual uintptr_t GetFunctionId() const;
 
   protected:
     /**
@@ -0,0 +1,272 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-profiler.h"
+
+#include "boolean.h"
+#include "event-impl.h"
+#include "fatal-error.h"
+#include "global-value.h"
+#include "log.h"
+#include "simulator.h"
+#include "string.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#if (__GNUC__ >= 3)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventProfiler");
+
+/**
+ * \ingroup simulator
+ * \anchor GlobalValueEventProfiler
+ * Profile the wall clock time spent in every type of event.
+ */
+static GlobalValue g_eventProfiler =
+    GlobalValue("EventProfiler",
+                "Profile the wall clock time spent in every type of event "
+                "(read at the beginning of Simulator::Run, printed at Simulator::Destroy)",
+                BooleanValue(false),
+                MakeBooleanChecker());
+
+/**
+ * \ingroup simulator
+ * \anchor GlobalValueEventProfilerTraceFile
+ * Chrome trace-event file written by the event profiler.
+ */
+static GlobalValue g_eventProfilerTraceFile =
+    GlobalValue("EventProfilerTraceFile",
+                "Chrome trace-event file written by the event profiler (none if empty)",
+                StringValue(""),
+                MakeStringChecker());
+
+/**
+ * \ingroup simulator
+ * Demangle a C++ type name.
+ * \param [in] mangled The mangled name.
+ * \returns The demangled name, or \p mangled if it cannot be demangled.
+ */
+static std::string
+Demangle(const char* mangled)
+{
+#if (__GNUC__ >= 3)
+    int status;
+    char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+    if (status == 0 && demangled != nullptr)
+    {
+        std::string ret = demangled;
+        std::free(demangled);
+        return ret;
+    }
+    std::free(demangled);
+#endif
+    return mangled;
+}
+
+EventProfiler::EventProfiler(bool trace)
+    : m_lastType(nullptr),
+      m_lastFunction(0),
+      m_lastIndex(0),
+      m_trace(trace),
+      m_startTicks(GetTimestamp()),
+      m_startTime(std::chrono::steady_clock::now())
+{
+    NS_LOG_FUNCTION(this << trace);
+}
+
+void
+EventProfiler::Record(const EventImpl* event,
+                      uint32_t context,
+                      uint64_t ts,
+                      uint64_t start,
+                      uint64_t end)
+{
+    const std::type_info& type = typeid(*event);
+    uintptr_t function = event->GetFunctionId();
+    if (m_lastType == nullptr || *m_lastType != type || m_lastFunction != function)
+    {
+        TypeKey key(std::type_index(type), function);
+        auto it = m_typeIndex.find(key);
+        if (it == m_typeIndex.end())
+        {
+            it = m_typeIndex.emplace(key, m_types.size()).first;
+            std::ostringstream name;
+            name << Demangle(type.name());
+            if (function != 0)
+            {
+                name << " [0x" << std::hex << function << "]";
+            }
+            m_typeNames.push_back(name.str());
+            m_types.emplace_back();
+        }
+        m_lastType = &type;
+        m_lastFunction = function;
+        m_lastIndex = it->second;
+    }
+    uint64_t ticks = end - start;
+    Stats& stats = m_types[m_lastIndex];
+    stats.count++;
+    stats.ticks += ticks;
+    Stats& contextStats = m_contexts[context];
+    contextStats.count++;
+    contextStats.ticks += ticks;
+    if (m_trace)
+    {
+        m_events.push_back({m_lastIndex, context, ts, start, ticks});
+    }
+}
+
+double
+EventProfiler::GetTickPeriod() const
+{
+    uint64_t ticks = GetTimestamp() - m_startTicks;
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - m_startTime)
+                  .count();
+    if (ticks == 0)
+    {
+        return 1;
+    }
+    return static_cast<double>(ns) / ticks;
+}
+
+void
+EventProfiler::Print(std::ostream& os) const
+{
+    double period = GetTickPeriod();
+    uint64_t totalCount = 0;
+    uint64_t totalTicks = 0;
+    for (const auto& stats : m_types)
+    {
+        totalCount += stats.count;
+        totalTicks += stats.ticks;
+    }
+
+    auto printRow = [&os, period, totalTicks](const Stats& stats, const std::string& name) {
+        double ns = stats.ticks * period;
+        os << std::setw(12) << stats.count << std::setw(14) << std::fixed << std::setprecision(3)
+           << ns / 1e6 << std::setw(8) << std::setprecision(1)
+           << (totalTicks > 0 ? 100.0 * stats.ticks / totalTicks : 0.0) << std::setw(12)
+           << std::setprecision(1) << ns / stats.count << "  " << name << std::endl;
+    };
+    auto printHeader = [&os](const std::string& what) {
+        os << std::setw(12) << "events" << std::setw(14) << "total (ms)" << std::setw(8) << "%"
+           << std::setw(12) << "mean (ns)"
+           << "  " << what << std::endl;
+    };
+
+    os << "Event profile: " << totalCount << " events, " << std::fixed << std::setprecision(3)
+       << totalTicks * period / 1e6 << " ms" << std::endl;
+
+    std::vector<uint32_t> types(m_types.size());
+    for (uint32_t i = 0; i < types.size(); ++i)
+    {
+        types[i] = i;
+    }
+    std::sort(types.begin(), types.end(), [this](uint32_t a, uint32_t b) {
+        return m_types[a].ticks > m_types[b].ticks;
+    });
+    printHeader("event type");
+    for (uint32_t i : types)
+    {
+        printRow(m_types[i], m_typeNames[i]);
+    }
+
+    std::vector<std::pair<uint32_t, Stats>> contexts(m_contexts.begin(), m_contexts.end());
+    std::sort(contexts.begin(), contexts.end(), [](const auto& a, const auto& b) {
+        return a.second.ticks > b.second.ticks;
+    });
+    printHeader("context");
+    for (const auto& context : contexts)
+    {
+        printRow(context.second,
+                 context.first == Simulator::NO_CONTEXT ? std::string("-")
+                                                        : std::to_string(context.first));
+    }
+    os.unsetf(std::ios_base::floatfield);
+}
+
+void
+EventProfiler::WriteTrace(const std::string& filename) const
+{
+    NS_LOG_FUNCTION(this << filename);
+    std::ofstream os(filename);
+    if (!os.is_open())
+    {
+        NS_FATAL_ERROR("Cannot open event profiler trace file " << filename);
+    }
+    double period = GetTickPeriod() / 1000;
+    os << "{\"traceEvents\":[" << std::endl;
+    for (std::size_t i = 0; i < m_events.size(); ++i)
+    {
+        const TraceEvent& event = m_events[i];
+        std::string name = m_typeNames[event.type];
+        std::replace(name.begin(), name.end(), '"', '\'');
+        os << (i == 0 ? " " : ",") << "{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":0"
+           << ",\"tid\":"
+           << (event.context == Simulator::NO_CONTEXT ? -1 : static_cast<int64_t>(event.context))
+           << ",\"ts\":" << std::fixed << std::setprecision(3)
+           << (event.start - m_startTicks) * period << ",\"dur\":" << event.ticks * period
+           << ",\"args\":{\"time\":\"" << TimeStep(event.ts).As(Time::S) << "\"}}" << std::endl;
+    }
+    os << "]}" << std::endl;
+}
+
+uint64_t
+EventProfiler::GetEventCount() const
+{
+    uint64_t count = 0;
+    for (const auto& stats : m_types)
+    {
+        count += stats.count;
+    }
+    return count;
+}
+
+std::size_t
+EventProfiler::GetTypeCount() const
+{
+    return m_types.size();
+}
+
+uint64_t
+EventProfiler::GetEventCount(const std::string& name) const
+{
+    for (std::size_t i = 0; i < m_typeNames.size(); ++i)
+    {
+        if (m_typeNames[i].find(name) != std::string::npos)
+        {
+            return m_types[i].count;
+        }
+    }
+    return 0;
+}
+
+} // namespace ns3
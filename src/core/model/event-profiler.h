@@ -0,0 +1,204 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include <chrono>
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Wall clock time spent in every type of event.
+ *
+ * The profiler aggregates the number of events and the time spent
+ * running them, measured with the processor time stamp counter where
+ * available, per event implementation type and function (which
+ * identify the function or method passed to Simulator::Schedule and its
+ * argument types) and per context.  Optionally, every event is also recorded
+ * to be written as a Chrome trace-event file, which can be loaded in
+ * \c chrome://tracing or Perfetto.
+ *
+ * DefaultSimulatorImpl uses a profiler when the \c EventProfiler
+ * GlobalValue is \c true at the beginning of Simulator::Run(); the
+ * results are printed to \c std::clog at Simulator::Destroy(), and
+ * the trace is written to the \c EventProfilerTraceFile, if any.
+ *
+ * Unlike DesMetrics, which writes every event as it is scheduled, the
+ * profiler only updates a few counters per event.
+ */
+class EventProfiler
+{
+  public:
+    /**
+     * Constructor.
+     * \param [in] trace Record every event for WriteTrace().
+     */
+    EventProfiler(bool trace);
+
+    /**
+     * Get the current value of the profiling clock.
+     * \returns The time stamp counter, or the time in ns if there is none.
+     */
+    static uint64_t GetTimestamp();
+
+    /**
+     * Account for an event.
+     * \param [in] event The event implementation.
+     * \param [in] context The event context.
+     * \param [in] ts The simulation time of the event, in time steps.
+     * \param [in] start The profiling clock when the event started.
+     * \param [in] end The profiling clock when the event ended.
+     */
+    void Record(const EventImpl* event, uint32_t context, uint64_t ts, uint64_t start, uint64_t end);
+
+    /**
+     * Print the time spent per event type and per context,
+     * sorted by decreasing total time.
+     * \param [in,out] os The output stream.
+     */
+    void Print(std::ostream& os) const;
+    /**
+     * Write the recorded events as a Chrome trace-event file.
+     * \param [in] filename The file name.
+     */
+    void WriteTrace(const std::string& filename) const;
+
+    /**
+     * Get the number of events recorded.
+     * \returns The number of events.
+     */
+    uint64_t GetEventCount() const;
+    /**
+     * Get the number of event types recorded.
+     * \returns The number of types.
+     */
+    std::size_t GetTypeCount() const;
+    /**
+     * Get the number of events of one type.
+     * \param [in] name The name of the event type, or a substring of it.
+     *             The name is the demangled name of the event
+     *             implementation type, followed by the identifier of the
+     *             function in hexadecimal, as in \c " [0x4011d6]", if any.
+     * \returns The number of events of the first matching type.
+     */
+    uint64_t GetEventCount(const std::string& name) const;
+
+  private:
+    /** Statistics of a set of events. */
+    struct Stats
+    {
+        uint64_t count{0}; //!< Number of events.
+        uint64_t ticks{0}; //!< Sum of the profiling clock durations.
+    };
+
+    /** An event recorded for the trace. */
+    struct TraceEvent
+    {
+        uint32_t type;    //!< Index of the event type.
+        uint32_t context; //!< Event context.
+        uint64_t ts;      //!< Simulation time, in time steps.
+        uint64_t start;   //!< Profiling clock at the start.
+        uint64_t ticks;   //!< Profiling clock duration.
+    };
+
+    /**
+     * Get the number of nanoseconds per profiling clock tick.
+     * \returns The clock period.
+     */
+    double GetTickPeriod() const;
+
+    /**
+     * An event type: the event implementation type, and the identifier of
+     * the function called.
+     */
+    using TypeKey = std::pair<std::type_index, uintptr_t>;
+
+    /** Hash function of a TypeKey. */
+    struct TypeKeyHash
+    {
+        /**
+         * \param [in] key The key.
+         * \returns The hash of the key.
+         */
+        std::size_t operator()(const TypeKey& key) const
+        {
+            return key.first.hash_code() ^ std::hash<uintptr_t>()(key.second);
+        }
+    };
+
+    /** Index of every event type in m_types. */
+    std::unordered_map<TypeKey, uint32_t, TypeKeyHash> m_typeIndex;
+    /** Demangled names of the event types. */
+    std::vector<std::string> m_typeNames;
+    /** Statistics of the event types. */
+    std::vector<Stats> m_types;
+    /** Statistics of the contexts. */
+    std::unordered_map<uint32_t, Stats> m_contexts;
+    /** Last type recorded, to skip the type lookup of repeated events. */
+    const std::type_info* m_lastType;
+    /** Function of the last type recorded. */
+    uintptr_t m_lastFunction;
+    /** Index of m_lastType. */
+    uint32_t m_lastIndex;
+
+    /** Whether every event is recorded. */
+    bool m_trace;
+    /** The recorded events. */
+    std::vector<TraceEvent> m_events;
+
+    /** Profiling clock at construction. */
+    uint64_t m_startTicks;
+    /** Wall clock at construction. */
+    std::chrono::steady_clock::time_point m_startTime;
+};
+
+inline uint64_t
+EventProfiler::GetTimestamp()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
@@ -141,6 +141,21 @@
 #define NS_LOG_APPEND_CONTEXT
 #endif /* NS_LOG_APPEND_CONTEXT */
 
+/**
+ * \ingroup logging
+ *
+ * Declare \c ns3LogRingWriter, which writes a record of the binary ring
+ * buffer logging backend for the call site of the macro.
+ *
+ * \param [in] level The log level.
+ * \internal
+ * Logging implementation macro; should not be called directly.
+ */
+#define NS_LOG_RING_WRITER(level)                                                                  \
+    static const uint32_t ns3LogRingSite =                                                         \
+        ns3::LogRingRegisterSite(g_log.Name(), __FUNCTION__);                                      \
+    ns3::LogRingWriter ns3LogRingWriter(ns3LogRingSite, level)
+
 #ifndef NS_LOG_CONDITION
 /**
  * \ingroup logging
@@ -184,12 +199,20 @@
     {                                                                                              \
         if (g_log.IsEnabled(level))                                                                \
         {                                                                                          \
-            NS_LOG_APPEND_TIME_PREFIX;                                                             \
-            NS_LOG_APPEND_NODE_PREFIX;                                                             \
-            NS_LOG_APPEND_CONTEXT;                                                                 \
-            NS_LOG_APPEND_FUNC_PREFIX;                                                             \
-            NS_LOG_APPEND_LEVEL_PREFIX(level);                                                     \
-            std::clog << msg << std::endl;                                                         \
+            if (ns3::LogRingIsEnabled())                                                           \
+            {                                                                                      \
+                NS_LOG_RING_WRITER(level);                                                         \
+                ns3LogRingWriter.GetStream() << msg;                                               \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                NS_LOG_APPEND_TIME_PREFIX;                                                         \
+                NS_LOG_APPEND_NODE_PREFIX;                                                         \
+                NS_LOG_APPEND_CONTEXT;                                                             \
+                NS_LOG_APPEND_FUNC_PREFIX;                                                         \
+                NS_LOG_APPEND_LEVEL_PREFIX(level);                                                 \
+                std::clog << msg << std::endl;                                                     \
+            }                                                                                      \
         }                                                                                          \
     } while (false)
 
@@ -207,10 +230,17 @@
     {                                                                                              \
         if (g_log.IsEnabled(ns3::LOG_FUNCTION))                                                    \
         {                                                                                          \
-            NS_LOG_APPEND_TIME_PREFIX;                                                             \
-            NS_LOG_APPEND_NODE_PREFIX;                                                             \
-            NS_LOG_APPEND_CONTEXT;                                                                 \
-            std::clog << g_log.Name() << ":" << __FUNCTION__ << "()" << std::endl;                 \
+            if (ns3::LogRingIsEnabled())                                                           \
+            {                                                                                      \
+                NS_LOG_RING_WRITER(ns3::LOG_FUNCTION);                                             \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                NS_LOG_APPEND_TIME_PREFIX;                                                         \
+                NS_LOG_APPEND_NODE_PREFIX;                                                         \
+                NS_LOG_APPEND_CONTEXT;                                                             \
+                std::clog << g_log.Name() << ":" << __FUNCTION__ << "()" << std::endl;             \
+            }                                                                                      \
         }                                                                                          \
     } while (false)
 
@@ -241,12 +271,20 @@
     {                                                                                              \
         if (g_log.IsEnabled(ns3::LOG_FUNCTION))                                                    \
         {                                                                                          \
-            NS_LOG_APPEND_TIME_PREFIX;                                                             \
-            NS_LOG_APPEND_NODE_PREFIX;                                                             \
-            NS_LOG_APPEND_CONTEXT;                                                                 \
-            std::clog << g_log.Name() << ":" << __FUNCTION__ << "(";                               \
-            ns3::ParameterLogger(std::clog) << parameters;                                         \
-            std::clog << ")" << std::endl;                                                         \
+            if (ns3::LogRingIsEnabled())                                                           \
+            {                                                                                      \
+                NS_LOG_RING_WRITER(ns3::LOG_FUNCTION);                                             \
+                ns3::ParameterLogger(ns3LogRingWriter.GetStream()) << parameters;                  \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                NS_LOG_APPEND_TIME_PREFIX;                                                         \
+                NS_LOG_APPEND_NODE_PREFIX;                                                         \
+                NS_LOG_APPEND_CONTEXT;                                                             \
+                std::clog << g_log.Name() << ":" << __FUNCTION__ << "(";                           \
+                ns3::ParameterLogger(std::clog) << parameters;                                     \
+                std::clog << ")" << std::endl;                                                     \
+            }                                                                                      \
         }                                                                                          \
     } while (false)
 
@@ -0,0 +1,511 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "log-ring.h"
+
+#include "environment-variable.h"
+#include "log.h"
+#include "nstime.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup logging
+ * Binary ring buffer logging backend implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup logging
+ * A stream over the text of a record, which truncates the message.
+ */
+struct LogRingStream
+{
+    /** The stream buffer. */
+    class Buffer : public std::streambuf
+    {
+      public:
+        /**
+         * Point the buffer to a text.
+         * \param [in] begin The beginning of the text.
+         * \param [in] size The size of the text.
+         */
+        void Reset(char* begin, std::size_t size)
+        {
+            setp(begin, begin + size);
+        }
+
+        /**
+         * Get the length of the text written.
+         * \returns The length.
+         */
+        std::size_t GetLength() const
+        {
+            return pptr() - pbase();
+        }
+    };
+
+    /** Constructor. */
+    LogRingStream()
+        : stream(&buffer)
+    {
+    }
+
+    Buffer buffer;       //!< The stream buffer.
+    std::ostream stream; //!< The stream over #buffer.
+};
+
+/**
+ * \ingroup logging
+ * The ring buffer of records of a thread.
+ */
+struct LogRing
+{
+    /**
+     * Constructor.
+     * \param [in] size The number of records, a power of two.
+     */
+    LogRing(std::size_t size)
+        : records(size),
+          next(0),
+          depth(0)
+    {
+    }
+
+    std::vector<LogRingRecord> records;                  //!< The records.
+    uint64_t next;                                       //!< The number of records written.
+    std::vector<std::unique_ptr<LogRingStream>> streams; //!< The streams, one per nesting level.
+    std::size_t depth;                                   //!< The number of writers in use.
+};
+
+namespace
+{
+
+/** The magic number at the beginning of a dump, with the version of the format. */
+const char LOG_RING_MAGIC[8] = {'N', 'S', '3', 'L', 'O', 'G', 'R', '1'};
+
+/** The signals which trigger a dump. */
+const int LOG_RING_SIGNALS[] = {SIGSEGV, SIGABRT, SIGFPE, SIGILL};
+
+/** Is the backend enabled? */
+std::atomic<bool> g_enabled{false};
+/** Incremented by every LogRingEnable(), to discard the rings of the threads. */
+std::atomic<uint32_t> g_generation{0};
+/** The next sequence number. */
+std::atomic<uint64_t> g_sequence{0};
+/** The number of records of a ring. */
+std::size_t g_size{0};
+/** The file to dump the rings to. */
+std::string g_filename;
+/** Were the exit handler and signal handlers installed? */
+bool g_handlersInstalled{false};
+
+/**
+ * Get the mutex which protects the rings and the call sites.
+ * \returns The mutex.
+ */
+std::mutex&
+GetMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+/**
+ * Get the rings of all the threads.
+ * \returns The rings.
+ */
+std::vector<std::unique_ptr<LogRing>>&
+GetRings()
+{
+    static std::vector<std::unique_ptr<LogRing>> rings;
+    return rings;
+}
+
+/**
+ * Get the call sites: the component and the function names.
+ * \returns The call sites.
+ */
+std::vector<std::pair<std::string, std::string>>&
+GetSites()
+{
+    static std::vector<std::pair<std::string, std::string>> sites;
+    return sites;
+}
+
+/** The ring of the calling thread. */
+thread_local LogRing* t_ring = nullptr;
+/** The generation of #t_ring. */
+thread_local uint32_t t_generation = 0;
+
+/**
+ * Get the ring of the calling thread, created on first use.
+ * \returns The ring.
+ */
+LogRing*
+GetRing()
+{
+    uint32_t generation = g_generation.load(std::memory_order_acquire);
+    if (t_ring == nullptr || t_generation != generation)
+    {
+        std::unique_lock lock{GetMutex()};
+        GetRings().push_back(std::make_unique<LogRing>(g_size));
+        t_ring = GetRings().back().get();
+        t_generation = generation;
+    }
+    return t_ring;
+}
+
+/**
+ * Write a value to a dump.
+ * \param [in] file The dump.
+ * \param [in] data The value.
+ * \param [in] size The size of the value.
+ * \returns \c true if the value was written.
+ */
+bool
+Write(std::FILE* file, const void* data, std::size_t size)
+{
+    return std::fwrite(data, 1, size, file) == size;
+}
+
+/**
+ * Write a string to a dump, preceded by its length.
+ * \param [in] file The dump.
+ * \param [in] s The string.
+ * \returns \c true if the string was written.
+ */
+bool
+WriteString(std::FILE* file, const std::string& s)
+{
+    uint32_t length = s.size();
+    return Write(file, &length, sizeof(length)) && Write(file, s.data(), length);
+}
+
+/**
+ * Read a value from a dump.
+ * \param [in] is The dump.
+ * \param [out] data The value.
+ * \param [in] size The size of the value.
+ * \returns \c true if the value was read.
+ */
+bool
+Read(std::istream& is, void* data, std::size_t size)
+{
+    return bool(is.read(static_cast<char*>(data), size));
+}
+
+/**
+ * Read a string from a dump, preceded by its length.
+ * \param [in] is The dump.
+ * \param [out] s The string.
+ * \returns \c true if the string was read.
+ */
+bool
+ReadString(std::istream& is, std::string& s)
+{
+    uint32_t length;
+    if (!Read(is, &length, sizeof(length)))
+    {
+        return false;
+    }
+    s.resize(length);
+    return Read(is, s.data(), length);
+}
+
+/** Dump the rings to #g_filename at exit. */
+void
+DumpAtExit()
+{
+    if (g_enabled && !g_filename.empty())
+    {
+        LogRingDump(g_filename);
+    }
+    // Whatever is logged by the static destructors goes to std::clog.
+    g_enabled = false;
+}
+
+/**
+ * Dump the rings to #g_filename when the program crashes.
+ * \param [in] signal The signal.
+ */
+void
+DumpOnSignal(int signal)
+{
+    // Best effort: the program may have crashed in the middle of a write,
+    // or with the mutex locked, which this ignores.
+    g_enabled = false;
+    if (!g_filename.empty())
+    {
+        LogRingDump(g_filename);
+    }
+    std::signal(signal, SIG_DFL);
+    std::raise(signal);
+}
+
+/**
+ * Enable the backend from the \c NS_LOG_RING environment variable.
+ * \returns \c true if the backend was enabled.
+ */
+bool
+CheckEnvironmentVariable()
+{
+    auto [found, records] = EnvironmentVariable::Get("NS_LOG_RING", "Records");
+    if (!found)
+    {
+        return false;
+    }
+    std::string filename = "ns3-log.ring";
+    auto [foundFile, file] = EnvironmentVariable::Get("NS_LOG_RING", "File");
+    if (foundFile)
+    {
+        filename = file;
+    }
+    LogRingEnable(std::strtoull(records.c_str(), nullptr, 10), filename);
+    return true;
+}
+
+/** Enable the backend from the environment when the library is loaded. */
+const bool g_environment [[maybe_unused]] = CheckEnvironmentVariable();
+
+} // unnamed namespace
+
+void
+LogRingEnable(std::size_t records, const std::string& filename)
+{
+    std::size_t size = 1;
+    while (size < records)
+    {
+        size <<= 1;
+    }
+    {
+        std::unique_lock lock{GetMutex()};
+        GetRings().clear();
+        g_size = size;
+        g_filename = filename;
+        g_generation++;
+    }
+    if (!g_handlersInstalled)
+    {
+        // Construct the call sites before registering the exit handler,
+        // so that they are destroyed after it runs.
+        GetSites();
+        std::atexit(&DumpAtExit);
+        for (int signal : LOG_RING_SIGNALS)
+        {
+            std::signal(signal, &DumpOnSignal);
+        }
+        g_handlersInstalled = true;
+    }
+    g_enabled = true;
+}
+
+void
+LogRingDisable()
+{
+    g_enabled = false;
+    std::unique_lock lock{GetMutex()};
+    GetRings().clear();
+    g_filename.clear();
+    g_generation++;
+}
+
+bool
+LogRingIsEnabled()
+{
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+uint32_t
+LogRingRegisterSite(const std::string& component, const char* function)
+{
+    std::unique_lock lock{GetMutex()};
+    GetSites().emplace_back(component, function);
+    return GetSites().size() - 1;
+}
+
+bool
+LogRingDump(const std::string& filename)
+{
+    std::FILE* file = std::fopen(filename.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    const auto& sites = GetSites();
+    const auto& rings = GetRings();
+    uint32_t recordSize = sizeof(LogRingRecord);
+    int64_t stepsPerSecond = Time::FromInteger(1, Time::S).GetTimeStep();
+    uint32_t nSites = sites.size();
+    uint64_t nRecords = 0;
+    for (const auto& ring : rings)
+    {
+        nRecords += std::min<uint64_t>(ring->next, ring->records.size());
+    }
+    bool ok = Write(file, LOG_RING_MAGIC, sizeof(LOG_RING_MAGIC)) &&
+              Write(file, &recordSize, sizeof(recordSize)) &&
+              Write(file, &stepsPerSecond, sizeof(stepsPerSecond)) &&
+              Write(file, &nSites, sizeof(nSites));
+    for (uint32_t i = 0; ok && i < nSites; i++)
+    {
+        ok = WriteString(file, sites[i].first) && WriteString(file, sites[i].second);
+    }
+    ok = ok && Write(file, &nRecords, sizeof(nRecords));
+    for (const auto& ring : rings)
+    {
+        std::size_t n = std::min<uint64_t>(ring->next, ring->records.size());
+        ok = ok && Write(file, ring->records.data(), n * sizeof(LogRingRecord));
+    }
+    return (std::fclose(file) == 0) && ok;
+}
+
+bool
+LogRingDecode(std::istream& is, std::ostream& os)
+{
+    char magic[sizeof(LOG_RING_MAGIC)];
+    uint32_t recordSize;
+    int64_t stepsPerSecond;
+    uint32_t nSites;
+    if (!Read(is, magic, sizeof(magic)) ||
+        std::memcmp(magic, LOG_RING_MAGIC, sizeof(LOG_RING_MAGIC)) != 0 ||
+        !Read(is, &recordSize, sizeof(recordSize)) || recordSize != sizeof(LogRingRecord) ||
+        !Read(is, &stepsPerSecond, sizeof(stepsPerSecond)) || stepsPerSecond <= 0 ||
+        !Read(is, &nSites, sizeof(nSites)))
+    {
+        return false;
+    }
+    std::vector<std::pair<std::string, std::string>> sites(nSites);
+    for (auto& site : sites)
+    {
+        if (!ReadString(is, site.first) || !ReadString(is, site.second))
+        {
+            return false;
+        }
+    }
+    uint64_t nRecords;
+    if (!Read(is, &nRecords, sizeof(nRecords)))
+    {
+        return false;
+    }
+    std::vector<LogRingRecord> records;
+    LogRingRecord record;
+    for (uint64_t i = 0; i < nRecords; i++)
+    {
+        if (!Read(is, &record, sizeof(record)) || record.site >= nSites ||
+            record.length > LogRingRecord::TEXT_SIZE)
+        {
+            return false;
+        }
+        records.push_back(record);
+    }
+    std::sort(records.begin(), records.end(), [](const auto& a, const auto& b) {
+        return a.sequence < b.sequence;
+    });
+
+    for (const auto& r : records)
+    {
+        if (r.time >= 0)
+        {
+            os << "+" << std::fixed << std::setprecision(9)
+               << static_cast<double>(r.time) / stepsPerSecond << "s ";
+        }
+        if (r.context == Simulator::NO_CONTEXT)
+        {
+            os << "-1 ";
+        }
+        else
+        {
+            os << r.context << " ";
+        }
+        const auto& [component, function] = sites[r.site];
+        std::string text(r.text, r.length);
+        if (r.level == LOG_FUNCTION)
+        {
+            os << component << ":" << function << "(" << text << ")" << std::endl;
+        }
+        else
+        {
+            os << component << ":" << function << "(): ["
+               << LogComponent::GetLevelLabel(static_cast<LogLevel>(r.level)) << "] " << text
+               << std::endl;
+        }
+    }
+    return true;
+}
+
+LogRingWriter::LogRingWriter(uint32_t site, uint32_t level)
+{
+    m_ring = GetRing();
+    m_record = &m_ring->records[m_ring->next & (m_ring->records.size() - 1)];
+    m_ring->next++;
+    m_record->sequence = g_sequence.fetch_add(1, std::memory_order_relaxed);
+    // The time printer is set when the simulator implementation is created:
+    // asking the simulator for the time before would create it.
+    if (LogGetTimePrinter() != nullptr)
+    {
+        m_record->time = Simulator::Now().GetTimeStep();
+        m_record->context = Simulator::GetContext();
+    }
+    else
+    {
+        m_record->time = -1;
+        m_record->context = Simulator::NO_CONTEXT;
+    }
+    m_record->site = site;
+    m_record->level = level;
+    m_record->length = 0;
+
+    if (m_ring->depth == m_ring->streams.size())
+    {
+        m_ring->streams.push_back(std::make_unique<LogRingStream>());
+    }
+    m_stream = m_ring->streams[m_ring->depth].get();
+    m_ring->depth++;
+    m_stream->buffer.Reset(m_record->text, LogRingRecord::TEXT_SIZE);
+    // Undo the truncation and the manipulators of the previous message.
+    m_stream->stream.clear();
+    m_stream->stream.flags(std::ios_base::skipws | std::ios_base::dec);
+    m_stream->stream.precision(6);
+    m_stream->stream.fill(' ');
+}
+
+LogRingWriter::~LogRingWriter()
+{
+    m_record->length = m_stream->buffer.GetLength();
+    m_ring->depth--;
+}
+
+std::ostream&
+LogRingWriter::GetStream()
+{
+    return m_stream->stream;
+}
+
+} // namespace ns3
@@ -0,0 +1,174 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_LOG_RING_H
+#define NS3_LOG_RING_H
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <stdint.h>
+#include <string>
+
+/**
+ * \file
+ * \ingroup logging
+ * Binary ring buffer logging backend declarations.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup logging
+ *
+ * Enable the binary ring buffer logging backend.
+ *
+ * While it is enabled, the NS_LOG macros of the enabled components,
+ * except NS_LOG_UNCOND, do not write to \c std::clog.  Every message
+ * goes to a fixed-size record of the ring buffer of the calling thread,
+ * which overwrites the oldest record when it is full:
+ * - a sequence number, which orders the records of all the threads,
+ * - the simulation time and context,
+ * - the call site: the log component and the function,
+ * - the log level,
+ * - the first LogRingRecord::TEXT_SIZE bytes of the message.
+ *
+ * Nothing is flushed or written to a file while the program runs.  The
+ * rings are dumped to \pname{filename} when the program exits, or when
+ * it is killed by \c SIGSEGV, \c SIGABRT (which includes NS_FATAL_ERROR
+ * and failed NS_ASSERT), \c SIGFPE or \c SIGILL.  The dump is decoded
+ * offline with LogRingDecode(), or the \c decode-log-ring program:
+ *
+ * \code
+ *   ./ns3 run "decode-log-ring ns3-log.ring"
+ * \endcode
+ *
+ * The backend can also be enabled without changing the program, with the
+ * \c NS_LOG_RING environment variable:
+ *
+ * \code
+ *   NS_LOG="*=level_info" NS_LOG_RING="Records=1048576;File=ns3-log.ring" ./program
+ * \endcode
+ *
+ * The prefix flags of the components are ignored: every record has all
+ * of them.  So is NS_LOG_APPEND_CONTEXT.
+ *
+ * This should not be called while other threads are logging.
+ *
+ * \param [in] records The number of records of the ring of every thread,
+ *             rounded up to a power of two.
+ * \param [in] filename The file to dump the rings to, or an empty string
+ *             to only dump them with LogRingDump().
+ */
+void LogRingEnable(std::size_t records, const std::string& filename);
+/**
+ * \ingroup logging
+ * Disable the binary ring buffer logging backend, and discard the records.
+ */
+void LogRingDisable();
+/**
+ * \ingroup logging
+ * Check if the binary ring buffer logging backend is enabled.
+ * \returns \c true if the NS_LOG macros write to the rings.
+ */
+bool LogRingIsEnabled();
+/**
+ * \ingroup logging
+ * Dump the rings of all the threads.
+ * \param [in] filename The file to write.
+ * \returns \c true if the dump was written.
+ */
+bool LogRingDump(const std::string& filename);
+/**
+ * \ingroup logging
+ * Decode a dump of the rings, in the text format of the NS_LOG macros,
+ * with all the prefixes, ordered by sequence number.
+ * \param [in] is The dump.
+ * \param [in,out] os The output stream.
+ * \returns \c true if the dump could be decoded.
+ */
+bool LogRingDecode(std::istream& is, std::ostream& os);
+
+/**
+ * \ingroup logging
+ * A record of the binary ring buffer logging backend.
+ */
+struct LogRingRecord
+{
+    /** The size of the message text. */
+    static constexpr std::size_t TEXT_SIZE = 96;
+
+    uint64_t sequence;    //!< The order of the record among those of all the threads.
+    int64_t time;         //!< The simulation time, in time steps, or -1 if unknown.
+    uint32_t context;     //!< The simulation context.
+    uint32_t site;        //!< The call site.
+    uint32_t level;       //!< The log level.
+    uint32_t length;      //!< The length of the message text.
+    char text[TEXT_SIZE]; //!< The message text, truncated.
+};
+
+/**
+ * \ingroup logging
+ * Register a call site of the NS_LOG macros.
+ * \param [in] component The name of the log component.
+ * \param [in] function The name of the function.
+ * \returns The call site id.
+ */
+uint32_t LogRingRegisterSite(const std::string& component, const char* function);
+
+struct LogRing;
+struct LogRingStream;
+
+/**
+ * \ingroup logging
+ * Write a message to the next record of the ring of the calling thread.
+ *
+ * Used by the NS_LOG macros.  The message streamed to GetStream() is
+ * written directly in the record, and truncated to its text size.  The
+ * streams are reused: every thread keeps one per nesting level of the
+ * writers, for the messages which log while they are formatted.
+ */
+class LogRingWriter
+{
+  public:
+    /**
+     * Constructor.  Takes the next record of the ring.
+     * \param [in] site The call site id, from LogRingRegisterSite().
+     * \param [in] level The log level.
+     */
+    LogRingWriter(uint32_t site, uint32_t level);
+    /** Destructor.  Completes the record. */
+    ~LogRingWriter();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    LogRingWriter(const LogRingWriter&) = delete;
+    LogRingWriter& operator=(const LogRingWriter&) = delete;
+
+    /**
+     * Get the stream to write the message to.
+     * \returns The stream.
+     */
+    std::ostream& GetStream();
+
+  private:
+    LogRing* m_ring;         //!< The ring of the calling thread.
+    LogRingRecord* m_record; //!< The record.
+    LogRingStream* m_stream; //!< The stream over the text of the record.
+};
+
+} // namespace ns3
+
+#endif /* NS3_LOG_RING_H */
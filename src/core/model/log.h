@@ -22,6 +22,7 @@
 
 #include "log-macros-disabled.h"
 #include "log-macros-enabled.h"
+#include "log-ring.h"
 #include "node-printer.h"
 #include "time-printer.h"
 
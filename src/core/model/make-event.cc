@@ -58,6 +58,11 @@ MakeEvent(void (*f)())
             (*m_function)();
         }
 
+        uintptr_t GetFunctionId() const override
+        {
+            return GetEventFunctionId(m_function);
+        }
+
       private:
         F m_function;
     }* ev = new EventFunctionImpl0(f);
@@ -0,0 +1,166 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * \file
+ * \ingroup system
+ * ns3::MpscQueue declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup system
+ * \brief Lock-free multiple producer, single consumer queue.
+ *
+ * Any thread may Push() values; a single thread, the consumer, takes
+ * all of them at once with Drain(), in the order they were pushed.
+ * Push() is a single compare-and-swap on the head of a linked list, and
+ * Drain() a single exchange, so producers never wait for the consumer
+ * and the consumer never waits for producers.
+ *
+ * This is used by the simulator implementations to collect the events
+ * scheduled from threads other than the main simulation thread.
+ *
+ * \tparam T \deduced The value type.
+ */
+template <typename T>
+class MpscQueue
+{
+  public:
+    /** Constructor. */
+    MpscQueue();
+    /** Destructor; the values still in the queue are discarded. */
+    ~MpscQueue();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    MpscQueue(const MpscQueue<T>&) = delete;
+    MpscQueue<T>& operator=(const MpscQueue<T>&) = delete;
+
+    /**
+     * Append a value to the queue.  May be called from any thread.
+     * \param [in] value The value.
+     */
+    void Push(T value);
+    /**
+     * Check if the queue is empty.  May be called from any thread, but
+     * the answer may be outdated as soon as it is returned.
+     * \returns \c true if the queue is empty.
+     */
+    bool IsEmpty() const;
+    /**
+     * Remove all values from the queue.  Must only be called by the consumer.
+     * \tparam F \deduced The type of the function.
+     * \param [in] f The function called on every value, in the order they were pushed.
+     * \returns The number of values removed.
+     */
+    template <typename F>
+    std::size_t Drain(F f);
+
+  private:
+    /** A value in the linked list. */
+    struct Node
+    {
+        T value;    //!< The value.
+        Node* next; //!< The node pushed before this one.
+    };
+
+    /** The last node pushed, linked to the previous ones. */
+    std::atomic<Node*> m_head;
+};
+
+} // namespace ns3
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3
+{
+
+template <typename T>
+MpscQueue<T>::MpscQueue()
+    : m_head(nullptr)
+{
+}
+
+template <typename T>
+MpscQueue<T>::~MpscQueue()
+{
+    Drain([](T&) {});
+}
+
+template <typename T>
+void
+MpscQueue<T>::Push(T value)
+{
+    Node* node = new Node{std::move(value), m_head.load(std::memory_order_relaxed)};
+    while (!m_head.compare_exchange_weak(node->next,
+                                         node,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed))
+    {
+    }
+}
+
+template <typename T>
+bool
+MpscQueue<T>::IsEmpty() const
+{
+    return m_head.load(std::memory_order_relaxed) == nullptr;
+}
+
+template <typename T>
+template <typename F>
+std::size_t
+MpscQueue<T>::Drain(F f)
+{
+    if (IsEmpty())
+    {
+        return 0;
+    }
+    // Take the whole list at once, then reverse it to get the push order.
+    Node* head = m_head.exchange(nullptr, std::memory_order_acquire);
+    Node* first = nullptr;
+    while (head != nullptr)
+    {
+        Node* next = head->next;
+        head->next = first;
+        first = head;
+        head = next;
+    }
+    std::size_t n = 0;
+    while (first != nullptr)
+    {
+        Node* next = first->next;
+        f(first->value);
+        delete first;
+        first = next;
+        n++;
+    }
+    return n;
+}
+
+} // namespace ns3
+
+#endif /* MPSC_QUEUE_H */
@@ -497,6 +497,10 @@ class Time
      */
     inline static Time FromInteger(uint64_t value, Unit unit)
     {
+        if (unit == g_resolutionUnit)
+        {
+            return Time(value);
+        }
         struct Information* info = PeekInformation(unit);
 
         NS_ASSERT_MSG(info->isValid, "Attempted a conversion from an unavailable unit.");
@@ -519,6 +523,10 @@ class Time
 
     inline static Time From(const int64x64_t& value, Unit unit)
     {
+        if (unit == g_resolutionUnit)
+        {
+            return Time(value);
+        }
         struct Information* info = PeekInformation(unit);
 
         NS_ASSERT_MSG(info->isValid, "Attempted a conversion from an unavailable unit.");
@@ -553,6 +561,10 @@ class Time
      */
     inline int64_t ToInteger(Unit unit) const
     {
+        if (unit == g_resolutionUnit)
+        {
+            return m_data;
+        }
         struct Information* info = PeekInformation(unit);
 
         NS_ASSERT_MSG(info->isValid, "Attempted a conversion to an unavailable unit.");
@@ -571,11 +583,25 @@ class Time
 
     inline double ToDouble(Unit unit) const
     {
+        if (unit == g_resolutionUnit)
+        {
+            return static_cast<double>(m_data);
+        }
+        struct Information* info = PeekInformation(unit);
+        if (info->toMul && info->isValid)
+        {
+            // The product is an integer, so round it only once, like GetDouble().
+            return static_cast<double>(m_data * info->factor);
+        }
         return To(unit).GetDouble();
     }
 
     inline int64x64_t To(Unit unit) const
     {
+        if (unit == g_resolutionUnit)
+        {
+            return int64x64_t(m_data);
+        }
         struct Information* info = PeekInformation(unit);
 
         NS_ASSERT_MSG(info->isValid, "Attempted a conversion to an unavailable unit.");
@@ -657,6 +683,12 @@ class Time
         return &resolution;
     }
 
+    /**
+     *  The unit of the current Resolution, checked by the fast paths of the
+     *  conversions without the guard of the static Resolution.
+     */
+    static inline Unit g_resolutionUnit = NS;
+
     /**
      *  Get the Information record for \pname{timeUnit} for the current Resolution
      *
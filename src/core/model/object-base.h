@@ -42,11 +42,18 @@
  *
  * If the class is in a namespace, then the macro call should also be
  * in the namespace.
+ *
+ * The class is registered on demand, see TypeId::AddRegistration().
  */
 #define NS_OBJECT_ENSURE_REGISTERED(type)                                                          \
     static struct Object##type##RegistrationClass                                                  \
     {                                                                                              \
         Object##type##RegistrationClass()                                                          \
+        {                                                                                          \
+            ns3::TypeId::AddRegistration(#type, &Register);                                        \
+        }                                                                                          \
+                                                                                                   \
+        static void Register()                                                                     \
         {                                                                                          \
             NS_WARNING_PUSH_DEPRECATED;                                                            \
             ns3::TypeId tid = type::GetTypeId();                                                   \
@@ -86,6 +93,11 @@
     static struct Object##type##param##RegistrationClass                                           \
     {                                                                                              \
         Object##type##param##RegistrationClass()                                                   \
+        {                                                                                          \
+            ns3::TypeId::AddRegistration(#type, &Register);                                        \
+        }                                                                                          \
+                                                                                                   \
+        static void Register()                                                                     \
         {                                                                                          \
             ns3::TypeId tid = type<param>::GetTypeId();                                            \
             tid.SetSize(sizeof(type<param>));                                                      \
@@ -124,6 +136,11 @@
     static struct Object##type##param1##param2##RegistrationClass                                  \
     {                                                                                              \
         Object##type##param1##param2##RegistrationClass()                                          \
+        {                                                                                          \
+            ns3::TypeId::AddRegistration(#type, &Register);                                        \
+        }                                                                                          \
+                                                                                                   \
+        static void Register()                                                                     \
         {                                                                                          \
             ns3::TypeId tid = type<param1, param2>::GetTypeId();                                   \
             tid.SetSize(sizeof(type<param1, param2>));                                             \
@@ -150,4 +150,32 @@ ObjectPtrContainerAccessor::HasSetter() const
     return false;
 }
 
+bool
+ObjectPtrContainerAccessor::GetN(const ObjectBase* object, std::size_t* n) const
+{
+    NS_LOG_FUNCTION(this << object << n);
+    return DoGetN(object, n);
+}
+
+Ptr<Object>
+ObjectPtrContainerAccessor::Get(const ObjectBase* object, std::size_t i, std::size_t* index) const
+{
+    NS_LOG_FUNCTION(this << object << i << index);
+    return DoGet(object, i, index);
+}
+
+bool
+ObjectPtrContainerAccessor::IsIndexedByPosition() const
+{
+    NS_LOG_FUNCTION(this);
+    return DoIsIndexedByPosition();
+}
+
+bool
+ObjectPtrContainerAccessor::DoIsIndexedByPosition() const
+{
+    NS_LOG_FUNCTION(this);
+    return false;
+}
+
 } // namespace ns3
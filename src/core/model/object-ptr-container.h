@@ -233,6 +233,32 @@ class ObjectPtrContainerAccessor : public AttributeAccessor
     bool HasGetter() const override;
     bool HasSetter() const override;
 
+    /**
+     * Get the number of instances in the container.
+     *
+     * \param [in] object The container object.
+     * \param [out] n The number of instances in the container.
+     * \returns true if the value could be obtained successfully.
+     */
+    bool GetN(const ObjectBase* object, std::size_t* n) const;
+    /**
+     * Get an instance from the container, identified by its position,
+     * without copying the whole container into an ObjectPtrContainerValue.
+     *
+     * \param [in] object The container object.
+     * \param [in] i The position of the instance, lower than the number of instances.
+     * \param [out] index The index of the instance.
+     * \returns The instance.
+     */
+    Ptr<Object> Get(const ObjectBase* object, std::size_t i, std::size_t* index) const;
+    /**
+     * Check if the index of every instance is its position in the container,
+     * as in a vector, so that an index can be looked up with Get() directly.
+     *
+     * \returns true if Get() always returns \pname{i} as the index.
+     */
+    bool IsIndexedByPosition() const;
+
   private:
     /**
      * Get the number of instances in the container.
@@ -253,6 +279,12 @@ class ObjectPtrContainerAccessor : public AttributeAccessor
     virtual Ptr<Object> DoGet(const ObjectBase* object,
                               std::size_t i,
                               std::size_t* index) const = 0;
+    /**
+     * Check if the index of every instance is its position in the container.
+     *
+     * \returns false, unless overridden.
+     */
+    virtual bool DoIsIndexedByPosition() const;
 };
 
 template <typename T, typename U, typename INDEX>
@@ -281,6 +313,11 @@ MakeObjectPtrContainerAccessor(Ptr<U> (T::*get)(INDEX) const, INDEX (T::*getN)()
             return (obj->*m_get)(i);
         }
 
+        bool DoIsIndexedByPosition() const override
+        {
+            return true;
+        }
+
         Ptr<U> (T::*m_get)(INDEX) const;
         INDEX (T::*m_getN)() const;
     }* spec = new MemberGetters();
@@ -24,6 +24,8 @@
 #include "object.h"
 #include "ptr.h"
 
+#include <iterator>
+
 /**
  * \file
  * \ingroup attribute_ObjectVector
@@ -93,21 +95,14 @@ MakeObjectVectorAccessor(U T::*memberVector)
                           std::size_t* index) const override
         {
             const T* obj = static_cast<const T*>(object);
-            typename U::const_iterator begin = (obj->*m_memberVector).begin();
-            typename U::const_iterator end = (obj->*m_memberVector).end();
-            std::size_t k = 0;
-            for (typename U::const_iterator j = begin; j != end; j++, k++)
-            {
-                if (k == i)
-                {
-                    *index = k;
-                    return *j;
-                    break;
-                }
-            }
-            NS_ASSERT(false);
-            // quiet compiler.
-            return nullptr;
+            NS_ASSERT(i < (obj->*m_memberVector).size());
+            *index = i;
+            return *std::next((obj->*m_memberVector).begin(), i);
+        }
+
+        bool DoIsIndexedByPosition() const override
+        {
+            return true;
         }
 
         U T::*m_memberVector;
@@ -96,11 +96,9 @@ Object::Object()
     : m_tid(Object::GetTypeId()),
       m_disposed(false),
       m_initialized(false),
-      m_aggregates((struct Aggregates*)std::malloc(sizeof(struct Aggregates))),
-      m_getObjectCount(0)
+      m_aggregates(AllocateAggregates(1))
 {
     NS_LOG_FUNCTION(this);
-    m_aggregates->n = 1;
     m_aggregates->buffer[0] = this;
 }
 
@@ -120,11 +118,14 @@ Object::~Object()
             m_aggregates->n--;
         }
     }
+    // the lookup table may point to this object
+    std::free(m_aggregates->index);
+    m_aggregates->index = nullptr;
     // finally, if all objects have been removed from the list,
     // delete the aggregate list
     if (m_aggregates->n == 0)
     {
-        std::free(m_aggregates);
+        FreeAggregates(m_aggregates);
     }
     m_aggregates = nullptr;
 }
@@ -133,10 +134,8 @@ Object::Object(const Object& o)
     : m_tid(o.m_tid),
       m_disposed(false),
       m_initialized(false),
-      m_aggregates((struct Aggregates*)std::malloc(sizeof(struct Aggregates))),
-      m_getObjectCount(0)
+      m_aggregates(AllocateAggregates(1))
 {
-    m_aggregates->n = 1;
     m_aggregates->buffer[0] = this;
 }
 
@@ -153,33 +152,93 @@ Object::DoGetObject(TypeId tid) const
     NS_LOG_FUNCTION(this << tid);
     NS_ASSERT(CheckLoose());
 
-    uint32_t n = m_aggregates->n;
+    if (m_aggregates->index == nullptr)
+    {
+        BuildIndex(m_aggregates);
+    }
+    uint16_t uid = tid.GetUid();
+    const struct AggregateIndexEntry* index = m_aggregates->index;
+    for (uint32_t i = uid & m_aggregates->mask;; i = (i + 1) & m_aggregates->mask)
+    {
+        if (index[i].uid == uid)
+        {
+            return index[i].object;
+        }
+        if (index[i].uid == 0)
+        {
+            return nullptr;
+        }
+    }
+}
+
+void
+Object::BuildIndex(struct Aggregates* aggregates)
+{
+    NS_LOG_FUNCTION(aggregates);
+    // Every Object is indexed under its TypeId and all the parents up
+    // to Object: count them to size the table at most half full.
     TypeId objectTid = Object::GetTypeId();
-    for (uint32_t i = 0; i < n; i++)
+    uint32_t count = 1;
+    for (uint32_t i = 0; i < aggregates->n; i++)
     {
-        Object* current = m_aggregates->buffer[i];
-        TypeId cur = current->GetInstanceTypeId();
-        while (cur != tid && cur != objectTid)
+        for (TypeId cur = aggregates->buffer[i]->GetInstanceTypeId(); cur != objectTid;
+             cur = cur.GetParent())
         {
-            cur = cur.GetParent();
+            count++;
+        }
+    }
+    uint32_t size = 8;
+    while (size < 2 * count)
+    {
+        size *= 2;
+    }
+    auto index = (struct AggregateIndexEntry*)std::calloc(size, sizeof(struct AggregateIndexEntry));
+    uint32_t mask = size - 1;
+
+    // The first Object of a TypeId in the list is the one found.
+    auto insert = [index, mask](uint16_t uid, Object* object) {
+        uint32_t i = uid & mask;
+        while (index[i].uid != 0 && index[i].uid != uid)
+        {
+            i = (i + 1) & mask;
         }
-        if (cur == tid)
+        if (index[i].uid == 0)
         {
-            // This is an attempt to 'cache' the result of this lookup.
-            // the idea is that if we perform a lookup for a TypeId on this object,
-            // we are likely to perform the same lookup later so, we make sure
-            // that the aggregate array is sorted by the number of accesses
-            // to each object.
-
-            // first, increment the access count
-            current->m_getObjectCount++;
-            // then, update the sort
-            UpdateSortedArray(m_aggregates, i);
-            // finally, return the match
-            return const_cast<Object*>(current);
+            index[i].uid = uid;
+            index[i].object = object;
         }
+    };
+    for (uint32_t i = 0; i < aggregates->n; i++)
+    {
+        Object* current = aggregates->buffer[i];
+        TypeId cur = current->GetInstanceTypeId();
+        while (cur != objectTid)
+        {
+            insert(cur.GetUid(), current);
+            cur = cur.GetParent();
+        }
+        insert(objectTid.GetUid(), current);
     }
-    return nullptr;
+    aggregates->mask = mask;
+    aggregates->index = index;
+}
+
+struct Object::Aggregates*
+Object::AllocateAggregates(uint32_t n)
+{
+    auto aggregates =
+        (struct Aggregates*)std::malloc(sizeof(struct Aggregates) + (n - 1) * sizeof(Object*));
+    aggregates->n = n;
+    aggregates->mask = 0;
+    aggregates->index = nullptr;
+    return aggregates;
+}
+
+void
+Object::FreeAggregates(struct Aggregates* aggregates)
+{
+    std::free(aggregates->index);
+    std::free(aggregates);
 }
 
 void
@@ -241,20 +300,6 @@ restart:
     }
 }
 
-void
-Object::UpdateSortedArray(struct Aggregates* aggregates, uint32_t j) const
-{
-    NS_LOG_FUNCTION(this << aggregates << j);
-    while (j > 0 &&
-           aggregates->buffer[j]->m_getObjectCount > aggregates->buffer[j - 1]->m_getObjectCount)
-    {
-        Object* tmp = aggregates->buffer[j - 1];
-        aggregates->buffer[j - 1] = aggregates->buffer[j];
-        aggregates->buffer[j] = tmp;
-        j--;
-    }
-}
-
 void
 Object::AggregateObject(Ptr<Object> o)
 {
@@ -267,9 +312,7 @@ Object::AggregateObject(Ptr<Object> o)
     Object* other = PeekPointer(o);
     // first create the new aggregate buffer.
     uint32_t total = m_aggregates->n + other->m_aggregates->n;
-    struct Aggregates* aggregates =
-        (struct Aggregates*)std::malloc(sizeof(struct Aggregates) + (total - 1) * sizeof(Object*));
-    aggregates->n = total;
+    struct Aggregates* aggregates = AllocateAggregates(total);
 
     // copy our buffer to the new buffer
     std::memcpy(&aggregates->buffer[0],
@@ -287,7 +330,6 @@ Object::AggregateObject(Ptr<Object> o)
                            "Multiple aggregation of objects of type "
                            << other->GetInstanceTypeId() << " on objects of type " << typeId);
         }
-        UpdateSortedArray(aggregates, m_aggregates->n + i);
     }
 
     // keep track of the old aggregate buffers for the iteration
@@ -320,8 +362,8 @@ Object::AggregateObject(Ptr<Object> o)
     }
 
     // Now that we are done with them, we can free our old aggregate buffers
-    std::free(a);
-    std::free(b);
+    FreeAggregates(a);
+    FreeAggregates(b);
 }
 
 /**
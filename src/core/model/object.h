@@ -331,6 +331,17 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
 
     /**@}*/
 
+    /**
+     * An entry of the lookup table of the aggregates.
+     */
+    struct AggregateIndexEntry
+    {
+        /** The TypeId uid, or 0 if the entry is empty. */
+        uint16_t uid;
+        /** The first aggregated Object of this TypeId or of a subclass. */
+        Object* object;
+    };
+
     /**
      * The list of Objects aggregated to this one.
      *
@@ -347,6 +358,14 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
     {
         /** The number of entries in \c buffer. */
         uint32_t n;
+        /** The size of \c index minus one; the size is a power of two. */
+        uint32_t mask;
+        /**
+         * Open addressing hash table of the Objects by TypeId uid,
+         * covering the TypeId of every Object and its parents up to
+         * Object.  Built by the first DoGetObject(), null until then.
+         */
+        struct AggregateIndexEntry* index;
         /** The array of Objects. */
         Object* buffer[1];
     };
@@ -399,12 +418,24 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
     void Construct(const AttributeConstructionList& attributes);
 
     /**
-     * Keep the list of aggregates in most-recently-used order
+     * Build the lookup table of the aggregates.
      *
      * \param [in,out] aggregates The list of aggregated Objects.
-     * \param [in] i The most recently used entry in the list.
      */
-    void UpdateSortedArray(struct Aggregates* aggregates, uint32_t i) const;
+    static void BuildIndex(struct Aggregates* aggregates);
+    /**
+     * Allocate a list of aggregated Objects, without lookup table.
+     *
+     * \param [in] n The number of Objects.
+     * \return The list.
+     */
+    static struct Aggregates* AllocateAggregates(uint32_t n);
+    /**
+     * Free a list of aggregated Objects and its lookup table.
+     *
+     * \param [in] aggregates The list.
+     */
+    static void FreeAggregates(struct Aggregates* aggregates);
     /**
      * Attempt to delete this Object.
      *
@@ -436,14 +467,6 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
      * so the size of the array is indirectly a reference count.
      */
     struct Aggregates* m_aggregates;
-    /**
-     * The number of times the Object was accessed with a
-     * call to GetObject().
-     *
-     * This integer is used to implement a heuristic to sort
-     * the array of aggregates in most-frequently accessed order.
-     */
-    uint32_t m_getObjectCount;
 };
 
 template <typename T>
@@ -470,20 +493,14 @@ template <typename T>
 Ptr<T>
 Object::GetObject() const
 {
-    // This is an optimization: if the cast works (which is likely),
-    // things will be pretty fast.
-    T* result = dynamic_cast<T*>(m_aggregates->buffer[0]);
-    if (result != nullptr)
-    {
-        return Ptr<T>(result);
-    }
-    // if the cast does not work, we try to do a full type check.
     Ptr<Object> found = DoGetObject(T::GetTypeId());
     if (found)
     {
         return Ptr<T>(static_cast<T*>(PeekPointer(found)));
     }
-    return nullptr;
+    // The TypeId lookup fails for the subclasses which do not
+    // register their own TypeId: fall back to the C++ type system.
+    return Ptr<T>(dynamic_cast<T*>(m_aggregates->buffer[0]));
 }
 
 /**
@@ -0,0 +1,236 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "parameter-sweep.h"
+
+#include "config.h"
+#include "fatal-error.h"
+#include "log.h"
+#include "simulator.h"
+#include "string.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <poll.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::ParameterSweep implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ParameterSweep");
+
+ParameterSweep::ParameterSweep()
+    : m_checkpoint(Seconds(0)),
+      m_stop(Seconds(0)),
+      m_maxProcesses(std::max(1U, std::thread::hardware_concurrency()))
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ParameterSweep::SetCheckpoint(Time checkpoint)
+{
+    NS_LOG_FUNCTION(this << checkpoint);
+    m_checkpoint = checkpoint;
+}
+
+void
+ParameterSweep::SetStopTime(Time stop)
+{
+    NS_LOG_FUNCTION(this << stop);
+    m_stop = stop;
+}
+
+void
+ParameterSweep::SetMaxProcesses(uint32_t n)
+{
+    NS_LOG_FUNCTION(this << n);
+    NS_ABORT_MSG_IF(n == 0, "At least one process is needed");
+    m_maxProcesses = n;
+}
+
+void
+ParameterSweep::AddRun(const std::vector<Override>& overrides)
+{
+    NS_LOG_FUNCTION(this << overrides.size());
+    m_runs.push_back(overrides);
+}
+
+std::size_t
+ParameterSweep::GetNRuns() const
+{
+    return m_runs.size();
+}
+
+std::vector<ParameterSweep::Result>
+ParameterSweep::Run(Callback<std::string> result)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(!m_stop.IsZero() && m_stop < m_checkpoint,
+                    "The stop time " << m_stop << " is before the checkpoint " << m_checkpoint);
+
+    if (Simulator::Now() < m_checkpoint)
+    {
+        Simulator::Stop(m_checkpoint - Simulator::Now());
+        Simulator::Run();
+    }
+    NS_LOG_INFO("Warm-up done at " << Simulator::Now() << ", forking " << m_runs.size()
+                                   << " runs");
+
+    // Whatever is still buffered would otherwise be written again by
+    // every child.
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+
+    /** A running child process. */
+    struct Child
+    {
+        std::size_t run; //!< The index of the run.
+        pid_t pid;       //!< The process id.
+        int fd;          //!< The read end of the result pipe.
+    };
+
+    std::vector<Result> results(m_runs.size());
+    std::vector<Child> children;
+    std::size_t next = 0;
+    while (next < m_runs.size() || !children.empty())
+    {
+        while (next < m_runs.size() && children.size() < m_maxProcesses)
+        {
+            int fds[2];
+            if (pipe(fds) != 0)
+            {
+                NS_FATAL_ERROR("pipe() failed: " << std::strerror(errno));
+            }
+            pid_t pid = fork();
+            if (pid < 0)
+            {
+                NS_FATAL_ERROR("fork() failed: " << std::strerror(errno));
+            }
+            if (pid == 0)
+            {
+                close(fds[0]);
+                for (const auto& child : children)
+                {
+                    close(child.fd);
+                }
+                RunChild(next, result, fds[1]);
+            }
+            close(fds[1]);
+            NS_LOG_LOGIC("Run " << next << " started in process " << pid);
+            results[next].overrides = m_runs[next];
+            results[next].ok = false;
+            results[next].status = 0;
+            children.push_back({next, pid, fds[0]});
+            next++;
+        }
+
+        std::vector<struct pollfd> polls;
+        for (const auto& child : children)
+        {
+            polls.push_back({child.fd, POLLIN, 0});
+        }
+        if (poll(polls.data(), polls.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            NS_FATAL_ERROR("poll() failed: " << std::strerror(errno));
+        }
+        for (std::size_t i = polls.size(); i-- > 0;)
+        {
+            if (polls[i].revents == 0)
+            {
+                continue;
+            }
+            Child child = children[i];
+            char buffer[4096];
+            ssize_t n = read(child.fd, buffer, sizeof(buffer));
+            if (n > 0)
+            {
+                results[child.run].output.append(buffer, n);
+                continue;
+            }
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            // End of file: the child is done.
+            close(child.fd);
+            int status = 0;
+            while (waitpid(child.pid, &status, 0) < 0 && errno == EINTR)
+            {
+            }
+            results[child.run].status = status;
+            results[child.run].ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+            NS_LOG_LOGIC("Run " << child.run << " done, status " << status);
+            children.erase(children.begin() + i);
+        }
+    }
+    return results;
+}
+
+void
+ParameterSweep::RunChild(std::size_t run, Callback<std::string> result, int fd) const
+{
+    NS_LOG_FUNCTION(this << run << fd);
+    for (const auto& o : m_runs[run])
+    {
+        Config::Set(o.first, StringValue(o.second));
+    }
+    if (!m_stop.IsZero())
+    {
+        Simulator::Stop(m_stop - Simulator::Now());
+    }
+    Simulator::Run();
+
+    std::string output = result.IsNull() ? std::string() : result();
+    std::size_t written = 0;
+    while (written < output.size())
+    {
+        ssize_t n = write(fd, output.data() + written, output.size() - written);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n < 0)
+        {
+            std::_Exit(1);
+        }
+        written += n;
+    }
+    close(fd);
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+    // Skip the destructors and exit handlers, which belong to the parent.
+    std::_Exit(0);
+}
+
+} // namespace ns3
@@ -0,0 +1,153 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include "callback.h"
+#include "nstime.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::ParameterSweep declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup simulator
+ *
+ * Run the measured phase of a simulation once per set of attribute
+ * values, starting every run from the same warm state.
+ *
+ * The simulation first runs up to a checkpoint time in the calling
+ * process, for the warm-up shared by all the runs: ARP, routing
+ * convergence, TCP slow start...  The process then forks one child
+ * process per run.  Each child inherits the state of the simulation at
+ * the checkpoint, copy-on-write, without any serialization of the
+ * models.  It applies the Config::Set overrides of its run, runs the
+ * simulation up to the stop time, and sends the string returned by the
+ * result callback back to the parent.  The wall clock time of a sweep
+ * is then the warm-up time plus the time of the measured phases, run
+ * in parallel.
+ *
+ * Example usage:
+ *
+ * \code
+ *     // Create your model and schedule its traffic.
+ *
+ *     ParameterSweep sweep;
+ *     sweep.SetCheckpoint(Seconds(30));
+ *     sweep.SetStopTime(Seconds(60));
+ *     for (std::string rate : {"1Mbps", "10Mbps", "100Mbps"})
+ *     {
+ *         sweep.AddRun({{"/NodeList/0/DeviceList/0/$ns3::PointToPointNetDevice/DataRate",
+ *                        rate}});
+ *     }
+ *     std::vector<ParameterSweep::Result> results = sweep.Run(MakeCallback(&GetThroughput));
+ *     Simulator::Destroy();
+ * \endcode
+ *
+ * After Run() returns, the simulation of the calling process is still
+ * at the checkpoint.
+ *
+ * Every child starts with the same random number generator state, so
+ * the random variables created before the checkpoint draw the same
+ * values in every run, unless the overrides change them.
+ *
+ * fork() only duplicates the calling thread, so this is only supported
+ * with the single-threaded simulator implementations, such as the
+ * default one.  It is only available on POSIX systems.
+ */
+class ParameterSweep
+{
+  public:
+    /** A Config path and the value, as a string, to set it to. */
+    typedef std::pair<std::string, std::string> Override;
+
+    /** The outcome of one run. */
+    struct Result
+    {
+        std::vector<Override> overrides; //!< The overrides of the run.
+        bool ok;                         //!< Whether the child process exited normally.
+        int status;                      //!< The status of the child process, from waitpid.
+        std::string output;              //!< The string returned by the result callback.
+    };
+
+    /** Constructor. */
+    ParameterSweep();
+
+    /**
+     * Set the end of the shared warm-up.
+     * \param [in] checkpoint The absolute simulation time of the checkpoint.
+     */
+    void SetCheckpoint(Time checkpoint);
+    /**
+     * Set the end of the measured phase of every run.
+     * \param [in] stop The absolute simulation time at which the runs stop,
+     *             or zero to run until there are no events left.
+     */
+    void SetStopTime(Time stop);
+    /**
+     * Set the number of child processes running at the same time.
+     * \param [in] n The number of processes, the number of hardware
+     *             threads by default.
+     */
+    void SetMaxProcesses(uint32_t n);
+    /**
+     * Add a run.
+     * \param [in] overrides The Config paths and values to set in the run.
+     */
+    void AddRun(const std::vector<Override>& overrides);
+    /**
+     * Get the number of runs.
+     * \returns The number of runs.
+     */
+    std::size_t GetNRuns() const;
+
+    /**
+     * Run the simulation up to the checkpoint, then every run from the
+     * checkpoint in a child process.
+     * \param [in] result The callback which summarizes the outcome of
+     *             a run, called in the child process at the stop time.
+     * \returns The results of the runs, in the order they were added.
+     */
+    std::vector<Result> Run(Callback<std::string> result);
+
+  private:
+    /**
+     * Apply the overrides of a run and run its measured phase.
+     * Called in the child process, which it terminates.
+     * \param [in] run The index of the run.
+     * \param [in] result The result callback.
+     * \param [in] fd The file descriptor to write the result to.
+     */
+    [[noreturn]] void RunChild(std::size_t run, Callback<std::string> result, int fd) const;
+
+    Time m_checkpoint;                         //!< The end of the warm-up.
+    Time m_stop;                               //!< The end of the runs.
+    uint32_t m_maxProcesses;                   //!< The maximum number of child processes.
+    std::vector<std::vector<Override>> m_runs; //!< The overrides of every run.
+};
+
+} // namespace ns3
+
+#endif /* PARAMETER_SWEEP_H */
@@ -30,6 +30,7 @@
 #include "synchronizer.h"
 #include "wall-clock-synchronizer.h"
 
+#include <algorithm>
 #include <cmath>
 #include <mutex>
 #include <thread>
@@ -85,6 +86,8 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
+    m_lateness.fill(0);
+    m_maxLateness = 0;
 
     m_main = std::this_thread::get_id();
 
@@ -102,6 +105,7 @@ void
 RealtimeSimulatorImpl::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    ProcessEventsWithContext();
     while (!m_events->IsEmpty())
     {
         Scheduler::Event next = m_events->RemoveNext();
@@ -224,6 +228,14 @@ RealtimeSimulatorImpl::ProcessOneEvent()
             //
             // tsNext is the simulation time of the next event we want to execute.
             //
+            //
+            // Reset the synchronizer before receiving the events scheduled from
+            // other threads: one pushed after ProcessEventsWithContext() will have
+            // signalled the synchronizer and will interrupt the wait below.
+            //
+            m_synchronizer->SetCondition(false);
+            ProcessEventsWithContext();
+
             tsNow = m_synchronizer->GetCurrentRealtime();
             tsNext = NextTs();
 
@@ -249,10 +261,9 @@ RealtimeSimulatorImpl::ProcessOneEvent()
             // We've figured out how long we need to delay in order to pace the
             // simulation time with the real time.  We're going to sleep, but need
             // to work with the synchronizer to make sure we're awakened if something
-            // external happens (like a packet is received).  This next line resets
-            // the synchronizer so that any future event will cause it to interrupt.
+            // external happens (like a packet is received).  The synchronizer was
+            // reset above so that any future event will cause it to interrupt.
             //
-            m_synchronizer->SetCondition(false);
         }
 
         //
@@ -357,11 +368,12 @@ RealtimeSimulatorImpl::ProcessOneEvent()
         // been asked to commit ritual suicide.
         //
         // We check the simulation time against the current real time to make this
-        // judgement.
+        // judgement.  The lateness of every event goes to the histogram.
         //
+        uint64_t tsFinal = m_synchronizer->GetCurrentRealtime();
+        RecordLateness(tsFinal > m_currentTs ? tsFinal - m_currentTs : 0);
         if (m_synchronizationMode == SYNC_HARD_LIMIT)
         {
-            uint64_t tsFinal = m_synchronizer->GetCurrentRealtime();
             uint64_t tsJitter;
 
             if (tsFinal >= m_currentTs)
@@ -400,7 +412,7 @@ RealtimeSimulatorImpl::IsFinished() const
     bool rc;
     {
         std::unique_lock lock{m_mutex};
-        rc = m_events->IsEmpty() || m_stop;
+        rc = (m_events->IsEmpty() && m_eventsWithContext.IsEmpty()) || m_stop;
     }
 
     return rc;
@@ -418,6 +430,25 @@ RealtimeSimulatorImpl::NextTs() const
     return ev.key.m_ts;
 }
 
+void
+RealtimeSimulatorImpl::ProcessEventsWithContext()
+{
+    m_eventsWithContext.Drain([this](const EventWithContext& event) {
+        Scheduler::Event ev;
+        ev.impl = event.event;
+        //
+        // The timestamp was taken from the real time clock by the other thread,
+        // possibly just before the main thread executed a later event.
+        //
+        ev.key.m_ts = std::max(event.timestamp, m_currentTs);
+        ev.key.m_context = event.context;
+        ev.key.m_uid = m_uid;
+        m_uid++;
+        m_unscheduledEvents++;
+        m_events->Insert(ev);
+    });
+}
+
 void
 RealtimeSimulatorImpl::Run()
 {
@@ -442,6 +473,7 @@ RealtimeSimulatorImpl::Run()
         {
             std::unique_lock lock{m_mutex};
 
+            ProcessEventsWithContext();
             if (!m_events->IsEmpty())
             {
                 process = true;
@@ -472,6 +504,7 @@ RealtimeSimulatorImpl::Run()
     {
         std::unique_lock lock{m_mutex};
 
+        ProcessEventsWithContext();
         NS_ASSERT_MSG(m_events->IsEmpty() == false || m_unscheduledEvents == 0,
                       "RealtimeSimulatorImpl::Run(): Empty queue and unprocessed events");
     }
@@ -542,6 +575,15 @@ RealtimeSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay,
 {
     NS_LOG_FUNCTION(this << context << delay << impl);
 
+    if (m_running && m_main != std::this_thread::get_id())
+    {
+        // Do not contend for the lock with the main thread.
+        uint64_t ts = m_synchronizer->GetCurrentRealtime() + delay.GetTimeStep();
+        m_eventsWithContext.Push({context, ts, impl});
+        m_synchronizer->Signal();
+        return;
+    }
+
     {
         std::unique_lock lock{m_mutex};
         uint64_t ts;
@@ -597,6 +639,14 @@ RealtimeSimulatorImpl::ScheduleRealtimeWithContext(uint32_t context,
 {
     NS_LOG_FUNCTION(this << context << time << impl);
 
+    if (m_running && m_main != std::this_thread::get_id())
+    {
+        uint64_t ts = m_synchronizer->GetCurrentRealtime() + time.GetTimeStep();
+        m_eventsWithContext.Push({context, ts, impl});
+        m_synchronizer->Signal();
+        return;
+    }
+
     {
         std::unique_lock lock{m_mutex};
 
@@ -625,6 +675,14 @@ void
 RealtimeSimulatorImpl::ScheduleRealtimeNowWithContext(uint32_t context, EventImpl* impl)
 {
     NS_LOG_FUNCTION(this << context << impl);
+
+    if (m_running && m_main != std::this_thread::get_id())
+    {
+        m_eventsWithContext.Push({context, m_synchronizer->GetCurrentRealtime(), impl});
+        m_synchronizer->Signal();
+        return;
+    }
+
     {
         std::unique_lock lock{m_mutex};
 
@@ -838,4 +896,60 @@ RealtimeSimulatorImpl::GetHardLimit() const
     return m_hardLimit;
 }
 
+void
+RealtimeSimulatorImpl::RecordLateness(uint64_t ts)
+{
+    uint64_t us = TimeStep(ts).GetMicroSeconds();
+    std::size_t bucket = 0;
+    while (us > 0 && bucket < LATENESS_BUCKETS - 1)
+    {
+        us >>= 1;
+        bucket++;
+    }
+    m_lateness[bucket]++;
+    m_maxLateness = std::max(m_maxLateness, ts);
+}
+
+std::vector<uint64_t>
+RealtimeSimulatorImpl::GetLatenessHistogram() const
+{
+    NS_LOG_FUNCTION(this);
+    std::unique_lock lock{m_mutex};
+    return std::vector<uint64_t>(m_lateness.begin(), m_lateness.end());
+}
+
+Time
+RealtimeSimulatorImpl::GetMaxLateness() const
+{
+    NS_LOG_FUNCTION(this);
+    std::unique_lock lock{m_mutex};
+    return TimeStep(m_maxLateness);
+}
+
+void
+RealtimeSimulatorImpl::PrintLatenessHistogram(std::ostream& os) const
+{
+    NS_LOG_FUNCTION(this << &os);
+    std::vector<uint64_t> histogram = GetLatenessHistogram();
+    for (std::size_t i = 0; i < histogram.size(); i++)
+    {
+        if (histogram[i] == 0)
+        {
+            continue;
+        }
+        uint64_t low = (i == 0) ? 0 : uint64_t(1) << (i - 1);
+        os << "[" << low << " us, ";
+        if (i == histogram.size() - 1)
+        {
+            os << "inf)";
+        }
+        else
+        {
+            os << (uint64_t(1) << i) << " us)";
+        }
+        os << ": " << histogram[i] << std::endl;
+    }
+    os << "max: " << GetMaxLateness().As(Time::US) << std::endl;
+}
+
 } // namespace ns3
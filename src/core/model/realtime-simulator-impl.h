@@ -21,14 +21,19 @@
 #include "assert.h"
 #include "event-impl.h"
 #include "log.h"
+#include "mpsc-queue.h"
 #include "ptr.h"
 #include "scheduler.h"
 #include "simulator-impl.h"
 #include "synchronizer.h"
 
+#include <array>
+#include <atomic>
 #include <list>
 #include <mutex>
+#include <ostream>
 #include <thread>
+#include <vector>
 
 /**
  * \file
@@ -163,6 +168,33 @@ class RealtimeSimulatorImpl : public SimulatorImpl
      */
     Time GetHardLimit() const;
 
+    /** Number of buckets of the lateness histogram. */
+    static constexpr std::size_t LATENESS_BUCKETS = 24;
+
+    /**
+     * Get the histogram of the lateness of the events: the real time
+     * elapsed between the timestamp of an event and the start of its
+     * execution.
+     *
+     * Bucket 0 counts the events which started less than 1 us late,
+     * bucket \c i those which started between 2<sup>i-1</sup> and
+     * 2<sup>i</sup> us late, and the last bucket all the later ones.
+     *
+     * \returns The number of events in every bucket, since the creation
+     *     of the simulator.
+     */
+    std::vector<uint64_t> GetLatenessHistogram() const;
+    /**
+     * Get the largest lateness of an event.
+     * \returns The largest lateness, since the creation of the simulator.
+     */
+    Time GetMaxLateness() const;
+    /**
+     * Print the non-empty buckets of the lateness histogram.
+     * \param [in,out] os The output stream.
+     */
+    void PrintLatenessHistogram(std::ostream& os) const;
+
   private:
     /**
      * Is the simulator running?
@@ -181,6 +213,17 @@ class RealtimeSimulatorImpl : public SimulatorImpl
     uint64_t NextTs() const;
     /** Process the next event. */
     void ProcessOneEvent();
+    /**
+     * Add the lateness of an event to the histogram.
+     * Should be called with #m_mutex locked.
+     * \param [in] ts The lateness, in time steps.
+     */
+    void RecordLateness(uint64_t ts);
+    /**
+     * Move the events scheduled from other threads into the event list.
+     * Should be called with #m_mutex locked.
+     */
+    void ProcessEventsWithContext();
     /** Destructor implementation. */
     void DoDispose() override;
 
@@ -191,7 +234,24 @@ class RealtimeSimulatorImpl : public SimulatorImpl
     /** Has the stopping condition been reached? */
     bool m_stop;
     /** Is the simulator currently running. */
-    bool m_running;
+    std::atomic<bool> m_running;
+
+    /** Wrap an event scheduled from another thread with its execution context. */
+    struct EventWithContext
+    {
+        /** The event context. */
+        uint32_t context;
+        /** Absolute event timestamp. */
+        uint64_t timestamp;
+        /** The event implementation. */
+        EventImpl* event;
+    };
+
+    /**
+     * The events scheduled from other threads while the simulator is
+     * running, waiting to be moved to the event list.
+     */
+    MpscQueue<EventWithContext> m_eventsWithContext;
 
     /**
      * \name Mutex-protected variables.
@@ -213,6 +273,10 @@ class RealtimeSimulatorImpl : public SimulatorImpl
     uint32_t m_currentContext;
     /** The event count. */
     uint64_t m_eventCount;
+    /** The lateness histogram. */
+    std::array<uint64_t, LATENESS_BUCKETS> m_lateness;
+    /** The largest lateness, in time steps. */
+    uint64_t m_maxLateness;
     /**@}*/
 
     /** Mutex to control access to key state. */
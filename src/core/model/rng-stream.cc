@@ -24,6 +24,7 @@
 #include "fatal-error.h"
 #include "log.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 
@@ -340,42 +341,73 @@ using namespace MRG32k3a;
 double
 RngStream::RandU01()
 {
-    int32_t k;
-    double p1;
-    double p2;
-    double u;
-
-    /* Component 1 */
-    p1 = a12 * m_currentState[1] - a13n * m_currentState[0];
-    k = static_cast<int32_t>(p1 / m1);
-    p1 -= k * m1;
-    if (p1 < 0.0)
+    if (m_next == BLOCK_SIZE)
     {
-        p1 += m1;
+        Generate(m_buffer, BLOCK_SIZE);
+        m_next = 0;
     }
-    m_currentState[0] = m_currentState[1];
-    m_currentState[1] = m_currentState[2];
-    m_currentState[2] = p1;
-
-    /* Component 2 */
-    p2 = a21 * m_currentState[5] - a23n * m_currentState[3];
-    k = static_cast<int32_t>(p2 / m2);
-    p2 -= k * m2;
-    if (p2 < 0.0)
+    return m_buffer[m_next++];
+}
+
+void
+RngStream::RandU01(double* u, std::size_t n)
+{
+    std::size_t buffered = std::min<std::size_t>(n, BLOCK_SIZE - m_next);
+    std::copy(m_buffer + m_next, m_buffer + m_next + buffered, u);
+    m_next += buffered;
+    Generate(u + buffered, n - buffered);
+}
+
+void
+RngStream::Generate(double* u, std::size_t n)
+{
+    // The state values are integers lower than 2^32, and the sums of their
+    // products by the multipliers below are lower than 2^54.  Work on a
+    // local copy of the state in 64-bit integers: the remainders by the
+    // constant moduli compile to multiplications instead of divisions, and
+    // the results are exactly the same as with the double arithmetic.
+    const uint64_t im1 = static_cast<uint64_t>(m1);
+    const uint64_t im2 = static_cast<uint64_t>(m2);
+    const uint64_t ia12 = static_cast<uint64_t>(a12);
+    const uint64_t ia13n = static_cast<uint64_t>(a13n);
+    const uint64_t ia21 = static_cast<uint64_t>(a21);
+    const uint64_t ia23n = static_cast<uint64_t>(a23n);
+
+    uint64_t x10 = static_cast<uint64_t>(m_currentState[0]);
+    uint64_t x11 = static_cast<uint64_t>(m_currentState[1]);
+    uint64_t x12 = static_cast<uint64_t>(m_currentState[2]);
+    uint64_t x20 = static_cast<uint64_t>(m_currentState[3]);
+    uint64_t x21 = static_cast<uint64_t>(m_currentState[4]);
+    uint64_t x22 = static_cast<uint64_t>(m_currentState[5]);
+
+    for (std::size_t i = 0; i < n; ++i)
     {
-        p2 += m2;
+        // a * x - b * y MOD m, computed as a * x + b * (m - y) MOD m
+        // to stay positive.
+        uint64_t p1 = (ia12 * x11 + ia13n * (im1 - x10)) % im1;
+        x10 = x11;
+        x11 = x12;
+        x12 = p1;
+
+        uint64_t p2 = (ia21 * x22 + ia23n * (im2 - x20)) % im2;
+        x20 = x21;
+        x21 = x22;
+        x22 = p2;
+
+        int64_t d = static_cast<int64_t>(p1) - static_cast<int64_t>(p2);
+        u[i] = static_cast<double>(d > 0 ? d : d + static_cast<int64_t>(im1)) * norm;
     }
-    m_currentState[3] = m_currentState[4];
-    m_currentState[4] = m_currentState[5];
-    m_currentState[5] = p2;
-
-    /* Combination */
-    u = ((p1 > p2) ? (p1 - p2) * norm : (p1 - p2 + m1) * norm);
 
-    return u;
+    m_currentState[0] = static_cast<double>(x10);
+    m_currentState[1] = static_cast<double>(x11);
+    m_currentState[2] = static_cast<double>(x12);
+    m_currentState[3] = static_cast<double>(x20);
+    m_currentState[4] = static_cast<double>(x21);
+    m_currentState[5] = static_cast<double>(x22);
 }
 
 RngStream::RngStream(uint32_t seedNumber, uint64_t stream, uint64_t substream)
+    : m_next(BLOCK_SIZE)
 {
     if (seedNumber >= m1 || seedNumber >= m2 || seedNumber == 0)
     {
@@ -390,11 +422,13 @@ RngStream::RngStream(uint32_t seedNumber, uint64_t stream, uint64_t substream)
 }
 
 RngStream::RngStream(const RngStream& r)
+    : m_next(r.m_next)
 {
     for (int i = 0; i < 6; ++i)
     {
         m_currentState[i] = r.m_currentState[i];
     }
+    std::copy(r.m_buffer, r.m_buffer + BLOCK_SIZE, m_buffer);
 }
 
 void
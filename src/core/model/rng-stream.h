@@ -18,6 +18,7 @@
 
 #ifndef RNGSTREAM_H
 #define RNGSTREAM_H
+#include <cstddef>
 #include <stdint.h>
 #include <string>
 
@@ -67,11 +68,34 @@ class RngStream
      * Generate the next random number for this stream.
      * Uniformly distributed between 0 and 1.
      *
+     * The randoms are generated by blocks of BLOCK_SIZE, and returned
+     * one at a time.  The sequence is the same as if they were generated
+     * one at a time.
+     *
      * \returns The next random.
      */
     double RandU01();
+    /**
+     * Generate the next \pname{n} random numbers for this stream.
+     * Uniformly distributed between 0 and 1.
+     *
+     * This is equivalent to \pname{n} calls to RandU01(), in order.
+     *
+     * \param [out] u The array to fill with the randoms.
+     * \param [in] n The number of randoms.
+     */
+    void RandU01(double* u, std::size_t n);
 
   private:
+    /**
+     * Generate the next \pname{n} random numbers of the generator,
+     * bypassing the buffer.
+     *
+     * \param [out] u The array to fill with the randoms.
+     * \param [in] n The number of randoms.
+     */
+    void Generate(double* u, std::size_t n);
+
     /**
      * Advance \pname{state} of the RNG by leaps and bounds.
      *
@@ -81,8 +105,15 @@ class RngStream
      */
     void AdvanceNthBy(uint64_t nth, int by, double state[6]);
 
-    /** The RNG state vector. */
+    /** The number of randoms generated at once by RandU01(). */
+    static constexpr std::size_t BLOCK_SIZE = 16;
+
+    /** The RNG state vector, after the last generated random. */
     double m_currentState[6];
+    /** The randoms generated ahead of RandU01() calls. */
+    double m_buffer[BLOCK_SIZE];
+    /** The index of the next random to return from #m_buffer. */
+    std::size_t m_next;
 };
 
 } // namespace ns3
@@ -71,6 +71,9 @@ class EventImpl;
  * rely heavily on Scheduler::Cancel, however, and these might benefit
  * from using Scheduler::Remove instead, to reduce the size of the event
  * list, at the time cost of actually removing events from the list.
+ * DefaultSimulatorImpl can do this automatically, either on every
+ * Simulator::Cancel or by compacting the event list once a given fraction
+ * of it is cancelled; see its EagerCancel and CompactionThreshold attributes.
  *
  * A summary of the main characteristics
  * of each SchedulerImpl is provided below.  See the individual
@@ -26,10 +26,15 @@
 
 #include <cmath>
 #include <cstring>
+#include <iomanip>
 #include <list>
 #include <map>
 #include <vector>
 
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
 /**
  * \file
  * \ingroup testing
@@ -117,6 +122,18 @@ operator<<(std::ostream& os, const TestCaseFailure& failure)
     return os;
 }
 
+/**
+ * \ingroup testingimpl
+ * Container for a performance metric reported by a TestCase.
+ */
+struct TestCaseMetric
+{
+    std::string name;    /**< The name of the metric. */
+    double value;        /**< The value. */
+    std::string unit;    /**< The unit of the value. */
+    bool higherIsBetter; /**< \c true if a regression lowers the value. */
+};
+
 /**
  * \ingroup testingimpl
  * Container for results from a TestCase.
@@ -130,6 +147,8 @@ struct TestCase::Result
     SystemWallClockMs clock;
     /** TestCaseFailure records for each child. */
     std::vector<TestCaseFailure> failure;
+    /** The performance metrics reported by the test. */
+    std::vector<TestCaseMetric> metrics;
     /** \c true if any child TestCases failed. */
     bool childrenFailed;
 };
@@ -203,6 +222,13 @@ class TestRunnerImpl : public Singleton<TestRunnerImpl>
      * \returns The sanitized string.
      */
     std::string ReplaceXmlSpecialCharacters(std::string xml) const;
+    /**
+     * Quote a string for JSON.
+     *
+     * \param [in] text The raw string.
+     * \returns The quoted and escaped string.
+     */
+    std::string QuoteJson(const std::string& text) const;
     /**
      * Print the test report.
      *
@@ -212,6 +238,21 @@ class TestRunnerImpl : public Singleton<TestRunnerImpl>
      * \param [in] level Indentation level.
      */
     void PrintReport(TestCase* test, std::ostream* os, bool xml, int level);
+    /**
+     * Print the timing and the performance metrics of a test suite as JSON.
+     *
+     * \param [in] suite The TestSuite to print.
+     * \param [in,out] os The output stream.
+     */
+    void PrintJson(TestSuite* suite, std::ostream& os);
+    /**
+     * Print the performance metrics of a TestCase and its children as JSON.
+     *
+     * \param [in] test The TestCase to print.
+     * \param [in,out] os The output stream.
+     * \param [in,out] first \c true if no metric was printed yet.
+     */
+    void PrintJsonMetrics(TestCase* test, std::ostream& os, bool& first);
     /**
      * Print the list of all requested test suites.
      *
@@ -405,6 +446,13 @@ TestCase::ReportTestFailure(std::string cond,
     }
 }
 
+void
+TestCase::ReportMetric(std::string name, double value, std::string unit, bool higherIsBetter)
+{
+    NS_LOG_FUNCTION(this << name << value << unit << higherIsBetter);
+    m_result->metrics.push_back({name, value, unit, higherIsBetter});
+}
+
 bool
 TestCase::MustAssertOnFailure() const
 {
@@ -647,6 +695,44 @@ TestRunnerImpl::ReplaceXmlSpecialCharacters(std::string xml) const
     return result;
 }
 
+std::string
+TestRunnerImpl::QuoteJson(const std::string& text) const
+{
+    NS_LOG_FUNCTION(this << text);
+    std::ostringstream oss;
+    oss << '"';
+    for (char character : text)
+    {
+        switch (character)
+        {
+        case '"':
+            oss << "\\\"";
+            break;
+        case '\\':
+            oss << "\\\\";
+            break;
+        case '\n':
+            oss << "\\n";
+            break;
+        case '\t':
+            oss << "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(character) < 0x20)
+            {
+                oss << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                    << static_cast<int>(character) << std::dec << std::setfill(' ');
+            }
+            else
+            {
+                oss << character;
+            }
+        }
+    }
+    oss << '"';
+    return oss.str();
+}
+
 /** Helper to indent output a specified number of steps. */
 struct Indent
 {
@@ -754,6 +840,71 @@ TestRunnerImpl::PrintReport(TestCase* test, std::ostream* os, bool xml, int leve
     (*os).precision(oldPrecision);
 }
 
+void
+TestRunnerImpl::PrintJson(TestSuite* suite, std::ostream& os)
+{
+    NS_LOG_FUNCTION(this << suite << &os);
+    const double MS_PER_SEC = 1000.;
+    double real = suite->m_result->clock.GetElapsedReal() / MS_PER_SEC;
+    double user = suite->m_result->clock.GetElapsedUser() / MS_PER_SEC;
+    double system = suite->m_result->clock.GetElapsedSystem() / MS_PER_SEC;
+
+    // The peak resident set size of the whole test runner, which runs
+    // a single suite.
+    long peakRss = -1;
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        peakRss = usage.ru_maxrss;
+#ifdef __APPLE__
+        // In bytes rather than kilobytes
+        peakRss /= 1024;
+#endif
+    }
+#endif
+
+    std::streamsize oldPrecision = os.precision(3);
+    os << std::fixed;
+    os << "{" << std::endl
+       << "  \"suite\": " << QuoteJson(suite->GetName()) << "," << std::endl
+       << "  \"result\": \"" << (suite->IsFailed() ? "FAIL" : "PASS") << "\"," << std::endl
+       << "  \"time\": {\"real\": " << real << ", \"user\": " << user
+       << ", \"system\": " << system << "}," << std::endl
+       << "  \"peakRssKiB\": " << peakRss << "," << std::endl
+       << "  \"metrics\": [";
+    // Print the metrics without losing precision.
+    os.unsetf(std::ios_base::floatfield);
+    os.precision(17);
+    bool first = true;
+    PrintJsonMetrics(suite, os, first);
+    os << (first ? "" : "\n  ") << "]" << std::endl << "}";
+    os.precision(oldPrecision);
+}
+
+void
+TestRunnerImpl::PrintJsonMetrics(TestCase* test, std::ostream& os, bool& first)
+{
+    NS_LOG_FUNCTION(this << test << &os << first);
+    if (test->m_result == nullptr)
+    {
+        return;
+    }
+    for (const TestCaseMetric& metric : test->m_result->metrics)
+    {
+        os << (first ? "" : ",") << std::endl
+           << "    {\"test\": " << QuoteJson(test->GetName())
+           << ", \"name\": " << QuoteJson(metric.name) << ", \"value\": " << metric.value
+           << ", \"unit\": " << QuoteJson(metric.unit)
+           << ", \"higherIsBetter\": " << (metric.higherIsBetter ? "true" : "false") << "}";
+        first = false;
+    }
+    for (TestCase* child : test->m_children)
+    {
+        PrintJsonMetrics(child, os, first);
+    }
+}
+
 void
 TestRunnerImpl::PrintHelp(const char* program_name) const
 {
@@ -789,7 +940,10 @@ TestRunnerImpl::PrintHelp(const char* program_name) const
         << "  --out=FILE             : send test result to FILE instead of standard "
         << "output" << std::endl
         << "  --append=FILE          : append test result to FILE instead of standard "
-        << "output" << std::endl;
+        << "output" << std::endl
+        << "  --json=FILE            : write the timing and the performance metrics of "
+        << std::endl
+        << "                           the test suites to FILE, as a JSON array" << std::endl;
 }
 
 void
@@ -893,6 +1047,7 @@ TestRunnerImpl::Run(int argc, char* argv[])
     std::string testTypeString = "";
     std::string out = "";
     std::string fullness = "";
+    std::string json = "";
     bool xml = false;
     bool append = false;
     bool printTempDir = false;
@@ -974,6 +1129,10 @@ TestRunnerImpl::Run(int argc, char* argv[])
         {
             out = arg.substr(arg.find_first_of('=') + 1);
         }
+        else if (arg.find("--json=") != std::string::npos)
+        {
+            json = arg.substr(arg.find_first_of('=') + 1);
+        }
         else if (arg.find("--fullness=") != std::string::npos)
         {
             fullness = arg.substr(arg.find_first_of('=') + 1);
@@ -1081,6 +1240,14 @@ TestRunnerImpl::Run(int argc, char* argv[])
         os = &std::cout;
     }
 
+    // The JSON of all the suites run, as one array.
+    std::ofstream jsonStream;
+    if (!json.empty())
+    {
+        jsonStream.open(json, std::ios_base::out | std::ios_base::trunc);
+        jsonStream << "[";
+    }
+
     // let's run our tests now.
     bool failed = false;
     if (tests.empty())
@@ -1124,16 +1291,25 @@ TestRunnerImpl::Run(int argc, char* argv[])
 
         test->Run(this);
         PrintReport(test, os, xml, 0);
+        if (jsonStream.is_open())
+        {
+            jsonStream << (i == tests.begin() ? "" : ",") << std::endl;
+            PrintJson(dynamic_cast<TestSuite*>(test), jsonStream);
+        }
         if (test->IsFailed())
         {
             failed = true;
             if (!m_continueOnFailure)
             {
-                return 1;
+                break;
             }
         }
     }
 
+    if (jsonStream.is_open())
+    {
+        jsonStream << std::endl << "]" << std::endl;
+    }
     if (!out.empty())
     {
         delete os;
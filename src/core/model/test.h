@@ -1136,6 +1136,20 @@ class TestCase
      */
     TestCase* GetParent() const;
 
+    /**
+     * \brief Report a performance metric of this TestCase.
+     *
+     * The metrics are written, with the peak resident set size of the
+     * test runner, by the \c --json=FILE option of the test runner.
+     * \c test.py compares them to a baseline with \c --baseline=FILE.
+     *
+     * \param [in] name The name of the metric, unique in this TestCase.
+     * \param [in] value The value of the metric.
+     * \param [in] unit The unit of the value, e.g. "events/s".
+     * \param [in] higherIsBetter \c true if a regression lowers the value.
+     */
+    void ReportMetric(std::string name, double value, std::string unit, bool higherIsBetter = true);
+
     /**
      * \name Internal Interface
      * These methods are the interface used by test macros and should not
@@ -289,6 +289,7 @@ Time::SetResolution(Unit unit, Resolution* resolution, const bool convert /* = t
         }
     }
     resolution->unit = unit;
+    g_resolutionUnit = unit;
 }
 
 // static
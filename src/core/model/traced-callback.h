@@ -21,8 +21,10 @@
 #define TRACED_CALLBACK_H
 
 #include "callback.h"
+#include "ptr.h"
+#include "simple-ref-count.h"
 
-#include <list>
+#include <vector>
 
 /**
  * \file
@@ -47,6 +49,13 @@ namespace ns3
  * calling the \c operator() form with the appropriate
  * number of arguments.
  *
+ * The chain is stored contiguously in an immutable, reference
+ * counted array, which is replaced when a Callback is connected or
+ * disconnected.  A TracedCallback without any Callback holds a null
+ * pointer, so that invoking it costs a single branch; the Callbacks
+ * which are invoked stay alive even if the chain is modified by one
+ * of them.
+ *
  * \tparam Ts \explicit Types of the functor arguments.
  */
 template <typename... Ts>
@@ -113,9 +122,22 @@ class TracedCallback
      *
      * \tparam Ts \deduced Types of the functor arguments.
      */
-    typedef std::list<Callback<void, Ts...>> CallbackList;
-    /** The chain of Callbacks. */
-    CallbackList m_callbackList;
+    typedef std::vector<Callback<void, Ts...>> CallbackList;
+
+    /** The immutable chain of Callbacks. */
+    struct Chain : public SimpleRefCount<Chain>
+    {
+        CallbackList callbacks; //!< The Callbacks, in the order they are invoked.
+    };
+
+    /**
+     * Replace the chain of Callbacks.
+     * \param [in] callbacks The new Callbacks.
+     */
+    void SetCallbacks(CallbackList callbacks);
+
+    /** The chain of Callbacks, null if there is none. */
+    Ptr<const Chain> m_chain;
 };
 
 } // namespace ns3
@@ -129,7 +151,7 @@ namespace ns3
 
 template <typename... Ts>
 TracedCallback<Ts...>::TracedCallback()
-    : m_callbackList()
+    : m_chain()
 {
 }
 
@@ -142,7 +164,14 @@ TracedCallback<Ts...>::ConnectWithoutContext(const CallbackBase& callback)
     {
         NS_FATAL_ERROR_NO_MSG();
     }
-    m_callbackList.push_back(cb);
+    CallbackList callbacks;
+    if (m_chain)
+    {
+        callbacks.reserve(m_chain->callbacks.size() + 1);
+        callbacks = m_chain->callbacks;
+    }
+    callbacks.push_back(cb);
+    SetCallbacks(std::move(callbacks));
 }
 
 template <typename... Ts>
@@ -155,25 +184,29 @@ TracedCallback<Ts...>::Connect(const CallbackBase& callback, std::string path)
         NS_FATAL_ERROR("when connecting to " << path);
     }
     Callback<void, Ts...> realCb = cb.Bind(path);
-    m_callbackList.push_back(realCb);
+    ConnectWithoutContext(realCb);
 }
 
 template <typename... Ts>
 void
 TracedCallback<Ts...>::DisconnectWithoutContext(const CallbackBase& callback)
 {
-    for (typename CallbackList::iterator i = m_callbackList.begin(); i != m_callbackList.end();
-         /* empty */)
+    if (!m_chain)
     {
-        if ((*i).IsEqual(callback))
-        {
-            i = m_callbackList.erase(i);
-        }
-        else
+        return;
+    }
+    CallbackList callbacks;
+    for (const auto& cb : m_chain->callbacks)
+    {
+        if (!cb.IsEqual(callback))
         {
-            i++;
+            callbacks.push_back(cb);
         }
     }
+    if (callbacks.size() != m_chain->callbacks.size())
+    {
+        SetCallbacks(std::move(callbacks));
+    }
 }
 
 template <typename... Ts>
@@ -189,15 +222,40 @@ TracedCallback<Ts...>::Disconnect(const CallbackBase& callback, std::string path
     DisconnectWithoutContext(realCb);
 }
 
+template <typename... Ts>
+void
+TracedCallback<Ts...>::SetCallbacks(CallbackList callbacks)
+{
+    if (callbacks.empty())
+    {
+        m_chain = nullptr;
+        return;
+    }
+    Ptr<Chain> chain = Create<Chain>();
+    chain->callbacks = std::move(callbacks);
+    m_chain = chain;
+}
+
 template <typename... Ts>
 void
 TracedCallback<Ts...>::operator()(Ts... args) const
 {
-    for (typename CallbackList::const_iterator i = m_callbackList.begin();
-         i != m_callbackList.end();
-         i++)
+    if (!m_chain)
+    {
+        return;
+    }
+    // Keep the chain alive while the Callbacks run, in case one of
+    // them connects or disconnects a Callback.
+    Ptr<const Chain> chain = m_chain;
+    const CallbackList& callbacks = chain->callbacks;
+    if (callbacks.size() == 1)
+    {
+        callbacks.front()(args...);
+        return;
+    }
+    for (const auto& cb : callbacks)
     {
-        (*i)(args...);
+        cb(args...);
     }
 }
 
@@ -205,7 +263,7 @@ template <typename... Ts>
 bool
 TracedCallback<Ts...>::IsEmpty() const
 {
-    return m_callbackList.empty();
+    return !m_chain;
 }
 
 } // namespace ns3
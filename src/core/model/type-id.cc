@@ -24,8 +24,8 @@
 #include "trace-source-accessor.h"
 
 #include <iomanip>
-#include <map>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 /**
@@ -51,7 +51,11 @@ NS_LOG_COMPONENT_DEFINE("TypeId");
  * \brief TypeId information manager
  *
  * Information records are stored in a vector.  Name and hash lookup
- * are performed by maps to the vector index.
+ * are performed by hash tables of the vector index.
+ *
+ * The types are registered on demand: the lookups by name and hash
+ * run the pending registrations added by TypeId::AddRegistration()
+ * before they fail, and so does the enumeration of the types.
  *
  * \internal
  * <b>Hash Chaining</b>
@@ -114,17 +118,23 @@ class IidManager : public Singleton<IidManager>
      */
     void HideFromDocumentation(uint16_t uid);
     /**
-     * Get a type id by name.
+     * Add a function which registers a type on demand.
+     * \param [in] hint The name of the class, without its namespaces.
+     * \param [in] registration The function which registers the type.
+     */
+    void AddRegistration(const std::string& hint, TypeId::Registration registration);
+    /**
+     * Get a type id by name, running the pending registrations if needed.
      * \param [in] name The type id to find.
      * \returns The type id.  A type id of 0 means \pname{name} wasn't found.
      */
-    uint16_t GetUid(std::string name) const;
+    uint16_t GetUid(const std::string& name);
     /**
-     * Get a type id by hash value.
+     * Get a type id by hash value, running the pending registrations if needed.
      * \param [in] hash The type id to find.
      * \returns The type id.  A type id of 0 means \pname{hash} wasn't found.
      */
-    uint16_t GetUid(TypeId::hash_t hash) const;
+    uint16_t GetUid(TypeId::hash_t hash);
     /**
      * Get the name of a type id.
      * \param [in] uid The id.
@@ -150,11 +160,11 @@ class IidManager : public Singleton<IidManager>
      */
     std::string GetGroupName(uint16_t uid) const;
     /**
-     * Get the size of a type id.
+     * Get the size of a type id, running its pending registration if needed.
      * \param [in] uid The id.
      * \returns The size of the type id.
      */
-    std::size_t GetSize(uint16_t uid) const;
+    std::size_t GetSize(uint16_t uid);
     /**
      * Get the constructor Callback of a type id.
      * \param [in] uid The id.
@@ -168,10 +178,11 @@ class IidManager : public Singleton<IidManager>
      */
     bool HasConstructor(uint16_t uid) const;
     /**
-     * Get the total number of type ids.
+     * Get the total number of type ids, after running all the pending
+     * registrations.
      * \returns The total number.
      */
-    uint16_t GetRegisteredN() const;
+    uint16_t GetRegisteredN();
     /**
      * Get a type id by index.
      *
@@ -271,6 +282,25 @@ class IidManager : public Singleton<IidManager>
     bool MustHideFromDocumentation(uint16_t uid) const;
 
   private:
+    /**
+     * Find a type id by name, without running the pending registrations.
+     * \param [in] name The type id to find.
+     * \returns The type id, or 0.
+     */
+    uint16_t FindUid(const std::string& name) const;
+    /**
+     * Find a type id by hash value, without running the pending registrations.
+     * \param [in] hash The type id to find.
+     * \returns The type id, or 0.
+     */
+    uint16_t FindUid(TypeId::hash_t hash) const;
+    /**
+     * Run the pending registrations of the classes named like a type id.
+     * \param [in] name The type id name.
+     */
+    void Register(const std::string& name);
+    /** Run all the pending registrations. */
+    void RegisterAll();
     /**
      * Check if a type id has a given TraceSource.
      * \param [in] uid The id.
@@ -334,15 +364,18 @@ class IidManager : public Singleton<IidManager>
     std::vector<struct IidInformation> m_information;
 
     /** Type of the by-name index. */
-    typedef std::map<std::string, uint16_t> namemap_t;
+    typedef std::unordered_map<std::string, uint16_t> namemap_t;
     /** The by-name index. */
     namemap_t m_namemap;
 
     /** Type of the by-hash index. */
-    typedef std::map<TypeId::hash_t, uint16_t> hashmap_t;
+    typedef std::unordered_map<TypeId::hash_t, uint16_t> hashmap_t;
     /** The by-hash index. */
     hashmap_t m_hashmap;
 
+    /** The pending registrations, by class name. */
+    std::unordered_multimap<std::string, TypeId::Registration> m_registrations;
+
     /** IidManager constants. */
     enum
     {
@@ -413,7 +446,7 @@ IidManager::AllocateUid(std::string name)
         // into ns3.  -- Peter Barnes, LLNL
 
         // Alphabetize the two types, so it's deterministic
-        struct IidInformation* hinfo = LookupInformation(GetUid(hash));
+        struct IidInformation* hinfo = LookupInformation(FindUid(hash));
         if (name > hinfo->name)
         { // new type gets chained
             NS_LOG_LOGIC(IIDL << "New TypeId '" << name << "' getting chained.");
@@ -422,7 +455,7 @@ IidManager::AllocateUid(std::string name)
         else
         { // chain old type
             NS_LOG_LOGIC(IIDL << "Old TypeId '" << hinfo->name << "' getting chained.");
-            uint16_t oldUid = GetUid(hinfo->hash);
+            uint16_t oldUid = FindUid(hinfo->hash);
             m_hashmap.erase(m_hashmap.find(hinfo->hash));
             hinfo->hash = hash | HashChainFlag;
             m_hashmap.insert(std::make_pair(hinfo->hash, oldUid));
@@ -506,8 +539,85 @@ IidManager::AddConstructor(uint16_t uid, Callback<ObjectBase*> callback)
     information->constructor = callback;
 }
 
+void
+IidManager::AddRegistration(const std::string& hint, TypeId::Registration registration)
+{
+    NS_LOG_FUNCTION(IID << hint);
+    m_registrations.emplace(hint, registration);
+}
+
+void
+IidManager::Register(const std::string& name)
+{
+    NS_LOG_FUNCTION(IID << name);
+    // "ns3::Queue<ns3::Packet>" is registered by the class "Queue".
+    std::string hint = name.substr(0, name.find('<'));
+    std::size_t scope = hint.rfind("::");
+    if (scope != std::string::npos)
+    {
+        hint = hint.substr(scope + 2);
+    }
+    // The registrations may look up other types, and run other
+    // registrations: remove them before running them.
+    auto range = m_registrations.equal_range(hint);
+    std::vector<TypeId::Registration> registrations;
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        registrations.push_back(it->second);
+    }
+    m_registrations.erase(range.first, range.second);
+    for (auto registration : registrations)
+    {
+        registration();
+    }
+}
+
+void
+IidManager::RegisterAll()
+{
+    NS_LOG_FUNCTION(IID << m_registrations.size());
+    while (!m_registrations.empty())
+    {
+        auto it = m_registrations.begin();
+        TypeId::Registration registration = it->second;
+        m_registrations.erase(it);
+        registration();
+    }
+}
+
 uint16_t
-IidManager::GetUid(std::string name) const
+IidManager::GetUid(const std::string& name)
+{
+    NS_LOG_FUNCTION(IID << name);
+    uint16_t uid = FindUid(name);
+    if (uid == 0 && !m_registrations.empty())
+    {
+        Register(name);
+        uid = FindUid(name);
+        if (uid == 0)
+        {
+            RegisterAll();
+            uid = FindUid(name);
+        }
+    }
+    return uid;
+}
+
+uint16_t
+IidManager::GetUid(TypeId::hash_t hash)
+{
+    NS_LOG_FUNCTION(IID << hash);
+    uint16_t uid = FindUid(hash);
+    if (uid == 0 && !m_registrations.empty())
+    {
+        RegisterAll();
+        uid = FindUid(hash);
+    }
+    return uid;
+}
+
+uint16_t
+IidManager::FindUid(const std::string& name) const
 {
     NS_LOG_FUNCTION(IID << name);
     uint16_t uid = 0;
@@ -521,7 +631,7 @@ IidManager::GetUid(std::string name) const
 }
 
 uint16_t
-IidManager::GetUid(TypeId::hash_t hash) const
+IidManager::FindUid(TypeId::hash_t hash) const
 {
     NS_LOG_FUNCTION(IID << hash);
     hashmap_t::const_iterator it = m_hashmap.find(hash);
@@ -573,10 +683,16 @@ IidManager::GetGroupName(uint16_t uid) const
 }
 
 std::size_t
-IidManager::GetSize(uint16_t uid) const
+IidManager::GetSize(uint16_t uid)
 {
     NS_LOG_FUNCTION(IID << uid);
     struct IidInformation* information = LookupInformation(uid);
+    if (information->size == (std::size_t)(-1) && !m_registrations.empty())
+    {
+        // The type was used before its registration set the size.
+        Register(information->name);
+        information = LookupInformation(uid);
+    }
     std::size_t size = information->size;
     NS_LOG_LOGIC(IIDL << size);
     return size;
@@ -606,9 +722,10 @@ IidManager::HasConstructor(uint16_t uid) const
 }
 
 uint16_t
-IidManager::GetRegisteredN() const
+IidManager::GetRegisteredN()
 {
     NS_LOG_FUNCTION(IID << m_information.size());
+    RegisterAll();
     return static_cast<uint16_t>(m_information.size());
 }
 
@@ -893,6 +1010,13 @@ TypeId::GetRegistered(uint16_t i)
     return TypeId(IidManager::Get()->GetRegistered(i));
 }
 
+void
+TypeId::AddRegistration(const std::string& hint, Registration registration)
+{
+    NS_LOG_FUNCTION(hint);
+    IidManager::Get()->AddRegistration(hint, registration);
+}
+
 bool
 TypeId::LookupAttributeByName(std::string name, struct TypeId::AttributeInformation* info) const
 {
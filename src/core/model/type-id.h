@@ -173,6 +173,27 @@ class TypeId
      */
     static TypeId GetRegistered(uint16_t i);
 
+    /** Type of the functions which register a type on demand. */
+    typedef void (*Registration)();
+    /**
+     * Add a function which registers a type on demand.
+     *
+     * Used by NS_OBJECT_ENSURE_REGISTERED, instead of registering every
+     * type of every linked module during the static initialization.
+     * The registration runs the first time a TypeId is looked up by a
+     * name which ends with \pname{hint}, and when a lookup by name or hash
+     * fails, or the registered TypeIds are enumerated, for all the pending
+     * registrations.
+     *
+     * The registrations are not thread safe: a simulator which runs events
+     * on several threads runs them all, with GetRegisteredN(), before it
+     * starts its threads.
+     *
+     * \param [in] hint The name of the class, without its namespaces.
+     * \param [in] registration The function which registers the type.
+     */
+    static void AddRegistration(const std::string& hint, Registration registration);
+
     /**
      * Constructor.
      *
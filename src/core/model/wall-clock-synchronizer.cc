@@ -17,12 +17,21 @@
 
 #include "wall-clock-synchronizer.h"
 
+#include "enum.h"
+#include "integer.h"
 #include "log.h"
 
 #include <chrono>
 #include <condition_variable>
+#include <cstring>
 #include <ctime> // clock_t
 #include <mutex>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 /**
  * \file
@@ -41,11 +50,34 @@ TypeId
 WallClockSynchronizer::GetTypeId()
 {
     static TypeId tid =
-        TypeId("ns3::WallClockSynchronizer").SetParent<Synchronizer>().SetGroupName("Core");
+        TypeId("ns3::WallClockSynchronizer")
+            .SetParent<Synchronizer>()
+            .SetGroupName("Core")
+            .AddAttribute("WaitMode",
+                          "How to split the delays between sleeping and busy-waiting.",
+                          EnumValue(WAIT_JIFFIES),
+                          MakeEnumAccessor(&WallClockSynchronizer::m_waitMode),
+                          MakeEnumChecker(WAIT_JIFFIES, "Jiffies", WAIT_HYBRID, "Hybrid"))
+            .AddAttribute("SpinTime",
+                          "The busy wait at the end of every delay, on top of the "
+                          "calibrated sleep overshoot (used with WaitMode=Hybrid)",
+                          TimeValue(MicroSeconds(10)),
+                          MakeTimeAccessor(&WallClockSynchronizer::m_spinTime),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("CpuAffinity",
+                          "The CPU to pin the simulator thread to when the simulation "
+                          "starts, or -1 to leave it to the scheduler (Linux only)",
+                          IntegerValue(-1),
+                          MakeIntegerAccessor(&WallClockSynchronizer::m_cpu),
+                          MakeIntegerChecker<int32_t>(-1));
     return tid;
 }
 
 WallClockSynchronizer::WallClockSynchronizer()
+    : m_waitMode(WAIT_JIFFIES),
+      m_spinTime(MicroSeconds(10)),
+      m_cpu(-1),
+      m_overshoot(0)
 {
     NS_LOG_FUNCTION(this);
     //
@@ -111,6 +143,17 @@ WallClockSynchronizer::DoSetOrigin(uint64_t ns)
     // save the real time away so we can subtract it from "now" later and get
     // a count of nanoseconds in real time since the simulation started.
     //
+    // DoSetOrigin is called by the simulator thread, when the simulation
+    // starts, so this is the time to pin it and to calibrate the sleeps.
+    //
+    if (m_cpu >= 0)
+    {
+        PinThread();
+    }
+    if (m_waitMode == WAIT_HYBRID)
+    {
+        CalibrateOvershoot();
+    }
     m_realtimeOriginNano = GetRealtime();
     NS_LOG_INFO("origin = " << m_realtimeOriginNano);
 }
@@ -181,6 +224,10 @@ WallClockSynchronizer::DoSynchronize(uint64_t nsCurrent, uint64_t nsDelay)
     // hand, print warning messages, or just ignore the situation and hope it will
     // go away.
     //
+    if (m_waitMode == WAIT_HYBRID)
+    {
+        return HybridWait(nsCurrent + nsDelay);
+    }
     uint64_t ns = DriftCorrect(nsCurrent, nsDelay);
     NS_LOG_INFO("Synchronize ns = " << ns);
     //
@@ -343,6 +390,107 @@ WallClockSynchronizer::SleepWait(uint64_t ns)
     return finishedWaiting;
 }
 
+bool
+WallClockSynchronizer::HybridWait(uint64_t ns)
+{
+    NS_LOG_FUNCTION(this << ns);
+    //
+    // Sleep until the expected overshoot of the sleep, plus a little margin,
+    // before the deadline: most of the time we wake up a few microseconds
+    // early, and busy-wait for the rest.  The overshoot of every sleep which
+    // was not interrupted refines the estimate.
+    //
+    uint64_t margin = m_overshoot + m_spinTime.GetNanoSeconds();
+    uint64_t nsNow = GetNormalizedRealtime();
+    if (ns > nsNow + margin)
+    {
+        uint64_t nsWakeup = ns - margin;
+        // The sleep returns true if it was interrupted by the condition.
+        if (SleepWait(nsWakeup - nsNow))
+        {
+            NS_LOG_INFO("SleepWait interrupted");
+            return false;
+        }
+        nsNow = GetNormalizedRealtime();
+        UpdateOvershoot(nsNow > nsWakeup ? nsNow - nsWakeup : 0);
+    }
+    if (nsNow >= ns)
+    {
+        return true;
+    }
+    return SpinWait(ns);
+}
+
+Time
+WallClockSynchronizer::GetSleepOvershoot() const
+{
+    NS_LOG_FUNCTION(this);
+    return NanoSeconds(m_overshoot);
+}
+
+void
+WallClockSynchronizer::UpdateOvershoot(uint64_t ns)
+{
+    NS_LOG_FUNCTION(this << ns);
+    //
+    // Follow an increase quickly, so that a loaded system does not make
+    // every event late, and a decrease slowly, so that the estimate stays
+    // close to the upper tail of the overshoots rather than their mean.
+    //
+    if (ns > m_overshoot)
+    {
+        m_overshoot += (ns - m_overshoot) / 2;
+    }
+    else
+    {
+        m_overshoot -= (m_overshoot - ns) / 16;
+    }
+}
+
+void
+WallClockSynchronizer::CalibrateOvershoot()
+{
+    NS_LOG_FUNCTION(this);
+    const int samples = 16;
+    const auto sleep = std::chrono::microseconds(100);
+    m_overshoot = 0;
+    for (int i = 0; i < samples; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(sleep);
+        auto elapsed = std::chrono::steady_clock::now() - start - sleep;
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        UpdateOvershoot(ns > 0 ? ns : 0);
+    }
+    NS_LOG_INFO("Sleep overshoot is " << m_overshoot << " ns");
+}
+
+void
+WallClockSynchronizer::PinThread()
+{
+    NS_LOG_FUNCTION(this);
+#ifdef __linux__
+    if (m_cpu >= CPU_SETSIZE)
+    {
+        NS_LOG_WARN("Cannot pin the simulator thread to CPU " << m_cpu);
+        return;
+    }
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(m_cpu, &cpus);
+    int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (error != 0)
+    {
+        NS_LOG_WARN("Cannot pin the simulator thread to CPU " << m_cpu << ": "
+                                                               << std::strerror(error));
+        return;
+    }
+    NS_LOG_INFO("Simulator thread pinned to CPU " << m_cpu);
+#else
+    NS_LOG_WARN("Pinning the simulator thread is only supported on Linux");
+#endif
+}
+
 uint64_t
 WallClockSynchronizer::DriftCorrect(uint64_t nsNow, uint64_t nsDelay)
 {
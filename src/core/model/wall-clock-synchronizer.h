@@ -18,6 +18,7 @@
 #ifndef WALL_CLOCK_CLOCK_SYNCHRONIZER_H
 #define WALL_CLOCK_CLOCK_SYNCHRONIZER_H
 
+#include "nstime.h"
 #include "synchronizer.h"
 
 #include <condition_variable>
@@ -62,6 +63,15 @@ namespace ns3
  * to use the function @c clock_nanosleep() to sleep until a simulation Time
  * specified by the caller.
  *
+ * In the default WaitMode, Jiffies, the synchronizer sleeps for all but
+ * three jiffies of a delay, then busy-waits for the rest.  In the Hybrid
+ * WaitMode, it measures how late the sleeps return, sleeps until the
+ * expected overshoot plus SpinTime before the deadline, and busy-waits
+ * only for the last few microseconds.  The overshoot is calibrated when
+ * the simulation starts, and updated after every sleep.  The simulator
+ * thread can also be pinned to a CPU with the CpuAffinity attribute, to
+ * avoid migrations while it spins.
+ *
  * @todo Add more on jiffies, sleep, processes, etc.
  *
  */
@@ -86,6 +96,26 @@ class WallClockSynchronizer : public Synchronizer
     /** Conversion constant between ns and s. */
     static const uint64_t NS_PER_SEC = (uint64_t)1000000000;
 
+    /** How to split the delays between sleeping and busy-waiting. */
+    enum WaitMode
+    {
+        /** Sleep for all but three jiffies, then busy-wait. */
+        WAIT_JIFFIES,
+        /**
+         * Sleep until the calibrated overshoot plus the spin time before
+         * the deadline, then busy-wait.
+         */
+        WAIT_HYBRID,
+    };
+
+    /**
+     * @brief Get the estimate of how late the sleeps return, in WaitMode
+     * Hybrid.
+     *
+     * @returns The estimated sleep overshoot.
+     */
+    Time GetSleepOvershoot() const;
+
   protected:
     /**
      * @brief Do a busy-wait until the normalized realtime equals the argument
@@ -161,6 +191,34 @@ class WallClockSynchronizer : public Synchronizer
      */
     uint64_t GetNormalizedRealtime();
 
+    /**
+     * @brief Wait until the normalized realtime @p ns, in WaitMode Hybrid.
+     *
+     * @param [in] ns The target normalized real time we should wait for.
+     * @returns @c true if we reached the target time,
+     *          @c false if we returned because the condition was set.
+     */
+    bool HybridWait(uint64_t ns);
+    /**
+     * @brief Update the estimate of the sleep overshoot with a new sample.
+     *
+     * @param [in] ns How late a sleep returned, in ns.
+     */
+    void UpdateOvershoot(uint64_t ns);
+    /** Estimate the sleep overshoot with a few short sleeps. */
+    void CalibrateOvershoot();
+    /** Pin the calling thread to the CPU #m_cpu. */
+    void PinThread();
+
+    /** How the delays are split between sleeping and busy-waiting. */
+    WaitMode m_waitMode;
+    /** The busy wait at the end of a delay in WaitMode Hybrid. */
+    Time m_spinTime;
+    /** The CPU to pin the simulator thread to, or -1. */
+    int32_t m_cpu;
+    /** The estimated sleep overshoot, in ns. */
+    uint64_t m_overshoot;
+
     /** Size of the system clock tick, as reported by @c clock_getres, in ns. */
     uint64_t m_jiffy;
     /** Time recorded by DoEventStart. */
@@ -629,6 +629,91 @@ ObjectVectorConfigTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(iv.Get(), -16, "Object Attribute \"A\" not set as expected");
 }
 
+/**
+ * \ingroup config-tests
+ * Test the objects and contexts matched by indexes of vectors of Object.
+ */
+class ObjectVectorIndexConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ObjectVectorIndexConfigTestCase();
+
+    /** Destructor. */
+    ~ObjectVectorIndexConfigTestCase() override
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+ObjectVectorIndexConfigTestCase::ObjectVectorIndexConfigTestCase()
+    : TestCase("Check the objects matched by indexes of vectors of Object")
+{
+}
+
+void
+ObjectVectorIndexConfigTestCase::DoRun()
+{
+    Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject>();
+    Config::RegisterRootNamespaceObject(root);
+    std::vector<Ptr<ConfigTestObject>> nodes;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        nodes.push_back(CreateObject<ConfigTestObject>());
+        root->AddNodeA(nodes.back());
+    }
+
+    //
+    // The second lookup of a path reuses the compiled path.
+    //
+    Config::ResetResolutionStats();
+    Config::LookupMatches("/NodesA/[0-1]");
+    Config::LookupMatches("/NodesA/[0-1]");
+    Config::ResolutionStats stats = Config::GetResolutionStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.lookups, 2U, "Unexpected number of lookups");
+    NS_TEST_ASSERT_MSG_EQ(stats.compiles, 1U, "Unexpected number of compiled paths");
+    NS_TEST_ASSERT_MSG_EQ(stats.matches, 4U, "Unexpected number of matches");
+
+    //
+    // The objects are matched once, in the order of their indexes, whatever
+    // the order of the terms of the index specification.
+    //
+    const std::vector<std::pair<std::string, std::vector<uint32_t>>> cases = {
+        {"*", {0, 1, 2, 3}},
+        {"1", {1}},
+        {"[1-2]", {1, 2}},
+        {"2|0", {0, 2}},
+        {"[0-2]|1", {0, 1, 2}},
+        {"3|[1-9]", {1, 2, 3}},
+        {"|1|", {1}},
+        {"[2-1]", {}},
+        {"4", {}},
+        {"[5-7]", {}},
+        {"x", {}},
+    };
+    for (const auto& c : cases)
+    {
+        Config::MatchContainer matches = Config::LookupMatches("/NodesA/" + c.first);
+        NS_TEST_ASSERT_MSG_EQ(matches.GetN(),
+                              c.second.size(),
+                              "Unexpected number of matches for " << c.first);
+        for (std::size_t i = 0; i < matches.GetN() && i < c.second.size(); ++i)
+        {
+            uint32_t index = c.second[i];
+            NS_TEST_ASSERT_MSG_EQ(matches.Get(i),
+                                  nodes[index],
+                                  "Unexpected object matched by " << c.first);
+            NS_TEST_ASSERT_MSG_EQ(matches.GetMatchedPath(i),
+                                  "/NodesA/" + std::to_string(index) + "/",
+                                  "Unexpected context matched by " << c.first);
+        }
+    }
+
+    Config::UnregisterRootNamespaceObject(root);
+}
+
 /**
  * \ingroup config-tests
  * Test for the ability to trace configure with vectors of objects.
@@ -881,6 +966,7 @@ ConfigTestSuite::ConfigTestSuite()
     AddTestCase(new RootNamespaceConfigTestCase);
     AddTestCase(new UnderRootNamespaceConfigTestCase);
     AddTestCase(new ObjectVectorConfigTestCase);
+    AddTestCase(new ObjectVectorIndexConfigTestCase);
     AddTestCase(new SearchAttributesOfParentObjectsTestCase);
 }
 
@@ -0,0 +1,171 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup logging
+ * \ingroup log-ring-tests
+ * Binary ring buffer logging backend test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup log-ring-tests Binary ring buffer logging backend test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+NS_LOG_COMPONENT_DEFINE("LogRingTestSuite");
+
+/**
+ * \ingroup log-ring-tests
+ * Log a few messages.
+ * \param [in] n The number of the last message.
+ */
+static void
+LogMessages(int n)
+{
+    NS_LOG_FUNCTION(n << "x");
+    NS_LOG_WARN(std::string(200, 'w'));
+    for (int i = 0; i <= n; i++)
+    {
+        NS_LOG_INFO("message " << i);
+    }
+}
+
+/**
+ * \ingroup log-ring-tests
+ * Check the records of a dump of the rings.
+ */
+class LogRingTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    LogRingTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Log the messages in a simulation, dump the rings, and decode them.
+     * \param [in] records The size of the rings.
+     * \returns The decoded records.
+     */
+    std::vector<std::string> LogAndDecode(std::size_t records);
+};
+
+LogRingTestCase::LogRingTestCase()
+    : TestCase("Check the records of a dump of the rings")
+{
+}
+
+std::vector<std::string>
+LogRingTestCase::LogAndDecode(std::size_t records)
+{
+    LogComponentEnable("LogRingTestSuite", LOG_LEVEL_ALL);
+    LogRingEnable(records, "");
+    Simulator::ScheduleWithContext(7, Seconds(1.5), &LogMessages, 9);
+    Simulator::Run();
+    Simulator::Destroy();
+    std::string filename = CreateTempDirFilename("log.ring");
+    bool dumped = LogRingDump(filename);
+    LogRingDisable();
+    LogComponentDisable("LogRingTestSuite", LOG_LEVEL_ALL);
+    NS_TEST_EXPECT_MSG_EQ(dumped, true, "Dump failed");
+
+    std::ifstream is(filename, std::ios::binary);
+    std::ostringstream os;
+    NS_TEST_EXPECT_MSG_EQ(LogRingDecode(is, os), true, "Decode failed");
+    std::vector<std::string> lines;
+    std::istringstream iss(os.str());
+    std::string line;
+    while (std::getline(iss, line))
+    {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+void
+LogRingTestCase::DoRun()
+{
+    std::vector<std::string> lines = LogAndDecode(16);
+#ifdef NS3_LOG_ENABLE
+    const std::string prefix = "+1.500000000s 7 LogRingTestSuite:LogMessages";
+    NS_TEST_ASSERT_MSG_EQ(lines.size(), 12U, "Unexpected number of records");
+    NS_TEST_EXPECT_MSG_EQ(lines[0], prefix + "(9, \"x\")", "Unexpected function record");
+    NS_TEST_EXPECT_MSG_EQ(lines[1],
+                          prefix + "(): [WARN ] " + std::string(LogRingRecord::TEXT_SIZE, 'w'),
+                          "The message should be truncated");
+    for (int i = 0; i <= 9; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(lines[2 + i],
+                              prefix + "(): [INFO ] message " + std::to_string(i),
+                              "Unexpected info record");
+    }
+
+    // The rings only keep the last records.
+    lines = LogAndDecode(4);
+    NS_TEST_ASSERT_MSG_EQ(lines.size(), 4U, "Unexpected number of records");
+    for (int i = 0; i < 4; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(lines[i],
+                              prefix + "(): [INFO ] message " + std::to_string(6 + i),
+                              "Unexpected info record");
+    }
+#else
+    NS_TEST_EXPECT_MSG_EQ(lines.size(), 0U, "No records without NS_LOG");
+#endif
+}
+
+/**
+ * \ingroup log-ring-tests
+ * Binary ring buffer logging backend test suite.
+ */
+class LogRingTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    LogRingTestSuite();
+};
+
+LogRingTestSuite::LogRingTestSuite()
+    : TestSuite("log-ring", UNIT)
+{
+    AddTestCase(new LogRingTestCase);
+}
+
+/**
+ * \ingroup log-ring-tests
+ * LogRingTestSuite instance variable.
+ */
+static LogRingTestSuite g_logRingTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
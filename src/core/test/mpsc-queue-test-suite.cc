@@ -0,0 +1,167 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/mpsc-queue.h"
+#include "ns3/test.h"
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup mpsc-queue-tests
+ * MpscQueue test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup mpsc-queue-tests MpscQueue test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup mpsc-queue-tests
+ * Check the values pushed from a single thread are drained in order.
+ */
+class MpscQueueOrderTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    MpscQueueOrderTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MpscQueueOrderTestCase::MpscQueueOrderTestCase()
+    : TestCase("Check the push order is preserved")
+{
+}
+
+void
+MpscQueueOrderTestCase::DoRun()
+{
+    MpscQueue<int> queue;
+    NS_TEST_ASSERT_MSG_EQ(queue.IsEmpty(), true, "New queue not empty");
+    for (int i = 0; i < 10; ++i)
+    {
+        queue.Push(i);
+    }
+    NS_TEST_ASSERT_MSG_EQ(queue.IsEmpty(), false, "Queue empty after Push");
+
+    std::vector<int> values;
+    std::size_t n = queue.Drain([&values](int value) { values.push_back(value); });
+    NS_TEST_ASSERT_MSG_EQ(n, 10, "Wrong number of values drained");
+    NS_TEST_ASSERT_MSG_EQ(queue.IsEmpty(), true, "Queue not empty after Drain");
+    for (int i = 0; i < 10; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(values[i], i, "Values drained out of order");
+    }
+    NS_TEST_ASSERT_MSG_EQ(queue.Drain([](int) {}), 0, "Values drained twice");
+}
+
+/**
+ * \ingroup mpsc-queue-tests
+ * Check no value is lost or reordered with concurrent producers.
+ */
+class MpscQueueThreadsTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    MpscQueueThreadsTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MpscQueueThreadsTestCase::MpscQueueThreadsTestCase()
+    : TestCase("Check concurrent producers")
+{
+}
+
+void
+MpscQueueThreadsTestCase::DoRun()
+{
+    const uint32_t nThreads = 4;
+    const uint32_t nValues = 10000;
+    MpscQueue<std::pair<uint32_t, uint32_t>> queue;
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < nThreads; ++t)
+    {
+        threads.emplace_back([&queue, t, nValues]() {
+            for (uint32_t i = 0; i < nValues; ++i)
+            {
+                queue.Push({t, i});
+            }
+        });
+    }
+
+    // Drain while the producers are running.
+    std::vector<uint32_t> next(nThreads, 0);
+    bool ordered = true;
+    auto check = [&next, &ordered](const std::pair<uint32_t, uint32_t>& value) {
+        ordered = ordered && value.second == next[value.first];
+        next[value.first]++;
+    };
+    std::size_t total = 0;
+    while (total < nThreads * nValues)
+    {
+        total += queue.Drain(check);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    NS_TEST_EXPECT_MSG_EQ(ordered, true, "Values of one producer drained out of order");
+    NS_TEST_EXPECT_MSG_EQ(total, nThreads * nValues, "Wrong number of values drained");
+    NS_TEST_EXPECT_MSG_EQ(queue.IsEmpty(), true, "Queue not empty");
+}
+
+/**
+ * \ingroup mpsc-queue-tests
+ * MpscQueue test suite.
+ */
+class MpscQueueTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    MpscQueueTestSuite();
+};
+
+MpscQueueTestSuite::MpscQueueTestSuite()
+    : TestSuite("mpsc-queue")
+{
+    AddTestCase(new MpscQueueOrderTestCase);
+    AddTestCase(new MpscQueueThreadsTestCase);
+}
+
+/**
+ * \ingroup mpsc-queue-tests
+ * MpscQueueTestSuite instance variable.
+ */
+static MpscQueueTestSuite g_mpscQueueTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
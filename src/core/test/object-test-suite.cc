@@ -464,6 +464,67 @@ AggregateObjectTestCase::DoRun()
     NS_TEST_ASSERT_MSG_NE(baseA, nullptr, "Unable to GetObject on released object");
 }
 
+/**
+ * \ingroup object-tests
+ * Test the lookup table of the aggregates is updated by AggregateObject.
+ */
+class AggregateLookupTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    AggregateLookupTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+AggregateLookupTestCase::AggregateLookupTestCase()
+    : TestCase("Check Object aggregate lookup after aggregation")
+{
+}
+
+void
+AggregateLookupTestCase::DoRun()
+{
+    Ptr<DerivedA> derivedA = CreateObject<DerivedA>();
+    Ptr<Object> object = derivedA;
+
+    //
+    // Look up a single Object by its TypeId, its parents and a missing TypeId,
+    // which builds its lookup table.
+    //
+    NS_TEST_ASSERT_MSG_EQ(object->GetObject<DerivedA>(), derivedA, "Cannot find DerivedA");
+    NS_TEST_ASSERT_MSG_EQ(object->GetObject<BaseA>(), derivedA, "Cannot find BaseA");
+    NS_TEST_ASSERT_MSG_EQ(object->GetObject<Object>(BaseA::GetTypeId()),
+                          object,
+                          "Cannot find BaseA by TypeId");
+    NS_TEST_ASSERT_MSG_EQ(object->GetObject<BaseB>(), nullptr, "Unexpectedly found a BaseB");
+
+    //
+    // The lookup table must be rebuilt after aggregation, on both sides.
+    //
+    Ptr<DerivedB> derivedB = CreateObject<DerivedB>();
+    NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<BaseA>(), nullptr, "Unexpectedly found a BaseA");
+    derivedA->AggregateObject(derivedB);
+    NS_TEST_ASSERT_MSG_EQ(object->GetObject<BaseB>(), derivedB, "Cannot find BaseB");
+    NS_TEST_ASSERT_MSG_EQ(object->GetObject<DerivedB>(), derivedB, "Cannot find DerivedB");
+    NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<BaseA>(), derivedA, "Cannot find BaseA");
+    NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<DerivedA>(), derivedA, "Cannot find DerivedA");
+    NS_TEST_ASSERT_MSG_EQ(object->GetObject<Object>(DerivedB::GetTypeId()),
+                          Ptr<Object>(derivedB),
+                          "Cannot find DerivedB by TypeId");
+
+    //
+    // Types which are not Objects are not found.
+    //
+    NS_TEST_ASSERT_MSG_EQ(object->GetObject<Object>(ObjectBase::GetTypeId()),
+                          nullptr,
+                          "Unexpectedly found an ObjectBase");
+    NS_TEST_ASSERT_MSG_EQ(object->GetObject<Object>(TypeId()),
+                          nullptr,
+                          "Unexpectedly found an invalid TypeId");
+}
+
 /**
  * \ingroup object-tests
  * Test an Object factory can create Objects
@@ -565,6 +626,7 @@ ObjectTestSuite::ObjectTestSuite()
 {
     AddTestCase(new CreateObjectTestCase);
     AddTestCase(new AggregateObjectTestCase);
+    AddTestCase(new AggregateLookupTestCase);
     AddTestCase(new ObjectFactoryTestCase);
 }
 
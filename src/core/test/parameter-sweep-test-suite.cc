@@ -0,0 +1,172 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/config.h"
+#include "ns3/integer.h"
+#include "ns3/object.h"
+#include "ns3/parameter-sweep.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <string>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup simulator
+ * \ingroup parameter-sweep-tests
+ * ParameterSweep test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup parameter-sweep-tests ParameterSweep test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup parameter-sweep-tests
+ * A counter incremented by a configurable step every second.
+ */
+class SweepCounter : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("SweepCounter")
+                                .SetParent<Object>()
+                                .AddAttribute("Step",
+                                              "The increment of the counter every second",
+                                              IntegerValue(1),
+                                              MakeIntegerAccessor(&SweepCounter::m_step),
+                                              MakeIntegerChecker<int32_t>());
+        return tid;
+    }
+
+    /** Increment the counter, and schedule the next increment. */
+    void Tick()
+    {
+        m_count += m_step;
+        Simulator::Schedule(Seconds(1), &SweepCounter::Tick, this);
+    }
+
+    /**
+     * Get the counter.
+     * \returns The counter, as a string.
+     */
+    std::string GetCount() const
+    {
+        return std::to_string(m_count);
+    }
+
+    int32_t m_step{1};  //!< Step attribute target.
+    int32_t m_count{0}; //!< The counter.
+};
+
+/**
+ * \ingroup parameter-sweep-tests
+ * Check that every run starts from the checkpoint with its own attribute values.
+ */
+class ParameterSweepTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ParameterSweepTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ParameterSweepTestCase::ParameterSweepTestCase()
+    : TestCase("Check that the runs of a sweep start from the checkpoint")
+{
+}
+
+void
+ParameterSweepTestCase::DoRun()
+{
+    Ptr<SweepCounter> counter = CreateObject<SweepCounter>();
+    Config::RegisterRootNamespaceObject(counter);
+    Simulator::Schedule(MilliSeconds(500), &SweepCounter::Tick, counter);
+
+    // Five ticks before the checkpoint, five more before the stop time.
+    ParameterSweep sweep;
+    sweep.SetCheckpoint(Seconds(5));
+    sweep.SetStopTime(Seconds(10));
+    sweep.SetMaxProcesses(2);
+    for (int32_t step = 1; step <= 3; ++step)
+    {
+        sweep.AddRun({{"/Step", std::to_string(step)}});
+    }
+    NS_TEST_ASSERT_MSG_EQ(sweep.GetNRuns(), 3U, "Unexpected number of runs");
+
+    std::vector<ParameterSweep::Result> results =
+        sweep.Run(MakeCallback(&SweepCounter::GetCount, counter));
+
+    NS_TEST_ASSERT_MSG_EQ(results.size(), 3U, "Unexpected number of results");
+    for (int32_t step = 1; step <= 3; ++step)
+    {
+        const ParameterSweep::Result& result = results[step - 1];
+        NS_TEST_ASSERT_MSG_EQ(result.ok, true, "Run " << step << " failed");
+        NS_TEST_ASSERT_MSG_EQ(result.overrides.size(), 1U, "Unexpected overrides");
+        NS_TEST_ASSERT_MSG_EQ(result.output,
+                              std::to_string(5 + 5 * step),
+                              "Unexpected counter in run " << step);
+    }
+
+    // The runs do not change the simulation of the parent.
+    NS_TEST_ASSERT_MSG_EQ(Simulator::Now(), Seconds(5), "Parent not at the checkpoint");
+    NS_TEST_ASSERT_MSG_EQ(counter->m_step, 1, "Step changed in the parent");
+    NS_TEST_ASSERT_MSG_EQ(counter->m_count, 5, "Counter changed in the parent");
+
+    Config::UnregisterRootNamespaceObject(counter);
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup parameter-sweep-tests
+ * ParameterSweep test suite.
+ */
+class ParameterSweepTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    ParameterSweepTestSuite();
+};
+
+ParameterSweepTestSuite::ParameterSweepTestSuite()
+    : TestSuite("parameter-sweep", UNIT)
+{
+    AddTestCase(new ParameterSweepTestCase);
+}
+
+/**
+ * \ingroup parameter-sweep-tests
+ * ParameterSweepTestSuite instance variable.
+ */
+static ParameterSweepTestSuite g_parameterSweepTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -26,6 +26,7 @@
 #include "ns3/log.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/rng-seed-manager.h"
+#include "ns3/rng-stream.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
 
@@ -2565,6 +2566,121 @@ NormalCachingTestCase::DoRun()
     NS_TEST_ASSERT_MSG_GT(v2, 0, "Incorrect value returned, expected > 0");
 }
 
+/**
+ * \ingroup rng-tests
+ * Test that the randoms generated by blocks are the same, bit for bit,
+ * as the randoms of the scalar MRG32k3a generator.
+ */
+class RngStreamBlockTestCase : public TestCaseBase
+{
+  public:
+    // Constructor
+    RngStreamBlockTestCase();
+
+  private:
+    // Inherited
+    void DoRun() override;
+
+    /**
+     * The scalar MRG32k3a generator, as published by L'Ecuyer.
+     * \param [in,out] state The generator state.
+     * \returns The next random.
+     */
+    static double ReferenceRandU01(double state[6]);
+};
+
+RngStreamBlockTestCase::RngStreamBlockTestCase()
+    : TestCaseBase("RngStream block generation matches the scalar generator")
+{
+}
+
+double
+RngStreamBlockTestCase::ReferenceRandU01(double state[6])
+{
+    const double m1 = 4294967087.0;
+    const double m2 = 4294944443.0;
+    const double norm = 1.0 / (m1 + 1.0);
+
+    double p1 = 1403580.0 * state[1] - 810728.0 * state[0];
+    p1 -= static_cast<int32_t>(p1 / m1) * m1;
+    if (p1 < 0.0)
+    {
+        p1 += m1;
+    }
+    state[0] = state[1];
+    state[1] = state[2];
+    state[2] = p1;
+
+    double p2 = 527612.0 * state[5] - 1370589.0 * state[3];
+    p2 -= static_cast<int32_t>(p2 / m2) * m2;
+    if (p2 < 0.0)
+    {
+        p2 += m2;
+    }
+    state[3] = state[4];
+    state[4] = state[5];
+    state[5] = p2;
+
+    return ((p1 > p2) ? (p1 - p2) * norm : (p1 - p2 + m1) * norm);
+}
+
+void
+RngStreamBlockTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this);
+
+    // Stream 0, substream 0 starts from the seed in all six state values.
+    const uint32_t seed = 12345;
+    double state[6] = {seed, seed, seed, seed, seed, seed};
+
+    // One at a time, through the buffer.
+    RngStream rng(seed, 0, 0);
+    for (uint32_t i = 0; i < 100000; ++i)
+    {
+        double expected = ReferenceRandU01(state);
+        NS_TEST_ASSERT_MSG_EQ(rng.RandU01(), expected, "Random " << i << " differs");
+    }
+
+    // Interleaved with blocks of various sizes, starting at any
+    // position in the buffer.
+    std::vector<double> block(100);
+    for (uint32_t n : {1, 3, 16, 17, 5, 32, 100, 2, 15, 31})
+    {
+        NS_TEST_ASSERT_MSG_EQ(rng.RandU01(),
+                              ReferenceRandU01(state),
+                              "Random before a block of " << n << " differs");
+        rng.RandU01(block.data(), n);
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            NS_TEST_ASSERT_MSG_EQ(block[i],
+                                  ReferenceRandU01(state),
+                                  "Random " << i << " of a block of " << n << " differs");
+        }
+    }
+
+    // A copy continues the same sequence.
+    RngStream copy(rng);
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        double expected = ReferenceRandU01(state);
+        NS_TEST_ASSERT_MSG_EQ(rng.RandU01(), expected, "Random " << i << " differs");
+        NS_TEST_ASSERT_MSG_EQ(copy.RandU01(), expected, "Random " << i << " of copy differs");
+    }
+
+    // The random variables draw the same sequence.
+    SetTestSuiteSeed();
+    const int64_t stream = 42;
+    Ptr<UniformRandomVariable> x = CreateObject<UniformRandomVariable>();
+    x->SetStream(stream);
+    RngStream reference(RngSeedManager::GetSeed(), (1ULL << 63) + stream, RngSeedManager::GetRun());
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(x->GetValue(0, 1),
+                              reference.RandU01(),
+                              "UniformRandomVariable value " << i << " differs");
+    }
+}
+
 /**
  * \ingroup rng-tests
  * RandomVariableStream test suite, covering all random number variable
@@ -2617,6 +2733,7 @@ RandomVariableSuite::RandomVariableSuite()
     AddTestCase(new EmpiricalAntitheticTestCase);
     /// Issue #302:  NormalRandomVariable produces stale values
     AddTestCase(new NormalCachingTestCase);
+    AddTestCase(new RngStreamBlockTestCase);
 }
 
 static RandomVariableSuite randomVariableSuite; //!< Static variable for test initialization
@@ -16,13 +16,22 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/boolean.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/config.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/double.h"
 #include "ns3/heap-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <fstream>
+#include <sstream>
 
 using namespace ns3;
 
@@ -221,6 +230,218 @@ SimulatorEventsTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(m_destroy, true, "Event should have run");
 }
 
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that cancelled events are dropped from the event list,
+ * either eagerly or by compaction, without disturbing the live events.
+ */
+class SimulatorCancelTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param schedulerFactory Scheduler factory.
+     */
+    SimulatorCancelTestCase(ObjectFactory schedulerFactory);
+    void DoRun() override;
+
+  private:
+    /**
+     * Create a DefaultSimulatorImpl and install it as the simulator.
+     * \param eager Value of the EagerCancel attribute.
+     * \param threshold Value of the CompactionThreshold attribute.
+     * \return The simulator implementation.
+     */
+    Ptr<DefaultSimulatorImpl> Setup(bool eager, double threshold);
+    /** Test event, checks that events run in time order. */
+    void Event();
+
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+    uint32_t m_count;                 //!< Number of events which ran.
+    Time m_last;                      //!< Time of the last event which ran.
+    bool m_ordered;                   //!< Whether events ran in time order.
+};
+
+SimulatorCancelTestCase::SimulatorCancelTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check removal of cancelled events with " +
+               schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+Ptr<DefaultSimulatorImpl>
+SimulatorCancelTestCase::Setup(bool eager, double threshold)
+{
+    ObjectFactory factory("ns3::DefaultSimulatorImpl");
+    factory.Set("EagerCancel", BooleanValue(eager));
+    factory.Set("CompactionThreshold", DoubleValue(threshold));
+    factory.Set("CompactionMinEvents", UintegerValue(16));
+    Ptr<DefaultSimulatorImpl> impl = factory.Create<DefaultSimulatorImpl>();
+    Simulator::SetImplementation(impl);
+    Simulator::SetScheduler(m_schedulerFactory);
+    m_count = 0;
+    m_last = Seconds(0);
+    m_ordered = true;
+    return impl;
+}
+
+void
+SimulatorCancelTestCase::Event()
+{
+    if (Simulator::Now() < m_last)
+    {
+        m_ordered = false;
+    }
+    m_last = Simulator::Now();
+    m_count++;
+}
+
+void
+SimulatorCancelTestCase::DoRun()
+{
+    std::vector<EventId> ids;
+
+    // Compaction once more than half of the event list is dead
+    Ptr<DefaultSimulatorImpl> impl = Setup(false, 0.5);
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        ids.push_back(
+            Simulator::Schedule(MicroSeconds(100 - i), &SimulatorCancelTestCase::Event, this));
+    }
+    for (uint32_t i = 0; i < 50; i++)
+    {
+        Simulator::Cancel(ids[2 * i]);
+    }
+    NS_TEST_EXPECT_MSG_EQ(impl->GetCancelledEventCount(), 50, "Cancelled events are kept");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetLiveEventCount(), 50, "Wrong live event count");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetCompactionCount(), 0, "Compacted too early");
+    Simulator::Cancel(ids[1]);
+    NS_TEST_EXPECT_MSG_EQ(impl->GetCompactionCount(), 1, "Event list was not compacted");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetCancelledEventCount(), 0, "Cancelled events are kept");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetLiveEventCount(), 49, "Wrong live event count");
+    NS_TEST_EXPECT_MSG_EQ(ids[0].IsExpired(), true, "Compacted event should be expired");
+    NS_TEST_EXPECT_MSG_EQ(ids[3].IsExpired(), false, "Live event should not be expired");
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_count, 49, "Wrong number of events run");
+    NS_TEST_EXPECT_MSG_EQ(m_ordered, true, "Events did not run in time order");
+    Simulator::Destroy();
+
+    // Eager removal
+    ids.clear();
+    impl = Setup(true, 0);
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        ids.push_back(Simulator::Schedule(MicroSeconds(i), &SimulatorCancelTestCase::Event, this));
+    }
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        Simulator::Cancel(ids[i]);
+        NS_TEST_EXPECT_MSG_EQ(ids[i].IsExpired(), true, "Cancelled event should be expired");
+    }
+    NS_TEST_EXPECT_MSG_EQ(impl->GetCancelledEventCount(), 0, "Cancelled events are kept");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetLiveEventCount(), 6, "Wrong live event count");
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_count, 6, "Wrong number of events run");
+    NS_TEST_EXPECT_MSG_EQ(m_ordered, true, "Events did not run in time order");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that the event profiler counts every type of event, and
+ * tells apart the functions with the same signature.
+ */
+class SimulatorProfilerTestCase : public TestCase
+{
+  public:
+    SimulatorProfilerTestCase();
+    void DoRun() override;
+
+  private:
+    /** Test event. */
+    void Event();
+    /** Another test event. */
+    static void StaticEvent();
+    /** Another test event, with the signature of StaticEvent. */
+    static void OtherStaticEvent();
+};
+
+SimulatorProfilerTestCase::SimulatorProfilerTestCase()
+    : TestCase("Check the event profiler")
+{
+}
+
+void
+SimulatorProfilerTestCase::Event()
+{
+}
+
+void
+SimulatorProfilerTestCase::StaticEvent()
+{
+}
+
+void
+SimulatorProfilerTestCase::OtherStaticEvent()
+{
+}
+
+void
+SimulatorProfilerTestCase::DoRun()
+{
+    std::string traceFile = CreateTempDirFilename("event-profile.json");
+    Config::SetGlobal("EventProfiler", BooleanValue(true));
+    Config::SetGlobal("EventProfilerTraceFile", StringValue(traceFile));
+
+    Ptr<DefaultSimulatorImpl> impl = CreateObject<DefaultSimulatorImpl>();
+    Simulator::SetImplementation(impl);
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        Simulator::Schedule(MicroSeconds(i), &SimulatorProfilerTestCase::Event, this);
+    }
+    Simulator::ScheduleWithContext(1, MicroSeconds(5), &SimulatorProfilerTestCase::StaticEvent);
+    Simulator::ScheduleWithContext(2, MicroSeconds(6), &SimulatorProfilerTestCase::StaticEvent);
+    Simulator::Schedule(MicroSeconds(7), &SimulatorProfilerTestCase::OtherStaticEvent);
+    Simulator::Run();
+
+    const EventProfiler* profiler = impl->GetEventProfiler();
+    NS_TEST_ASSERT_MSG_NE(profiler, nullptr, "Profiler not created");
+    NS_TEST_EXPECT_MSG_EQ(profiler->GetEventCount(), 6, "Wrong number of events");
+    NS_TEST_EXPECT_MSG_EQ(profiler->GetTypeCount(), 3, "Wrong number of event types");
+    NS_TEST_EXPECT_MSG_EQ(profiler->GetEventCount("SimulatorProfilerTestCase::*"),
+                          3,
+                          "Wrong number of member events");
+    // The events of the static functions have the same type, in separate rows
+    std::ostringstream staticEvent;
+    staticEvent << "[0x" << std::hex << GetEventFunctionId(&StaticEvent) << "]";
+    std::ostringstream otherStaticEvent;
+    otherStaticEvent << "[0x" << std::hex << GetEventFunctionId(&OtherStaticEvent) << "]";
+    NS_TEST_EXPECT_MSG_EQ(profiler->GetEventCount(staticEvent.str()),
+                          2,
+                          "Wrong number of events of the first function");
+    NS_TEST_EXPECT_MSG_EQ(profiler->GetEventCount(otherStaticEvent.str()),
+                          1,
+                          "Wrong number of events of the second function");
+    Simulator::Destroy();
+
+    std::ifstream trace(traceFile);
+    std::string line;
+    uint32_t events = 0;
+    while (std::getline(trace, line))
+    {
+        if (line.find("\"ph\":\"X\"") != std::string::npos)
+        {
+            events++;
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(events, 6, "Wrong number of events in the trace file");
+
+    Config::SetGlobal("EventProfiler", BooleanValue(false));
+    Config::SetGlobal("EventProfilerTraceFile", StringValue(""));
+}
+
 /**
  * \ingroup simulator-tests
  *
@@ -740,6 +961,19 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
+
+        factory.SetTypeId(ListScheduler::GetTypeId());
+        AddTestCase(new SimulatorCancelTestCase(factory), TestCase::QUICK);
+        factory.SetTypeId(MapScheduler::GetTypeId());
+        AddTestCase(new SimulatorCancelTestCase(factory), TestCase::QUICK);
+        factory.SetTypeId(HeapScheduler::GetTypeId());
+        AddTestCase(new SimulatorCancelTestCase(factory), TestCase::QUICK);
+        factory.SetTypeId(CalendarScheduler::GetTypeId());
+        AddTestCase(new SimulatorCancelTestCase(factory), TestCase::QUICK);
+        factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
+        AddTestCase(new SimulatorCancelTestCase(factory), TestCase::QUICK);
+
+        AddTestCase(new SimulatorProfilerTestCase(), TestCase::QUICK);
     }
 };
 
@@ -21,15 +21,19 @@
 #include "ns3/heap-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
+#include "ns3/realtime-simulator-impl.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
+#include "ns3/wall-clock-synchronizer.h"
 
 #include <chrono> // seconds, milliseconds
 #include <ctime>
 #include <list>
+#include <numeric>
 #include <thread> // sleep_for
 #include <utility>
+#include <vector>
 
 using namespace ns3;
 
@@ -278,6 +282,114 @@ ThreadedSimulatorEventsTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(m_a, m_d, "Bad scheduling");
 }
 
+/**
+ * \ingroup threaded-tests
+ *
+ * \brief Check that the realtime simulator records the lateness of every
+ * event, with the hybrid sleep and spin wait mode of the synchronizer.
+ */
+class RealtimeLatenessTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    RealtimeLatenessTestCase();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+};
+
+RealtimeLatenessTestCase::RealtimeLatenessTestCase()
+    : TestCase("Check the lateness histogram of the realtime simulator")
+{
+}
+
+void
+RealtimeLatenessTestCase::DoSetup()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::RealtimeSimulatorImpl"));
+    Config::SetDefault("ns3::WallClockSynchronizer::WaitMode", StringValue("Hybrid"));
+}
+
+void
+RealtimeLatenessTestCase::DoRun()
+{
+    const uint32_t events = 100;
+    for (uint32_t i = 1; i <= events; i++)
+    {
+        Simulator::Schedule(MicroSeconds(500 * i), []() {});
+    }
+    Simulator::Stop(MilliSeconds(60));
+    Simulator::Run();
+
+    Ptr<RealtimeSimulatorImpl> impl =
+        DynamicCast<RealtimeSimulatorImpl>(Simulator::GetImplementation());
+    NS_TEST_ASSERT_MSG_NE(impl, nullptr, "Not a realtime simulator");
+    std::vector<uint64_t> histogram = impl->GetLatenessHistogram();
+    NS_TEST_EXPECT_MSG_EQ(histogram.size(),
+                          RealtimeSimulatorImpl::LATENESS_BUCKETS,
+                          "Unexpected number of buckets");
+    NS_TEST_EXPECT_MSG_EQ(std::accumulate(histogram.begin(), histogram.end(), uint64_t(0)),
+                          impl->GetEventCount(),
+                          "Every event should be in the histogram");
+    // The events, and the stop event.
+    NS_TEST_EXPECT_MSG_EQ(impl->GetEventCount(), events + 1, "Unexpected number of events");
+    Simulator::Destroy();
+}
+
+void
+RealtimeLatenessTestCase::DoTeardown()
+{
+    Config::SetDefault("ns3::WallClockSynchronizer::WaitMode", StringValue("Jiffies"));
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+/**
+ * \ingroup threaded-tests
+ *
+ * \brief Check that a wait of the synchronizer in WaitMode Hybrid, which is
+ * not interrupted, reaches its deadline and updates the estimate of the
+ * sleep overshoot.
+ */
+class HybridWaitTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    HybridWaitTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+HybridWaitTestCase::HybridWaitTestCase()
+    : TestCase("Check a timed wait of the synchronizer in WaitMode Hybrid")
+{
+}
+
+void
+HybridWaitTestCase::DoRun()
+{
+    Ptr<WallClockSynchronizer> synchronizer = CreateObject<WallClockSynchronizer>();
+    // Set the origin in WaitMode Jiffies, which does not calibrate the overshoot
+    synchronizer->SetOrigin(0);
+    synchronizer->SetAttribute("WaitMode", StringValue("Hybrid"));
+    synchronizer->SetCondition(false);
+    NS_TEST_ASSERT_MSG_EQ(synchronizer->GetSleepOvershoot(),
+                          Time(0),
+                          "The overshoot should not be calibrated");
+
+    uint64_t delay = MilliSeconds(2).GetTimeStep();
+    bool reached = synchronizer->Synchronize(0, delay);
+    NS_TEST_EXPECT_MSG_EQ(reached, true, "The wait should not be interrupted");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(synchronizer->GetCurrentRealtime(),
+                                delay,
+                                "The wait should not return early");
+    NS_TEST_EXPECT_MSG_GT(synchronizer->GetSleepOvershoot(),
+                          Time(0),
+                          "The sleep should update the overshoot");
+}
+
 /**
  * \ingroup threaded-tests
  *
@@ -315,6 +427,8 @@ class ThreadedSimulatorTestSuite : public TestSuite
                 }
             }
         }
+        AddTestCase(new RealtimeLatenessTestCase, TestCase::QUICK);
+        AddTestCase(new HybridWaitTestCase, TestCase::QUICK);
     }
 };
 
@@ -133,6 +133,80 @@ BasicTracedCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_two, true, "Callback CbTwo not called");
 }
 
+/**
+ * \ingroup tracedcallback-tests
+ *
+ * TracedCallback Test case, check Callbacks connected or disconnected
+ * while the TracedCallback is invoked.
+ */
+class ReentrantTracedCallbackTestCase : public TestCase
+{
+  public:
+    ReentrantTracedCallbackTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Callback which disconnects itself and connects CbAdded().
+     * \param a Parameter.
+     */
+    void CbSwap(uint32_t a);
+    /**
+     * Callback connected by CbSwap().
+     * \param a Parameter.
+     */
+    void CbAdded(uint32_t a);
+
+    TracedCallback<uint32_t> m_trace; //!< The traced callback.
+    uint32_t m_swapped;               //!< Number of calls to CbSwap().
+    uint32_t m_added;                 //!< Number of calls to CbAdded().
+};
+
+ReentrantTracedCallbackTestCase::ReentrantTracedCallbackTestCase()
+    : TestCase("Check TracedCallback modified by its Callbacks")
+{
+}
+
+void
+ReentrantTracedCallbackTestCase::CbSwap(uint32_t /* a */)
+{
+    m_swapped++;
+    m_trace.DisconnectWithoutContext(MakeCallback(&ReentrantTracedCallbackTestCase::CbSwap, this));
+    m_trace.ConnectWithoutContext(MakeCallback(&ReentrantTracedCallbackTestCase::CbAdded, this));
+}
+
+void
+ReentrantTracedCallbackTestCase::CbAdded(uint32_t /* a */)
+{
+    m_added++;
+}
+
+void
+ReentrantTracedCallbackTestCase::DoRun()
+{
+    m_swapped = 0;
+    m_added = 0;
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), true, "New TracedCallback not empty");
+    m_trace(1);
+
+    //
+    // The Callbacks connected or disconnected by a Callback are taken into
+    // account from the next invocation.
+    //
+    m_trace.ConnectWithoutContext(MakeCallback(&ReentrantTracedCallbackTestCase::CbSwap, this));
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), false, "TracedCallback empty after Connect");
+    m_trace(1);
+    NS_TEST_ASSERT_MSG_EQ(m_swapped, 1, "Callback CbSwap not called");
+    NS_TEST_ASSERT_MSG_EQ(m_added, 0, "Callback CbAdded called before being connected");
+    m_trace(2);
+    NS_TEST_ASSERT_MSG_EQ(m_swapped, 1, "Callback CbSwap called after being disconnected");
+    NS_TEST_ASSERT_MSG_EQ(m_added, 1, "Callback CbAdded not called");
+
+    m_trace.DisconnectWithoutContext(MakeCallback(&ReentrantTracedCallbackTestCase::CbAdded, this));
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), true, "TracedCallback not empty");
+}
+
 /**
  * \ingroup tracedcallback-tests
  *
@@ -148,6 +222,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite()
     : TestSuite("traced-callback", UNIT)
 {
     AddTestCase(new BasicTracedCallbackTestCase, TestCase::QUICK);
+    AddTestCase(new ReentrantTracedCallbackTestCase, TestCase::QUICK);
 }
 
 static TracedCallbackTestSuite
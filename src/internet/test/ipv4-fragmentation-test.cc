@@ -140,14 +140,17 @@ class Ipv4FragmentationTest : public TestCase
     uint32_t m_size;            //!< packet size.
     uint8_t m_icmpType;         //!< ICMP type.
     bool m_broadcast;           //!< broadcast packets
+    bool m_scatterGather;       //!< reassemble the packets with scatter-gather bodies
 
   public:
     void DoRun() override;
     /**
      * Constructor
      * \param broadcast send broadcast packets (true) or unicast packets (false)
+     * \param scatterGather enable the scatter-gather packet bodies, see
+     * Packet::EnableScatterGather
      */
-    Ipv4FragmentationTest(bool broadcast);
+    Ipv4FragmentationTest(bool broadcast, bool scatterGather = false);
     ~Ipv4FragmentationTest() override;
 
     // server part
@@ -204,9 +207,10 @@ class Ipv4FragmentationTest : public TestCase
     Ptr<Packet> SendClient();
 };
 
-Ipv4FragmentationTest::Ipv4FragmentationTest(bool broadcast)
+Ipv4FragmentationTest::Ipv4FragmentationTest(bool broadcast, bool scatterGather)
     : TestCase(std::string("Verify the IPv4 layer 3 protocol fragmentation and reassembly: ") +
-               (broadcast ? "broadcast" : "unicast"))
+               (broadcast ? "broadcast" : "unicast") +
+               (scatterGather ? ", with scatter-gather packets" : ""))
 {
     m_socketServer = nullptr;
     m_data = nullptr;
@@ -214,6 +218,7 @@ Ipv4FragmentationTest::Ipv4FragmentationTest(bool broadcast)
     m_size = 0;
     m_icmpType = 0;
     m_broadcast = broadcast;
+    m_scatterGather = scatterGather;
 }
 
 Ipv4FragmentationTest::~Ipv4FragmentationTest()
@@ -365,6 +370,13 @@ Ipv4FragmentationTest::SendClient()
 void
 Ipv4FragmentationTest::DoRun()
 {
+    if (m_scatterGather)
+    {
+        // The fragments are reassembled into segments, which the upper
+        // layers read without copying them into one buffer.
+        Packet::EnableScatterGather();
+    }
+
     // set the arp cache to something quite high
     // we shouldn't need because the NetDevice used doesn't need arp, but still
     Config::SetDefault("ns3::ArpCache::PendingQueueSize", UintegerValue(100));
@@ -573,6 +585,7 @@ Ipv4FragmentationTest::DoRun()
     }
 
     Simulator::Destroy();
+    Packet::DisableScatterGather();
 }
 
 /**
@@ -591,6 +604,7 @@ Ipv4FragmentationTestSuite::Ipv4FragmentationTestSuite()
 {
     AddTestCase(new Ipv4FragmentationTest(false), TestCase::QUICK);
     AddTestCase(new Ipv4FragmentationTest(true), TestCase::QUICK);
+    AddTestCase(new Ipv4FragmentationTest(false, true), TestCase::QUICK);
 }
 
 static Ipv4FragmentationTestSuite
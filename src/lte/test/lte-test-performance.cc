@@ -0,0 +1,144 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/eps-bearer.h"
+#include "ns3/lte-helper.h"
+#include "ns3/lte-ue-net-device.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/radio-bearer-stats-calculator.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <chrono>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Measure the speed of the simulation of a single LTE cell.
+ *
+ * The UEs attach to the eNB with the ideal RRC, and a saturated data
+ * radio bearer of each UE carries traffic in both directions.
+ */
+class LteSingleCellPerformanceTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Create the test
+     *
+     * \param ues The number of UEs.
+     * \param duration The simulated time.
+     */
+    LteSingleCellPerformanceTestCase(uint32_t ues, Time duration);
+
+  private:
+    void DoRun() override;
+
+    uint32_t m_ues;  //!< The number of UEs.
+    Time m_duration; //!< The simulated time.
+};
+
+LteSingleCellPerformanceTestCase::LteSingleCellPerformanceTestCase(uint32_t ues, Time duration)
+    : TestCase("Single cell of " + std::to_string(ues) + " UEs"),
+      m_ues(ues),
+      m_duration(duration)
+{
+}
+
+void
+LteSingleCellPerformanceTestCase::DoRun()
+{
+    Config::SetDefault("ns3::LteHelper::UseIdealRrc", BooleanValue(true));
+    Config::SetDefault("ns3::RadioBearerStatsCalculator::DlRlcOutputFilename",
+                       StringValue(CreateTempDirFilename("DlRlcStats.txt")));
+    Config::SetDefault("ns3::RadioBearerStatsCalculator::UlRlcOutputFilename",
+                       StringValue(CreateTempDirFilename("UlRlcStats.txt")));
+
+    Ptr<LteHelper> lteHelper = CreateObject<LteHelper>();
+    lteHelper->SetAttribute("PathlossModel", StringValue("ns3::FriisSpectrumPropagationLossModel"));
+
+    NodeContainer enbNodes(1);
+    NodeContainer ueNodes(m_ues);
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(enbNodes);
+    mobility.Install(ueNodes);
+    for (uint32_t i = 0; i < m_ues; ++i)
+    {
+        ueNodes.Get(i)->GetObject<ConstantPositionMobilityModel>()->SetPosition(
+            Vector(100.0 * (i + 1), 0.0, 0.0));
+    }
+
+    NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice(enbNodes);
+    NetDeviceContainer ueDevs = lteHelper->InstallUeDevice(ueNodes);
+    lteHelper->Attach(ueDevs, enbDevs.Get(0));
+    lteHelper->ActivateDataRadioBearer(ueDevs, EpsBearer(EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+
+    // Count the bytes received after the connection establishment.
+    Time statsStart = MilliSeconds(300);
+    lteHelper->EnableRlcTraces();
+    Ptr<RadioBearerStatsCalculator> rlcStats = lteHelper->GetRlcStats();
+    rlcStats->SetAttribute("StartTime", TimeValue(statsStart));
+    rlcStats->SetAttribute("EpochDuration", TimeValue(m_duration - statsStart));
+
+    Simulator::Stop(m_duration - NanoSeconds(1));
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t events = Simulator::GetEventCount();
+
+    for (uint32_t i = 0; i < m_ues; ++i)
+    {
+        uint64_t imsi = ueDevs.Get(i)->GetObject<LteUeNetDevice>()->GetImsi();
+        // The first data radio bearer
+        uint8_t lcid = 3;
+        NS_TEST_EXPECT_MSG_GT(rlcStats->GetDlRxData(imsi, lcid), 0, "No downlink data");
+        NS_TEST_EXPECT_MSG_GT(rlcStats->GetUlRxData(imsi, lcid), 0, "No uplink data");
+    }
+    Simulator::Destroy();
+
+    ReportMetric("events", events / elapsed.count(), "events/s");
+    // An LTE subframe lasts 1 ms.
+    ReportMetric("subframes", m_duration.GetMilliSeconds() / elapsed.count(), "subframes/s");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief TestSuite for the speed of the LTE model
+ */
+class LtePerformanceTestSuite : public TestSuite
+{
+  public:
+    LtePerformanceTestSuite();
+};
+
+LtePerformanceTestSuite::LtePerformanceTestSuite()
+    : TestSuite("lte-performance", PERFORMANCE)
+{
+    AddTestCase(new LteSingleCellPerformanceTestCase(4, Seconds(1)), TestCase::QUICK);
+}
+
+static LtePerformanceTestSuite g_ltePerformanceTestSuite; //!< the test suite
@@ -0,0 +1,135 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup mtp
+ *
+ * Packets forwarded around a ring of point-to-point links, to compare
+ * the run time of the multithreaded and of the default simulator.
+ *
+ * \code
+ *   ./ns3 run "mtp-ring --nodes=1024 --threads=8"
+ *   ./ns3 run "mtp-ring --nodes=1024 --threads=0 --mtp=false"
+ * \endcode
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <chrono>
+#include <iostream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("MtpRing");
+
+/**
+ * Forward a received packet to the next node of the ring.
+ *
+ * \param [in] next The device to the next node.
+ * \param [in] device The receiving device.
+ * \param [in] packet The packet.
+ * \param [in] protocol The protocol number.
+ * \param [in] from The sender address.
+ * \return Always true.
+ */
+static bool
+Forward(Ptr<NetDevice> next,
+        Ptr<NetDevice> device,
+        Ptr<const Packet> packet,
+        uint16_t protocol,
+        const Address& from)
+{
+    next->Send(packet->Copy(), next->GetBroadcast(), protocol);
+    return true;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nNodes = 256;
+    uint32_t nPackets = 4;
+    uint32_t threads = 0;
+    bool mtp = true;
+    Time stopTime = MilliSeconds(10);
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("nodes", "Number of nodes in the ring", nNodes);
+    cmd.AddValue("packets", "Number of packets sent by every node", nPackets);
+    cmd.AddValue("threads", "Number of threads (0 for all hardware threads)", threads);
+    cmd.AddValue("mtp", "Use the multithreaded simulator", mtp);
+    cmd.AddValue("stop", "Simulation stop time", stopTime);
+    cmd.Parse(argc, argv);
+
+    if (mtp)
+    {
+        GlobalValue::Bind("SimulatorImplementationType",
+                          StringValue("ns3::MultithreadedSimulatorImpl"));
+        Config::SetDefault("ns3::MultithreadedSimulatorImpl::ThreadCount",
+                           UintegerValue(threads));
+    }
+
+    NodeContainer nodes;
+    nodes.Create(nNodes);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("10Gbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("10us"));
+
+    std::vector<NetDeviceContainer> links;
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        links.push_back(p2p.Install(nodes.Get(i), nodes.Get((i + 1) % nNodes)));
+    }
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        Ptr<NetDevice> rx = links[i].Get(1);
+        Ptr<NetDevice> next = links[(i + 1) % nNodes].Get(0);
+        rx->SetReceiveCallback(MakeBoundCallback(&Forward, next));
+        for (uint32_t j = 0; j < nPackets; ++j)
+        {
+            Ptr<NetDevice> tx = links[i].Get(0);
+            Simulator::ScheduleWithContext(i,
+                                           MicroSeconds(j),
+                                           &NetDevice::Send,
+                                           tx,
+                                           Create<Packet>(1000),
+                                           tx->GetBroadcast(),
+                                           0x800);
+        }
+    }
+
+    Simulator::Stop(stopTime);
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "events: " << Simulator::GetEventCount() << std::endl;
+    Ptr<MultithreadedSimulatorImpl> impl =
+        DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+    if (impl)
+    {
+        std::cout << "threads: " << impl->GetThreadCount() << std::endl;
+        std::cout << "windows: " << impl->GetWindowCount() << std::endl;
+    }
+    std::cout << "wall time: " << std::chrono::duration<double>(end - start).count() << " s"
+              << std::endl;
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,813 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/channel-list.h"
+#include "ns3/channel.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/type-id.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup mtp
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+thread_local MultithreadedSimulatorImpl::LogicalProcess* MultithreadedSimulatorImpl::g_current =
+    nullptr;
+
+/** Timestamp used for an empty event list or an infinite lookahead. */
+static const uint64_t MAX_TS = std::numeric_limits<uint64_t>::max();
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Mtp")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("ThreadCount",
+                          "Number of threads running the simulation "
+                          "(0 uses all hardware threads).",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_threadCount),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("LookAhead",
+                          "Lookahead between logical processes "
+                          "(0 computes it from the channel delays).",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&MultithreadedSimulatorImpl::m_requestedLookAhead),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("MinLookAhead",
+                          "Channels with a smaller delay never connect two logical processes.",
+                          TimeValue(MicroSeconds(1)),
+                          MakeTimeAccessor(&MultithreadedSimulatorImpl::m_minLookAhead),
+                          MakeTimeChecker(Seconds(0)));
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+    auto global = std::make_unique<LogicalProcess>();
+    global->index = 0;
+    global->uid = EventId::UID::VALID;
+    global->currentUid = EventId::UID::INVALID;
+    global->currentTs = 0;
+    global->currentContext = Simulator::NO_CONTEXT;
+    global->eventCount = 0;
+    global->unscheduledEvents = 0;
+    global->sequence = 0;
+    m_lps.push_back(std::move(global));
+    m_partitioned = false;
+    m_lookAhead = MAX_TS;
+    m_windowEnd = 0;
+    m_windowCount = 0;
+    m_running = false;
+    m_exit = false;
+    m_stop = false;
+    m_barrierWaiting = 0;
+    m_barrierGeneration = 0;
+    m_mainThreadId = std::this_thread::get_id();
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    ReceiveEvents();
+    for (auto& lp : m_lps)
+    {
+        while (!lp->events->IsEmpty())
+        {
+            Scheduler::Event next = lp->events->RemoveNext();
+            next.impl->Unref();
+        }
+        lp->events = nullptr;
+    }
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+        m_destroyEvents.pop_front();
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    m_schedulerFactory = schedulerFactory;
+    for (auto& lp : m_lps)
+    {
+        Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler>();
+        if (lp->events)
+        {
+            while (!lp->events->IsEmpty())
+            {
+                Scheduler::Event next = lp->events->RemoveNext();
+                scheduler->Insert(next);
+            }
+        }
+        lp->events = scheduler;
+    }
+}
+
+// System ID for non-distributed simulation is always zero
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+MultithreadedSimulatorImpl::LogicalProcess*
+MultithreadedSimulatorImpl::Current() const
+{
+    return g_current != nullptr ? g_current : m_lps[0].get();
+}
+
+MultithreadedSimulatorImpl::LogicalProcess*
+MultithreadedSimulatorImpl::Owner(uint32_t context) const
+{
+    if (context < m_partition.size())
+    {
+        return m_lps[m_partition[context]].get();
+    }
+    return m_lps[0].get();
+}
+
+Scheduler::Event
+MultithreadedSimulatorImpl::Insert(LogicalProcess* lp,
+                                   uint64_t ts,
+                                   uint32_t context,
+                                   EventImpl* event)
+{
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = ts;
+    ev.key.m_context = context;
+    ev.key.m_uid = lp->uid;
+    lp->uid++;
+    lp->unscheduledEvents++;
+    lp->events->Insert(ev);
+    return ev;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::NextTs(const LogicalProcess* lp) const
+{
+    if (lp->events->IsEmpty())
+    {
+        return MAX_TS;
+    }
+    return lp->events->PeekNext().key.m_ts;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent(LogicalProcess* lp)
+{
+    Scheduler::Event next = lp->events->RemoveNext();
+
+    PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
+
+    NS_ASSERT(next.key.m_ts >= lp->currentTs);
+    lp->unscheduledEvents--;
+    lp->eventCount++;
+
+    NS_LOG_LOGIC("handle " << next.key.m_ts);
+    lp->currentTs = next.key.m_ts;
+    lp->currentContext = next.key.m_context;
+    lp->currentUid = next.key.m_uid;
+    next.impl->Invoke();
+    next.impl->Unref();
+}
+
+void
+MultithreadedSimulatorImpl::ProcessWindow(LogicalProcess* lp)
+{
+    while (!lp->events->IsEmpty() && lp->events->PeekNext().key.m_ts < m_windowEnd)
+    {
+        ProcessOneEvent(lp);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ReceiveEvents()
+{
+    for (auto& lp : m_lps)
+    {
+        std::vector<RemoteEvent> inbox;
+        {
+            std::unique_lock lock{lp->inboxMutex};
+            lp->inbox.swap(inbox);
+        }
+        // The order in which the threads filled the inbox is random:
+        // sort the events so that uids, hence ties, are deterministic.
+        std::sort(inbox.begin(), inbox.end(), [](const RemoteEvent& a, const RemoteEvent& b) {
+            if (a.ev.key.m_ts != b.ev.key.m_ts)
+            {
+                return a.ev.key.m_ts < b.ev.key.m_ts;
+            }
+            if (a.source != b.source)
+            {
+                return a.source < b.source;
+            }
+            return a.sequence < b.sequence;
+        });
+        for (auto& remote : inbox)
+        {
+            remote.ev.key.m_uid = lp->uid;
+            lp->uid++;
+            lp->unscheduledEvents++;
+            lp->events->Insert(remote.ev);
+        }
+    }
+
+    std::vector<ForeignEvent> foreignEvents;
+    {
+        std::unique_lock lock{m_foreignEventsMutex};
+        m_foreignEvents.swap(foreignEvents);
+    }
+    for (const auto& foreign : foreignEvents)
+    {
+        Insert(Owner(foreign.context), m_windowEnd + foreign.delay, foreign.context, foreign.event);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Partition()
+{
+    NS_LOG_FUNCTION(this);
+    LogicalProcess* global = m_lps[0].get();
+
+    // Group the nodes which cannot be separated with a union-find.
+    uint32_t nNodes = NodeList::GetNNodes();
+    std::vector<uint32_t> parent(nNodes);
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        parent[i] = i;
+    }
+    auto find = [&parent](uint32_t n) {
+        while (parent[n] != n)
+        {
+            parent[n] = parent[parent[n]];
+            n = parent[n];
+        }
+        return n;
+    };
+
+    std::vector<std::pair<std::vector<uint32_t>, Time>> cuts;
+    for (auto i = ChannelList::Begin(); i != ChannelList::End(); ++i)
+    {
+        Ptr<Channel> channel = *i;
+        std::vector<uint32_t> nodes;
+        for (std::size_t j = 0; j < channel->GetNDevices(); ++j)
+        {
+            Ptr<NetDevice> device = channel->GetDevice(j);
+            if (device && device->GetNode())
+            {
+                nodes.push_back(device->GetNode()->GetId());
+            }
+        }
+        if (nodes.size() < 2)
+        {
+            continue;
+        }
+        TimeValue delay;
+        if (channel->GetAttributeFailSafe("Delay", delay) && delay.Get().IsStrictlyPositive() &&
+            delay.Get() >= m_minLookAhead)
+        {
+            cuts.emplace_back(nodes, delay.Get());
+            continue;
+        }
+        NS_LOG_LOGIC("channel " << channel->GetId() << " cannot be cut");
+        for (std::size_t j = 1; j < nodes.size(); ++j)
+        {
+            parent[find(nodes[j])] = find(nodes[0]);
+        }
+    }
+
+    // Spread the groups over the threads, largest first.
+    std::vector<uint32_t> groupSize(nNodes, 0);
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        groupSize[find(i)]++;
+    }
+    std::vector<uint32_t> groups;
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        if (groupSize[i] > 0)
+        {
+            groups.push_back(i);
+        }
+    }
+    std::stable_sort(groups.begin(), groups.end(), [&groupSize](uint32_t a, uint32_t b) {
+        return groupSize[a] > groupSize[b];
+    });
+
+    uint32_t nThreads = m_threadCount;
+    if (nThreads == 0)
+    {
+        nThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    nThreads = std::max<uint32_t>(std::min<std::size_t>(nThreads, groups.size()), 1);
+
+    std::vector<uint32_t> load(nThreads, 0);
+    std::vector<uint32_t> groupPartition(nNodes, 0);
+    for (uint32_t group : groups)
+    {
+        auto lightest = std::min_element(load.begin(), load.end()) - load.begin();
+        groupPartition[group] = lightest + 1;
+        load[lightest] += groupSize[group];
+    }
+    m_partition.resize(nNodes);
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        m_partition[i] = groupPartition[find(i)];
+    }
+
+    // The lookahead is the smallest delay of the channels which were cut.
+    m_lookAhead = MAX_TS;
+    if (m_requestedLookAhead.IsStrictlyPositive())
+    {
+        m_lookAhead = m_requestedLookAhead.GetTimeStep();
+    }
+    else
+    {
+        for (const auto& cut : cuts)
+        {
+            for (uint32_t node : cut.first)
+            {
+                if (m_partition[node] != m_partition[cut.first[0]])
+                {
+                    m_lookAhead = std::min<uint64_t>(m_lookAhead, cut.second.GetTimeStep());
+                    break;
+                }
+            }
+        }
+    }
+
+    for (uint32_t i = 1; i <= nThreads; ++i)
+    {
+        auto lp = std::make_unique<LogicalProcess>();
+        lp->index = i;
+        lp->events = m_schedulerFactory.Create<Scheduler>();
+        lp->uid = global->uid;
+        lp->currentUid = EventId::UID::INVALID;
+        lp->currentTs = global->currentTs;
+        lp->currentContext = Simulator::NO_CONTEXT;
+        lp->eventCount = 0;
+        lp->unscheduledEvents = 0;
+        lp->sequence = 0;
+        m_lps.push_back(std::move(lp));
+    }
+
+    // Hand the events scheduled so far over to their logical process,
+    // keeping their uids which are unique across all of them.
+    std::vector<Scheduler::Event> events;
+    while (!global->events->IsEmpty())
+    {
+        events.push_back(global->events->RemoveNext());
+    }
+    global->events = m_schedulerFactory.Create<Scheduler>();
+    global->unscheduledEvents = 0;
+    for (auto i = events.rbegin(); i != events.rend(); ++i)
+    {
+        LogicalProcess* lp = Owner(i->key.m_context);
+        lp->unscheduledEvents++;
+        lp->events->Insert(*i);
+    }
+
+    m_windowEnd = global->currentTs;
+    m_partitioned = true;
+    NS_LOG_INFO(nNodes << " nodes in " << groups.size() << " groups on " << nThreads
+                       << " threads, lookahead " << TimeStep(m_lookAhead));
+}
+
+void
+MultithreadedSimulatorImpl::Synchronize()
+{
+    std::unique_lock lock{m_barrierMutex};
+    uint64_t generation = m_barrierGeneration;
+    m_barrierWaiting++;
+    if (m_barrierWaiting == m_lps.size() - 1)
+    {
+        m_barrierWaiting = 0;
+        m_barrierGeneration++;
+        m_barrierCondition.notify_all();
+    }
+    else
+    {
+        m_barrierCondition.wait(lock, [this, generation] {
+            return generation != m_barrierGeneration;
+        });
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ThreadMain(uint32_t index)
+{
+    LogicalProcess* lp = m_lps[index].get();
+    g_current = lp;
+    while (true)
+    {
+        Synchronize();
+        if (m_exit)
+        {
+            break;
+        }
+        ProcessWindow(lp);
+        Synchronize();
+    }
+    g_current = nullptr;
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    if (m_stop)
+    {
+        return true;
+    }
+    for (const auto& lp : m_lps)
+    {
+        if (!lp->events->IsEmpty())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    // Set the current threadId as the main threadId
+    m_mainThreadId = std::this_thread::get_id();
+    if (!m_partitioned)
+    {
+        Partition();
+    }
+    m_stop = false;
+    m_exit = false;
+    m_running = true;
+
+    // The TypeIds registered by the modules are created on first use,
+    // which is not thread safe: create them all before the threads start.
+    TypeId::GetRegisteredN();
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 2; i < m_lps.size(); ++i)
+    {
+        threads.emplace_back(&MultithreadedSimulatorImpl::ThreadMain, this, i);
+    }
+
+    LogicalProcess* global = m_lps[0].get();
+    while (true)
+    {
+        // All other threads are waiting: run the global events
+        // up to the next local event.
+        g_current = global;
+        ReceiveEvents();
+        uint64_t next = MAX_TS;
+        while (true)
+        {
+            next = MAX_TS;
+            for (uint32_t i = 1; i < m_lps.size(); ++i)
+            {
+                next = std::min(next, NextTs(m_lps[i].get()));
+            }
+            if (m_stop || global->events->IsEmpty() || NextTs(global) > next)
+            {
+                break;
+            }
+            ProcessOneEvent(global);
+        }
+        if (m_stop || next == MAX_TS)
+        {
+            break;
+        }
+
+        m_windowEnd = next + std::min(m_lookAhead, MAX_TS - next);
+        m_windowEnd = std::min(m_windowEnd, NextTs(global));
+        m_windowCount++;
+
+        Synchronize();
+        g_current = m_lps[1].get();
+        ProcessWindow(m_lps[1].get());
+        Synchronize();
+    }
+
+    m_exit = true;
+    Synchronize();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ReceiveEvents();
+    g_current = nullptr;
+    m_running = false;
+
+    for (const auto& lp : m_lps)
+    {
+        global->currentTs = std::max(global->currentTs, lp->currentTs);
+    }
+
+#ifdef NS3_ASSERT_ENABLE
+    // If the simulator stopped naturally by lack of events, make a
+    // consistency test to check that we didn't lose any events along the way.
+    bool allUnscheduled = std::all_of(m_lps.begin(), m_lps.end(), [](const auto& lp) {
+        return lp->unscheduledEvents == 0;
+    });
+    NS_ASSERT(!IsFinished() || m_stop || GetEventCount() == 0 || allUnscheduled);
+#endif
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stop = true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    Simulator::Schedule(delay, &Simulator::Stop);
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep() << event);
+    NS_ASSERT_MSG(g_current != nullptr || m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::Schedule Thread-unsafe invocation!");
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+
+    LogicalProcess* lp = Current();
+    Scheduler::Event ev =
+        Insert(lp, lp->currentTs + delay.GetTimeStep(), lp->currentContext, event);
+    return EventId(event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
+
+    if (g_current == nullptr && m_running)
+    {
+        // Not a simulation thread: the event is inserted at the end of
+        // the current window.
+        std::unique_lock lock{m_foreignEventsMutex};
+        m_foreignEvents.push_back({context, static_cast<uint64_t>(delay.GetTimeStep()), event});
+        return;
+    }
+
+    LogicalProcess* source = Current();
+    LogicalProcess* target = Owner(context);
+    uint64_t ts = source->currentTs + delay.GetTimeStep();
+    if (target == source || !m_running || source->index == 0)
+    {
+        // Same thread, or all other threads are waiting.
+        Insert(target, ts, context, event);
+        return;
+    }
+
+    NS_ABORT_MSG_IF(ts < m_windowEnd,
+                    "Event for context " << context << " scheduled at " << TimeStep(ts)
+                                         << " within the current window which ends at "
+                                         << TimeStep(m_windowEnd) << ": delay " << delay
+                                         << " is shorter than the lookahead "
+                                         << TimeStep(m_lookAhead));
+    RemoteEvent remote;
+    remote.ev.impl = event;
+    remote.ev.key.m_ts = ts;
+    remote.ev.key.m_context = context;
+    remote.ev.key.m_uid = 0;
+    remote.source = source->index;
+    remote.sequence = source->sequence;
+    source->sequence++;
+    std::unique_lock lock{target->inboxMutex};
+    target->inbox.push_back(remote);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    NS_ASSERT_MSG(m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::ScheduleDestroy Thread-unsafe invocation!");
+
+    EventId id(Ptr<EventImpl>(event, false), Current()->currentTs, 0xffffffff, 2);
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return TimeStep(Current()->currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    else
+    {
+        return TimeStep(id.GetTs() - Owner(id.GetContext())->currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    if (IsExpired(id))
+    {
+        return;
+    }
+    LogicalProcess* lp = Owner(id.GetContext());
+    NS_ASSERT_MSG(lp == Current() || !m_running || Current()->index == 0,
+                  "Simulator::Remove of an event of another logical process");
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    lp->events->Remove(event);
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+
+    lp->unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    const LogicalProcess* lp = Owner(id.GetContext());
+    if (id.PeekEventImpl() == nullptr || id.GetTs() < lp->currentTs ||
+        (id.GetTs() == lp->currentTs && id.GetUid() <= lp->currentUid) ||
+        id.PeekEventImpl()->IsCancelled())
+    {
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    return Current()->currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    uint64_t eventCount = 0;
+    for (const auto& lp : m_lps)
+    {
+        eventCount += lp->eventCount;
+    }
+    return eventCount;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetThreadCount() const
+{
+    return m_lps.size() - 1;
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookAhead() const
+{
+    return m_lookAhead == MAX_TS ? GetMaximumSimulationTime() : TimeStep(m_lookAhead);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition(uint32_t context) const
+{
+    return Owner(context)->index;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetWindowCount() const
+{
+    return m_windowCount;
+}
+
+} // namespace ns3
@@ -0,0 +1,287 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/event-impl.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/scheduler.h"
+#include "ns3/simulator-impl.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mtp
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+/**
+ * \defgroup mtp Multithreaded Simulation
+ *
+ * Conservative parallel simulation on the threads of a single process.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup mtp
+ *
+ * \brief Conservative parallel simulator running on multiple threads.
+ *
+ * The nodes of the simulation are partitioned into logical processes
+ * (LPs), each with its own event list, and every LP is run by its own
+ * thread.  The partition is computed from the channels when Run() is
+ * first called: nodes joined by a channel whose \c Delay attribute is
+ * smaller than \c MinLookAhead (or which has no such attribute) are
+ * always placed in the same LP, and the resulting groups are spread
+ * over \c ThreadCount LPs.  The lookahead is the smallest delay of the
+ * channels which cross LPs, unless set with the \c LookAhead attribute.
+ *
+ * The LPs advance in lock-step windows: every window ends at most one
+ * lookahead after the earliest pending event, so no event scheduled
+ * by one LP for another can fall inside the current window.  Such
+ * events are passed between threads as plain EventImpl pointers and
+ * are inserted in a deterministic order at the end of the window.
+ *
+ * Events without a node context (\c Simulator::NO_CONTEXT, typically
+ * scheduled from the main program) belong to a global LP which is run
+ * by the main thread between windows, while all other LPs are idle.
+ *
+ * Events scheduled by one node for another node must use
+ * Simulator::ScheduleWithContext with a delay of at least the lookahead;
+ * this is what all channels already do.  Models must not otherwise share
+ * mutable state between nodes in different LPs.  ns-3 has to be
+ * configured with \c --enable-mtp, which makes reference counting and
+ * packet buffers thread-safe; packet printing (Packet::EnablePrinting)
+ * is not supported.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    void Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * Get the number of threads used to run the simulation.
+     *
+     * Only valid once Run() has been called.
+     *
+     * \return The number of threads.
+     */
+    uint32_t GetThreadCount() const;
+    /**
+     * Get the lookahead used to compute the synchronization windows.
+     *
+     * Only valid once Run() has been called.
+     *
+     * \return The lookahead.
+     */
+    Time GetLookAhead() const;
+    /**
+     * Get the logical process which runs the events of a context.
+     *
+     * Only valid once Run() has been called.
+     *
+     * \param [in] context The context (node id).
+     * \return The logical process, 0 being the global one.
+     */
+    uint32_t GetPartition(uint32_t context) const;
+    /**
+     * Get the number of synchronization windows run so far.
+     *
+     * \return The number of windows.
+     */
+    uint64_t GetWindowCount() const;
+
+  private:
+    void DoDispose() override;
+
+    /** An event sent by another logical process. */
+    struct RemoteEvent
+    {
+        Scheduler::Event ev; //!< The event; the uid is assigned on receipt.
+        uint32_t source;     //!< The sending logical process.
+        uint64_t sequence;   //!< The sequence number at the sender.
+    };
+
+    /** An event sent by a thread which is not part of the simulation. */
+    struct ForeignEvent
+    {
+        uint32_t context; //!< The event context.
+        uint64_t delay;   //!< The delay, relative to the end of the current window.
+        EventImpl* event; //!< The event implementation.
+    };
+
+    /** A logical process: a set of contexts with their own event list. */
+    struct LogicalProcess
+    {
+        uint32_t index;                 //!< Index of this LP.
+        Ptr<Scheduler> events;          //!< The event priority queue.
+        uint32_t uid;                   //!< Next event unique id.
+        uint32_t currentUid;            //!< Unique id of the current event.
+        uint64_t currentTs;             //!< Timestamp of the current event.
+        uint32_t currentContext;        //!< Execution context of the current event.
+        uint64_t eventCount;            //!< The event count.
+        int unscheduledEvents;          //!< Number of events in the event list.
+        uint64_t sequence;              //!< Number of events sent to other LPs.
+        std::mutex inboxMutex;          //!< Mutex protecting the inbox.
+        std::vector<RemoteEvent> inbox; //!< Events sent by other LPs.
+    };
+
+    /**
+     * Get the logical process of the calling thread.
+     * \return The logical process, the global one outside of Run().
+     */
+    LogicalProcess* Current() const;
+    /**
+     * Get the logical process which owns a context.
+     * \param [in] context The context.
+     * \return The logical process.
+     */
+    LogicalProcess* Owner(uint32_t context) const;
+    /**
+     * Insert an event into a logical process.
+     * \param [in] lp The logical process.
+     * \param [in] ts The absolute event timestamp.
+     * \param [in] context The event context.
+     * \param [in] event The event implementation.
+     * \return The scheduler event.
+     */
+    Scheduler::Event Insert(LogicalProcess* lp, uint64_t ts, uint32_t context, EventImpl* event);
+    /**
+     * Get the timestamp of the next event of a logical process.
+     * \param [in] lp The logical process.
+     * \return The timestamp, or the maximum time if the LP has no events.
+     */
+    uint64_t NextTs(const LogicalProcess* lp) const;
+    /**
+     * Process the next event of a logical process.
+     * \param [in] lp The logical process.
+     */
+    void ProcessOneEvent(LogicalProcess* lp);
+    /**
+     * Process all the events of a logical process in the current window.
+     * \param [in] lp The logical process.
+     */
+    void ProcessWindow(LogicalProcess* lp);
+    /** Move the events sent to all logical processes into their event lists. */
+    void ReceiveEvents();
+    /** Partition the nodes into logical processes and compute the lookahead. */
+    void Partition();
+    /** Wait until all the threads running the simulation reach this point. */
+    void Synchronize();
+    /**
+     * Main function of the worker threads.
+     * \param [in] index The logical process run by this thread.
+     */
+    void ThreadMain(uint32_t index);
+
+    /** The logical processes; 0 is the global one. */
+    std::vector<std::unique_ptr<LogicalProcess>> m_lps;
+    /** The logical process of each context (node id). */
+    std::vector<uint32_t> m_partition;
+    /** Whether the partition has been computed. */
+    bool m_partitioned;
+    /** Factory of the event lists. */
+    ObjectFactory m_schedulerFactory;
+
+    /** Number of threads requested, 0 for all hardware threads. */
+    uint32_t m_threadCount;
+    /** Lookahead requested, 0 to compute it from the channels. */
+    Time m_requestedLookAhead;
+    /** Channels with a smaller delay are never cut. */
+    Time m_minLookAhead;
+    /** The lookahead in time steps. */
+    uint64_t m_lookAhead;
+
+    /** End (excluded) of the current window. */
+    uint64_t m_windowEnd;
+    /** Number of windows run. */
+    uint64_t m_windowCount;
+    /** Whether the simulation is running. */
+    bool m_running;
+    /** Flag calling for the worker threads to exit. */
+    bool m_exit;
+    /** Flag calling for the end of the simulation. */
+    std::atomic<bool> m_stop;
+
+    /** Mutex of the thread barrier. */
+    std::mutex m_barrierMutex;
+    /** Condition of the thread barrier. */
+    std::condition_variable m_barrierCondition;
+    /** Number of threads waiting at the barrier. */
+    uint32_t m_barrierWaiting;
+    /** Generation of the barrier, incremented when all threads reached it. */
+    uint64_t m_barrierGeneration;
+
+    /** Events sent by threads which are not part of the simulation. */
+    std::vector<ForeignEvent> m_foreignEvents;
+    /** Mutex protecting the foreign events. */
+    std::mutex m_foreignEventsMutex;
+
+    /** Container type for the events to run at Simulator::Destroy() */
+    typedef std::list<EventId> DestroyEvents;
+    /** The container of events to run at Destroy. */
+    DestroyEvents m_destroyEvents;
+
+    /** Main execution thread. */
+    std::thread::id m_mainThreadId;
+
+    /** The logical process run by the current thread, if any. */
+    static thread_local LogicalProcess* g_current;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
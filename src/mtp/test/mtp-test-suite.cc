@@ -0,0 +1,206 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/mac48-address.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/node-container.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mtp-tests
+ * Multithreaded simulator test suite.
+ */
+
+/**
+ * \ingroup mtp
+ * \defgroup mtp-tests Multithreaded simulation tests
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup mtp-tests
+ *
+ * Packets forwarded around a ring of nodes give the same receive
+ * times with the multithreaded and the default simulator.
+ */
+class MtpRingTestCase : public TestCase
+{
+  public:
+    MtpRingTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run the ring scenario.
+     * \param [in] impl The simulator implementation type.
+     * \param [in] threads The number of threads.
+     * \param [in] fastLink The index of a link with a zero delay.
+     * \return The receive times of each node.
+     */
+    std::vector<std::vector<int64_t>> RunRing(std::string impl,
+                                              uint32_t threads,
+                                              uint32_t fastLink);
+    /**
+     * Receive a packet and forward it to the next node.
+     * \param [in] node The node index.
+     * \param [in] device The receiving device.
+     * \param [in] packet The packet.
+     * \param [in] protocol The protocol number.
+     * \param [in] from The sender address.
+     * \return Always true.
+     */
+    bool Receive(uint32_t node,
+                 Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+
+    /** Number of nodes in the ring. */
+    static const uint32_t N_NODES = 16;
+
+    std::vector<Ptr<SimpleNetDevice>> m_next;     //!< Device to the next node.
+    std::vector<std::vector<int64_t>> m_received; //!< Receive times of each node.
+};
+
+MtpRingTestCase::MtpRingTestCase()
+    : TestCase("Check that a ring of nodes runs like with the default simulator")
+{
+}
+
+bool
+MtpRingTestCase::Receive(uint32_t node,
+                         Ptr<NetDevice> device,
+                         Ptr<const Packet> packet,
+                         uint16_t protocol,
+                         const Address& from)
+{
+    m_received[node].push_back(Simulator::Now().GetTimeStep());
+    if (Simulator::Now() < MilliSeconds(50))
+    {
+        m_next[node]->Send(packet->Copy(), m_next[node]->GetBroadcast(), protocol);
+    }
+    return true;
+}
+
+std::vector<std::vector<int64_t>>
+MtpRingTestCase::RunRing(std::string impl, uint32_t threads, uint32_t fastLink)
+{
+    ObjectFactory factory;
+    factory.SetTypeId(impl);
+    if (threads > 0)
+    {
+        factory.Set("ThreadCount", UintegerValue(threads));
+    }
+    Simulator::SetImplementation(factory.Create<SimulatorImpl>());
+
+    NodeContainer nodes;
+    nodes.Create(N_NODES);
+    m_next.assign(N_NODES, nullptr);
+    m_received.assign(N_NODES, {});
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+        channel->SetAttribute("Delay", TimeValue(i == fastLink ? Seconds(0) : MicroSeconds(100)));
+        Ptr<SimpleNetDevice> tx = CreateObject<SimpleNetDevice>();
+        tx->SetAddress(Mac48Address::Allocate());
+        tx->SetChannel(channel);
+        nodes.Get(i)->AddDevice(tx);
+        Ptr<SimpleNetDevice> rx = CreateObject<SimpleNetDevice>();
+        rx->SetAddress(Mac48Address::Allocate());
+        rx->SetChannel(channel);
+        Ptr<Node> next = nodes.Get((i + 1) % N_NODES);
+        next->AddDevice(rx);
+        rx->SetReceiveCallback(
+            MakeCallback(&MtpRingTestCase::Receive, this).Bind((i + 1) % N_NODES));
+        m_next[i] = tx;
+
+        Simulator::ScheduleWithContext(i,
+                                       MicroSeconds(7 * i),
+                                       &SimpleNetDevice::Send,
+                                       tx,
+                                       Create<Packet>(100 + i),
+                                       tx->GetBroadcast(),
+                                       0);
+    }
+
+    Simulator::Run();
+
+    Ptr<MultithreadedSimulatorImpl> mtp =
+        DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+    if (mtp)
+    {
+        NS_TEST_EXPECT_MSG_EQ(mtp->GetThreadCount(), threads, "Wrong number of threads");
+        if (threads > 1)
+        {
+            NS_TEST_EXPECT_MSG_EQ(mtp->GetLookAhead(), MicroSeconds(100), "Wrong lookahead");
+        }
+        NS_TEST_EXPECT_MSG_EQ(mtp->GetPartition(fastLink),
+                              mtp->GetPartition((fastLink + 1) % N_NODES),
+                              "Nodes joined by a zero delay channel must not be separated");
+        NS_TEST_EXPECT_MSG_GT(mtp->GetWindowCount(), 0, "No window was run");
+    }
+
+    Simulator::Destroy();
+    m_next.clear();
+    return m_received;
+}
+
+void
+MtpRingTestCase::DoRun()
+{
+    auto expected = RunRing("ns3::DefaultSimulatorImpl", 0, 3);
+    NS_TEST_ASSERT_MSG_EQ(expected[5].empty(), false, "No packet received");
+    for (uint32_t threads : {1, 2, 4})
+    {
+        auto received = RunRing("ns3::MultithreadedSimulatorImpl", threads, 3);
+        for (uint32_t i = 0; i < N_NODES; ++i)
+        {
+            NS_TEST_EXPECT_MSG_EQ((received[i] == expected[i]),
+                                  true,
+                                  "Node " << i << " received at different times with " << threads
+                                          << " threads");
+        }
+    }
+}
+
+/**
+ * \ingroup mtp-tests
+ *
+ * Multithreaded simulator TestSuite
+ */
+class MtpTestSuite : public TestSuite
+{
+  public:
+    MtpTestSuite();
+};
+
+MtpTestSuite::MtpTestSuite()
+    : TestSuite("mtp", UNIT)
+{
+    AddTestCase(new MtpRingTestCase, TestCase::QUICK);
+}
+
+static MtpTestSuite g_mtpTestSuite; //!< Static variable for test initialization
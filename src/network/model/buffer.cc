@@ -20,6 +20,9 @@
 
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/thread-cache.h"
+
+#include <atomic>
 
 #define LOG_INTERNAL_STATE(y)                                                                      \
     NS_LOG_LOGIC(y << "start=" << m_start << ", end=" << m_end                                     \
@@ -54,65 +57,104 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
+#ifdef NS3_MTP
+thread_local uint32_t Buffer::g_recommendedStart = 0;
+#else
 uint32_t Buffer::g_recommendedStart = 0;
+#endif
 #ifdef BUFFER_FREE_LIST
-/* The following macros are pretty evil but they are needed to allow us to
- * keep track of 3 possible states for the g_freeList variable:
- *  - uninitialized means that no one has created a buffer yet
- *    so no one has created the associated free list (it is created
- *    on-demand when the first buffer is created)
- *  - initialized means that the free list exists and is valid
- *  - destroyed means that the static destructors of this compilation unit
- *    have run so, the free list has been cleared from its content
- * The key is that in destroyed state, we are careful not re-create it
- * which is a typical weakness of lazy evaluation schemes which use
- * '0' as a special value to indicate both un-initialized and destroyed.
- * Note that it is important to use '0' as the marker for un-initialized state
- * because the variable holding this state information is initialized to zero
- * which the compiler assigns to zero-memory which is initialized to _zero_
- * before the constructors run so this ensures perfect handling of crazy
- * constructor orderings.
+namespace
+{
+
+/**
+ * \ingroup packet
+ * Capacities of the size classes of buffer data storage.  The last class
+ * holds a jumbo frame with room for its headers; larger storage is not
+ * cached.
+ */
+const uint32_t SIZE_CLASSES[] = {128, 256, 512, 1024, 2048, 4096, 9216};
+/** Number of size classes. */
+const uint32_t N_SIZE_CLASSES = sizeof(SIZE_CLASSES) / sizeof(SIZE_CLASSES[0]);
+
+/**
+ * \ingroup packet
+ * Get the size class of some buffer data storage.
+ * \param [in] size The size of the storage.
+ * \returns The index of the smallest class which holds \p size bytes,
+ *          or N_SIZE_CLASSES if no class is large enough.
  */
-#define MAGIC_DESTROYED (~(long)0)
-#define IS_UNINITIALIZED(x) (x == (Buffer::FreeList*)0)
-#define IS_DESTROYED(x) (x == (Buffer::FreeList*)MAGIC_DESTROYED)
-#define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
-#define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
-#define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList* Buffer::g_freeList = nullptr;
-struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
-
-Buffer::LocalStaticDestructor::~LocalStaticDestructor()
+inline uint32_t
+GetSizeClass(uint32_t size)
 {
-    NS_LOG_FUNCTION(this);
-    if (IS_INITIALIZED(g_freeList))
+    uint32_t sizeClass = 0;
+    while (sizeClass < N_SIZE_CLASSES && SIZE_CLASSES[sizeClass] < size)
     {
-        for (Buffer::FreeList::iterator i = g_freeList->begin(); i != g_freeList->end(); i++)
-        {
-            Buffer::Deallocate(*i);
-        }
-        delete g_freeList;
-        g_freeList = DESTROYED;
+        sizeClass++;
     }
+    return sizeClass;
 }
 
+} // namespace
+
+/**
+ * \ingroup packet
+ * Traits of the cache of buffer data storage: each thread first reuses
+ * the storage it freed itself, without any lock, see ThreadCache.
+ */
+struct Buffer::CacheTraits
+{
+    /// Type of the blocks
+    using Block = Buffer::Data;
+    /// Number of size classes
+    static constexpr uint32_t N_CLASSES = N_SIZE_CLASSES;
+    /// Maximum number of cached storages of each class in a thread cache
+    static constexpr uint32_t THREAD_CACHE_SIZE = 64;
+    /// Number of storages moved at once between a thread cache and the shared cache
+    static constexpr uint32_t BATCH_SIZE = THREAD_CACHE_SIZE / 2;
+    /// Maximum number of cached storages of each class in the shared cache
+    static constexpr uint32_t SHARED_CACHE_SIZE = 1024;
+
+    /**
+     * Allocate storage of a class on the heap.
+     * \param [in] sizeClass The size class.
+     * \returns The storage.
+     */
+    static Buffer::Data* Allocate(uint32_t sizeClass)
+    {
+        return Buffer::Allocate(SIZE_CLASSES[sizeClass]);
+    }
+
+    /**
+     * Free storage on the heap.
+     * \param [in] data The storage.
+     */
+    static void Deallocate(Buffer::Data* data)
+    {
+        Buffer::Deallocate(data);
+    }
+};
+
 void
 Buffer::Recycle(struct Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
-    NS_ASSERT(!IS_UNINITIALIZED(g_freeList));
-    g_maxSize = std::max(g_maxSize, data->m_size);
-    /* feed into free list */
-    if (data->m_size < g_maxSize || IS_DESTROYED(g_freeList) || g_freeList->size() > 1000)
+    uint32_t sizeClass = GetSizeClass(data->m_size);
+    ThreadCache<CacheTraits>* cache = ThreadCache<CacheTraits>::Get();
+    if (cache == nullptr)
     {
         Buffer::Deallocate(data);
     }
+    else if (sizeClass == N_SIZE_CLASSES || data->m_size != SIZE_CLASSES[sizeClass])
+    {
+        // Storage made while the caches were not available may not
+        // have the capacity of its class.
+        Buffer::Deallocate(data);
+        cache->CountRelease();
+    }
     else
     {
-        NS_ASSERT(IS_INITIALIZED(g_freeList));
-        g_freeList->push_back(data);
+        cache->Push(data, sizeClass);
     }
 }
 
@@ -120,35 +162,42 @@ Buffer::Data*
 Buffer::Create(uint32_t dataSize)
 {
     NS_LOG_FUNCTION(dataSize);
-    /* try to find a buffer correctly sized. */
-    if (IS_UNINITIALIZED(g_freeList))
+    uint32_t sizeClass = GetSizeClass(dataSize);
+    ThreadCache<CacheTraits>* cache = ThreadCache<CacheTraits>::Get();
+    if (cache == nullptr)
     {
-        g_freeList = new Buffer::FreeList();
+        return Buffer::Allocate(dataSize);
     }
-    else if (IS_INITIALIZED(g_freeList))
+    if (sizeClass == N_SIZE_CLASSES)
     {
-        while (!g_freeList->empty())
-        {
-            struct Buffer::Data* data = g_freeList->back();
-            g_freeList->pop_back();
-            if (data->m_size >= dataSize)
-            {
-                data->m_count = 1;
-                return data;
-            }
-            Buffer::Deallocate(data);
-        }
+        cache->CountMiss();
+        return Buffer::Allocate(dataSize);
     }
-    struct Buffer::Data* data = Buffer::Allocate(dataSize);
-    NS_ASSERT(data->m_count == 1);
+    Buffer::Data* data = cache->Pop(sizeClass);
+    data->m_count = 1;
     return data;
 }
+
+Buffer::AllocatorStats
+Buffer::GetAllocatorStats()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    ThreadCacheStats stats = ThreadCache<CacheTraits>::GetStats();
+    return {stats.hits, stats.misses, stats.releases};
+}
 #else  /* BUFFER_FREE_LIST */
+namespace
+{
+std::atomic<uint64_t> g_misses{0};   //!< Storage allocated on the heap.
+std::atomic<uint64_t> g_releases{0}; //!< Storage returned to the heap.
+} // namespace
+
 void
 Buffer::Recycle(struct Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
+    g_releases.fetch_add(1, std::memory_order_relaxed);
     Deallocate(data);
 }
 
@@ -156,8 +205,18 @@ Buffer::Data*
 Buffer::Create(uint32_t size)
 {
     NS_LOG_FUNCTION(size);
+    g_misses.fetch_add(1, std::memory_order_relaxed);
     return Allocate(size);
 }
+
+Buffer::AllocatorStats
+Buffer::GetAllocatorStats()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    return {0,
+            g_misses.load(std::memory_order_relaxed),
+            g_releases.load(std::memory_order_relaxed)};
+}
 #endif /* BUFFER_FREE_LIST */
 
 struct Buffer::Data*
@@ -263,8 +322,7 @@ Buffer::operator=(const Buffer& o)
     if (m_data != o.m_data)
     {
         // not assignment to self.
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Recycle(m_data);
         }
@@ -286,8 +344,7 @@ Buffer::~Buffer()
     NS_LOG_FUNCTION(this);
     NS_ASSERT(CheckInternalState());
     g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         Recycle(m_data);
     }
@@ -312,7 +369,12 @@ Buffer::AddAtStart(uint32_t start)
 {
     NS_LOG_FUNCTION(this << start);
     NS_ASSERT(CheckInternalState());
+#ifdef NS3_MTP
+    // another thread may write to the same shared data: never write in place
+    bool isDirty = m_data->m_count > 1;
+#else
     bool isDirty = m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
+#endif
     if (m_start >= start && !isDirty)
     {
         /* enough space in the buffer and not dirty.
@@ -330,8 +392,7 @@ Buffer::AddAtStart(uint32_t start)
         uint32_t newSize = GetInternalSize() + start;
         struct Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data + start, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -358,7 +419,12 @@ Buffer::AddAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
     NS_ASSERT(CheckInternalState());
+#ifdef NS3_MTP
+    // another thread may write to the same shared data: never write in place
+    bool isDirty = m_data->m_count > 1;
+#else
     bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
+#endif
     if (GetInternalEnd() + end <= m_data->m_size && !isDirty)
     {
         /* enough space in buffer and not dirty
@@ -376,8 +442,7 @@ Buffer::AddAtEnd(uint32_t end)
         uint32_t newSize = GetInternalSize() + end;
         struct Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -25,6 +25,11 @@
 #include <stdint.h>
 #include <vector>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
+// Recycle the buffer data storage through per-thread and shared caches.
 #define BUFFER_FREE_LIST 1
 
 namespace ns3
@@ -38,10 +43,10 @@ namespace ns3
  * This represents a buffer of bytes. Its size is
  * automatically adjusted to hold any data prepended
  * or appended by the user. Its implementation is optimized
- * to ensure that the number of buffer resizes is minimized,
- * by creating new Buffers of the maximum size ever used.
- * The correct maximum size is learned at runtime during use by
- * recording the maximum size of each packet.
+ * to ensure that the number of buffer resizes is minimized.
+ * The memory which holds the bytes is rounded up to a few size
+ * classes and recycled through bounded caches of each class, so
+ * that buffers of mixed sizes seldom go back to the heap.
  *
  * \internal
  * The implementation of the Buffer class uses a COW (Copy On Write)
@@ -644,6 +649,26 @@ class Buffer
     Buffer(uint32_t dataSize, bool initialize);
     ~Buffer();
 
+    /**
+     * \brief Statistics of the allocations of buffer data storage.
+     */
+    struct AllocatorStats
+    {
+        uint64_t hits;     //!< Storage reused from a cache.
+        uint64_t misses;   //!< Storage allocated on the heap.
+        uint64_t releases; //!< Storage returned to the heap.
+    };
+
+    /**
+     * \brief Get the statistics of the allocations of buffer data storage
+     * by all the threads since the start of the process.
+     *
+     * Without BUFFER_FREE_LIST, every allocation is a miss.
+     *
+     * \returns The statistics.
+     */
+    static AllocatorStats GetAllocatorStats();
+
   private:
     /**
      * This data structure is variable-sized through its last member whose size
@@ -665,7 +690,11 @@ class Buffer
          * The reference count of an instance of this data structure.
          * Each buffer which references an instance holds a count.
          */
+#ifdef NS3_MTP
+        std::atomic<uint32_t> m_count;
+#else
         uint32_t m_count;
+#endif
         /**
          * the size of the m_data field below.
          */
@@ -767,9 +796,13 @@ class Buffer
     /**
      * location in a newly-allocated buffer where you should start
      * writing data. i.e., m_start should be initialized to this
-     * value.
+     * value.  With NS3_MTP, each thread has its own heuristic.
      */
+#ifdef NS3_MTP
+    static thread_local uint32_t g_recommendedStart;
+#else
     static uint32_t g_recommendedStart;
+#endif
 
     /**
      * offset to the start of the virtual zero area from the start
@@ -793,18 +826,7 @@ class Buffer
     uint32_t m_end;
 
 #ifdef BUFFER_FREE_LIST
-    /// Container for buffer data
-    typedef std::vector<struct Buffer::Data*> FreeList;
-
-    /// Local static destructor structure
-    struct LocalStaticDestructor
-    {
-        ~LocalStaticDestructor();
-    };
-
-    static uint32_t g_maxSize;                            //!< Max observed data size
-    static FreeList* g_freeList;                          //!< Buffer data container
-    static LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
+    struct CacheTraits; //!< Traits of the cache of buffer data storage, see buffer.cc
 #endif
 };
 
@@ -61,6 +61,11 @@ struct ByteTagListData;
  *     the boundaries before returning item. However, when packet is extending,
  *     it calls ByteTagList::AddAtStart or ByteTagList::AddAtEnd to cut byte
  *     tags that will otherwise cover new bytes.
+ *
+ *   - The byte buffer of a list with only a couple of small tags fits in the
+ *     ByteTagList itself, so that tagging a packet does not allocate. Such a
+ *     buffer is copied along with the ByteTagList, rather than shared. It is
+ *     moved to a ByteTagListData when it outgrows #INLINE_SIZE bytes.
  */
 class ByteTagList
 {
@@ -153,6 +158,9 @@ class ByteTagList
         int32_t m_nextEnd;     //!< End of the next tag
     };
 
+    /// The size of the byte buffer stored in the ByteTagList itself
+    static constexpr uint32_t INLINE_SIZE = 48;
+
     ByteTagList();
 
     /**
@@ -270,6 +278,18 @@ class ByteTagList
      */
     ByteTagList::Iterator BeginAll() const;
 
+    /**
+     * Write the header of a new tag at the end of a byte buffer.
+     *
+     * \param data the byte buffer, large enough for the new tag
+     * \param tid the TypeId of the tag
+     * \param bufferSize the size of the serialized tag
+     * \param start offset of the start of the tag
+     * \param end offset of the end of the tag
+     * \returns the TagBuffer to serialize the tag into
+     */
+    TagBuffer AddAt(uint8_t* data, TypeId tid, uint32_t bufferSize, int32_t start, int32_t end);
+
     /**
      * \brief Allocate the memory for the ByteTagListData
      * \param size the memory to allocate
@@ -288,6 +308,7 @@ class ByteTagList
     int32_t m_adjustment;           //!< adjustment to byte tag offsets
     uint32_t m_used;                //!< the number of used bytes in the buffer
     struct ByteTagListData* m_data; //!< the ByteTagListData structure
+    uint8_t m_inline[INLINE_SIZE];  //!< the byte buffer, while #m_data is null
 };
 
 void
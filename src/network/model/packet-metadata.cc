@@ -36,10 +36,16 @@ NS_LOG_COMPONENT_DEFINE("PacketMetadata");
 
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
+#ifdef NS3_MTP
+std::atomic<bool> PacketMetadata::m_metadataSkipped = false;
+thread_local uint32_t PacketMetadata::m_maxSize = 0;
+std::atomic<uint16_t> PacketMetadata::m_chunkUid = 0;
+#else
 bool PacketMetadata::m_metadataSkipped = false;
 uint32_t PacketMetadata::m_maxSize = 0;
 uint16_t PacketMetadata::m_chunkUid = 0;
 PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+#endif
 
 PacketMetadata::DataFreeList::~DataFreeList()
 {
@@ -77,14 +83,22 @@ void
 PacketMetadata::ReserveCopy(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    struct PacketMetadata::Data* newData = PacketMetadata::Create(m_used + size);
-    memcpy(newData->m_data, m_data->m_data, m_used);
-    newData->m_dirtyEnd = m_used;
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    struct PacketMetadata::Data* newData;
+    if (m_used + size <= PACKET_METADATA_INLINE_SIZE && !IsInline())
     {
-        PacketMetadata::Recycle(m_data);
+        // the items of a shared buffer fit in our own inline buffer
+        newData = reinterpret_cast<struct PacketMetadata::Data*>(m_inline);
+        memcpy(newData->m_data, m_data->m_data, m_used);
+        Release();
+        CreateInline();
     }
+    else
+    {
+        newData = PacketMetadata::Create(m_used + size);
+        memcpy(newData->m_data, m_data->m_data, m_used);
+        Release();
+    }
+    newData->m_dirtyEnd = m_used;
     m_data = newData;
     if (m_head != 0xffff)
     {
@@ -104,8 +118,13 @@ PacketMetadata::Reserve(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
     NS_ASSERT(m_data != nullptr);
-    if (m_data->m_size >= m_used + size &&
-        (m_head == 0xffff || m_data->m_count == 1 || m_data->m_dirtyEnd == m_used))
+#ifdef NS3_MTP
+    // another thread may write to the same shared data: never write in place
+    bool isDirty = m_head != 0xffff && m_data->m_count != 1;
+#else
+    bool isDirty = m_head != 0xffff && m_data->m_count != 1 && m_data->m_dirtyEnd != m_used;
+#endif
+    if (m_data->m_size >= m_used + size && !isDirty)
     {
         /* enough room, not dirty. */
     }
@@ -119,7 +138,6 @@ PacketMetadata::Reserve(uint32_t size)
 bool
 PacketMetadata::IsSharedPointerOk(uint16_t pointer) const
 {
-    NS_LOG_FUNCTION(this << pointer);
     bool ok = pointer == 0xffff || pointer <= m_data->m_size;
     return ok;
 }
@@ -127,7 +145,6 @@ PacketMetadata::IsSharedPointerOk(uint16_t pointer) const
 bool
 PacketMetadata::IsPointerOk(uint16_t pointer) const
 {
-    NS_LOG_FUNCTION(this << pointer);
     bool ok = pointer == 0xffff || pointer <= m_used;
     return ok;
 }
@@ -167,7 +184,6 @@ PacketMetadata::IsStateOk() const
 uint32_t
 PacketMetadata::GetUleb128Size(uint32_t value) const
 {
-    NS_LOG_FUNCTION(this << value);
     if (value < 0x80)
     {
         return 1;
@@ -190,7 +206,6 @@ PacketMetadata::GetUleb128Size(uint32_t value) const
 uint32_t
 PacketMetadata::ReadUleb128(const uint8_t** pBuffer) const
 {
-    NS_LOG_FUNCTION(this << &pBuffer);
     const uint8_t* buffer = *pBuffer;
     uint32_t result;
     uint8_t byte;
@@ -240,7 +255,6 @@ PacketMetadata::ReadUleb128(const uint8_t** pBuffer) const
 void
 PacketMetadata::Append16(uint16_t value, uint8_t* buffer)
 {
-    NS_LOG_FUNCTION(this << value << &buffer);
     buffer[0] = value & 0xff;
     value >>= 8;
     buffer[1] = value;
@@ -249,7 +263,6 @@ PacketMetadata::Append16(uint16_t value, uint8_t* buffer)
 void
 PacketMetadata::Append32(uint32_t value, uint8_t* buffer)
 {
-    NS_LOG_FUNCTION(this << value << &buffer);
     buffer[0] = value & 0xff;
     buffer[1] = (value >> 8) & 0xff;
     buffer[2] = (value >> 16) & 0xff;
@@ -259,7 +272,6 @@ PacketMetadata::Append32(uint32_t value, uint8_t* buffer)
 void
 PacketMetadata::AppendValueExtra(uint32_t value, uint8_t* buffer)
 {
-    NS_LOG_FUNCTION(this << value << &buffer);
     if (value < 0x200000)
     {
         uint8_t byte = value & (~0x80);
@@ -305,7 +317,6 @@ PacketMetadata::AppendValueExtra(uint32_t value, uint8_t* buffer)
 void
 PacketMetadata::AppendValue(uint32_t value, uint8_t* buffer)
 {
-    NS_LOG_FUNCTION(this << value << &buffer);
     if (value < 0x80)
     {
         buffer[0] = value;
@@ -384,8 +395,13 @@ PacketMetadata::AddSmall(const struct PacketMetadata::SmallItem* item)
     uint32_t typeUidSize = GetUleb128Size(item->typeUid);
     uint32_t sizeSize = GetUleb128Size(item->size);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2;
-    if (m_used + n > m_data->m_size ||
-        (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+#ifdef NS3_MTP
+    // another thread may write to the same shared data: never write in place
+    bool isDirty = m_head != 0xffff && m_data->m_count != 1;
+#else
+    bool isDirty = m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd;
+#endif
+    if (m_used + n > m_data->m_size || isDirty)
     {
         ReserveCopy(n);
     }
@@ -421,8 +437,13 @@ PacketMetadata::AddBig(uint32_t next,
     uint32_t fragEndSize = GetUleb128Size(extraItem->fragmentEnd);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2 + fragStartSize + fragEndSize + 4;
 
-    if (m_used + n > m_data->m_size ||
-        (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+#ifdef NS3_MTP
+    // another thread may write to the same shared data: never write in place
+    bool isDirty = m_head != 0xffff && m_data->m_count != 1;
+#else
+    bool isDirty = m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd;
+#endif
+    if (m_used + n > m_data->m_size || isDirty)
     {
         ReserveCopy(n);
     }
@@ -572,6 +593,7 @@ PacketMetadata::Create(uint32_t size)
     {
         m_maxSize = size;
     }
+#ifndef NS3_MTP
     while (!m_freeList.empty())
     {
         struct PacketMetadata::Data* data = m_freeList.back();
@@ -585,6 +607,7 @@ PacketMetadata::Create(uint32_t size)
         NS_LOG_LOGIC("create dealloc size=" << data->m_size);
         PacketMetadata::Deallocate(data);
     }
+#endif
     NS_LOG_LOGIC("create alloc size=" << m_maxSize);
     return PacketMetadata::Allocate(m_maxSize);
 }
@@ -593,6 +616,10 @@ void
 PacketMetadata::Recycle(struct PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
+#ifdef NS3_MTP
+    // no free list: the data is created and recycled by any thread
+    PacketMetadata::Deallocate(data);
+#else
     if (!m_enable)
     {
         PacketMetadata::Deallocate(data);
@@ -608,6 +635,7 @@ PacketMetadata::Recycle(struct PacketMetadata::Data* data)
     {
         m_freeList.push_back(data);
     }
+#endif
 }
 
 struct PacketMetadata::Data*
@@ -671,8 +699,7 @@ PacketMetadata::DoAddHeader(uint32_t uid, uint32_t size)
     item.prev = 0xffff;
     item.typeUid = uid;
     item.size = size;
-    item.chunkUid = m_chunkUid;
-    m_chunkUid++;
+    item.chunkUid = m_chunkUid++;
     uint16_t written = AddSmall(&item);
     UpdateHead(written);
 }
@@ -739,8 +766,7 @@ PacketMetadata::AddTrailer(const Trailer& trailer, uint32_t size)
     item.prev = m_tail;
     item.typeUid = uid;
     item.size = size;
-    item.chunkUid = m_chunkUid;
-    m_chunkUid++;
+    item.chunkUid = m_chunkUid++;
     uint16_t written = AddSmall(&item);
     UpdateTail(written);
     NS_ASSERT(IsStateOk());
@@ -25,10 +25,16 @@
 #include "ns3/callback.h"
 #include "ns3/type-id.h"
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
 #include <stdint.h>
 #include <vector>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -76,6 +82,15 @@ class Trailer;
  * integers, and some others as variable-size 32-bit integers.
  * The variable-size 32 bit integers are stored using the uleb128
  * encoding.
+ *
+ * The data buffer of a packet with a few items is stored inside the
+ * PacketMetadata itself, so that creating a packet does not allocate
+ * it, and each copy of the packet owns a copy of it.  When the items
+ * outgrow this inline buffer, they move to a struct PacketMetadata::Data
+ * on the heap, which the copies of the packet share: they all read the
+ * same prefix of the buffer, and only one of them can append items in
+ * place.  The others copy the items they use, back into their inline
+ * buffer if they fit.
  */
 class PacketMetadata
 {
@@ -419,6 +434,8 @@ class PacketMetadata
      * of PacketMetadata::Data is 16 bytes
      */
 #define PACKET_METADATA_DATA_M_DATA_SIZE 8
+/// Size of the data buffer stored in the PacketMetadata itself
+#define PACKET_METADATA_INLINE_SIZE 64
 
     /**
      * Data structure
@@ -426,7 +443,11 @@ class PacketMetadata
     struct Data
     {
         /** number of references to this struct Data instance. */
+#ifdef NS3_MTP
+        std::atomic<uint32_t> m_count;
+#else
         uint32_t m_count;
+#endif
         /** size (in bytes) of m_data buffer below */
         uint16_t m_size;
         /** max of the m_used field over all objects which reference this struct Data instance */
@@ -657,6 +678,19 @@ class PacketMetadata
      * \param data the buffer data storage
      */
     static void Recycle(struct PacketMetadata::Data* data);
+    /**
+     * Initialize the data buffer stored in the PacketMetadata itself.
+     * \returns the inline data buffer
+     */
+    inline struct PacketMetadata::Data* CreateInline();
+    /**
+     * \returns true if the data buffer is stored in the PacketMetadata itself
+     */
+    inline bool IsInline() const;
+    /**
+     * Release the data buffer, and recycle it if it is not used anymore.
+     */
+    inline void Release();
     /**
      * \brief Create a buffer data storage
      * \param size the storage size to create
@@ -675,21 +709,35 @@ class PacketMetadata
      */
     static void Deallocate(struct PacketMetadata::Data* data);
 
+#ifndef NS3_MTP
     static DataFreeList m_freeList; //!< the metadata data storage
-    static bool m_enable;           //!< Enable the packet metadata
-    static bool m_enableChecking;   //!< Enable the packet metadata checking
+#endif
+    static bool m_enable;         //!< Enable the packet metadata
+    static bool m_enableChecking; //!< Enable the packet metadata checking
 
     /**
      * Set to true when adding metadata to a packet is skipped because
      * m_enable is false; used to detect enabling of metadata in the
      * middle of a simulation, which isn't allowed.
      */
+#ifdef NS3_MTP
+    static std::atomic<bool> m_metadataSkipped;
+#else
     static bool m_metadataSkipped;
+#endif
 
+#ifdef NS3_MTP
+    static thread_local uint32_t m_maxSize;  //!< maximum metadata size of the thread
+    static std::atomic<uint16_t> m_chunkUid; //!< Chunk Uid
+#else
     static uint32_t m_maxSize;  //!< maximum metadata size
     static uint16_t m_chunkUid; //!< Chunk Uid
+#endif
 
-    struct Data* m_data; //!< Metadata storage
+    struct Data* m_data; //!< Metadata storage, either m_inline or on the heap
+    /// Storage of a struct Data with PACKET_METADATA_INLINE_SIZE bytes of items
+    alignas(Data) uint8_t
+        m_inline[sizeof(Data) - PACKET_METADATA_DATA_M_DATA_SIZE + PACKET_METADATA_INLINE_SIZE];
     /*
        head -(next)-> tail
          ^             |
@@ -707,7 +755,7 @@ namespace ns3
 {
 
 PacketMetadata::PacketMetadata(uint64_t uid, uint32_t size)
-    : m_data(PacketMetadata::Create(10)),
+    : m_data(CreateInline()),
       m_head(0xffff),
       m_tail(0xffff),
       m_used(0),
@@ -728,6 +776,12 @@ PacketMetadata::PacketMetadata(const PacketMetadata& o)
       m_packetUid(o.m_packetUid)
 {
     NS_ASSERT(m_data != nullptr);
+    if (o.IsInline())
+    {
+        m_data = CreateInline();
+        memcpy(m_data->m_data, o.m_data->m_data, std::max<uint16_t>(m_used, 4));
+        return;
+    }
     NS_ASSERT(m_data->m_count < std::numeric_limits<uint32_t>::max());
     m_data->m_count++;
 }
@@ -739,14 +793,18 @@ PacketMetadata::operator=(const PacketMetadata& o)
     {
         // not self assignment
         NS_ASSERT(m_data != nullptr);
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        Release();
+        if (o.IsInline())
         {
-            PacketMetadata::Recycle(m_data);
+            m_data = CreateInline();
+            memcpy(m_data->m_data, o.m_data->m_data, std::max<uint16_t>(o.m_used, 4));
+        }
+        else
+        {
+            m_data = o.m_data;
+            NS_ASSERT(m_data != nullptr);
+            m_data->m_count++;
         }
-        m_data = o.m_data;
-        NS_ASSERT(m_data != nullptr);
-        m_data->m_count++;
     }
     m_head = o.m_head;
     m_tail = o.m_tail;
@@ -758,8 +816,29 @@ PacketMetadata::operator=(const PacketMetadata& o)
 PacketMetadata::~PacketMetadata()
 {
     NS_ASSERT(m_data != nullptr);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    Release();
+}
+
+struct PacketMetadata::Data*
+PacketMetadata::CreateInline()
+{
+    struct PacketMetadata::Data* data = reinterpret_cast<struct PacketMetadata::Data*>(m_inline);
+    data->m_count = 1;
+    data->m_size = PACKET_METADATA_INLINE_SIZE;
+    data->m_dirtyEnd = 0;
+    return data;
+}
+
+bool
+PacketMetadata::IsInline() const
+{
+    return m_data == reinterpret_cast<const struct PacketMetadata::Data*>(m_inline);
+}
+
+void
+PacketMetadata::Release()
+{
+    if (!IsInline() && --m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
@@ -172,9 +172,27 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
     return found;
 }
 
+void
+PacketTagList::RemoveInline(uint32_t i)
+{
+    NS_LOG_FUNCTION(this << i);
+    NS_ASSERT(i < m_nInline);
+    for (m_nInline--; i < m_nInline; ++i)
+    {
+        m_inline[i] = m_inline[i + 1];
+    }
+}
+
 bool
 PacketTagList::Remove(Tag& tag)
 {
+    uint32_t i = FindInline(tag.GetInstanceTypeId());
+    if (i != INLINE_TAGS)
+    {
+        tag.Deserialize(TagBuffer(m_inline[i].data, m_inline[i].data + m_inline[i].size));
+        RemoveInline(i);
+        return true;
+    }
     return COWTraverse(tag, &PacketTagList::RemoveWriter);
 }
 
@@ -215,6 +233,21 @@ PacketTagList::RemoveWriter(Tag& tag,
 bool
 PacketTagList::Replace(Tag& tag)
 {
+    uint32_t i = FindInline(tag.GetInstanceTypeId());
+    if (i != INLINE_TAGS)
+    {
+        uint32_t size = tag.GetSerializedSize();
+        if (size <= INLINE_TAG_SIZE)
+        {
+            m_inline[i].size = size;
+            tag.Serialize(TagBuffer(m_inline[i].data, m_inline[i].data + size));
+            return true;
+        }
+        // the new value is too large for the inline storage
+        RemoveInline(i);
+        Add(tag);
+        return true;
+    }
     bool found = COWTraverse(tag, &PacketTagList::ReplaceWriter);
     if (!found)
     {
@@ -263,12 +296,24 @@ PacketTagList::Add(const Tag& tag) const
 {
     NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
     // ensure this id was not yet added
+    NS_ASSERT_MSG(FindInline(tag.GetInstanceTypeId()) == INLINE_TAGS,
+                  "Error: cannot add the same kind of tag twice.");
     for (struct TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
         NS_ASSERT_MSG(cur->tid != tag.GetInstanceTypeId(),
                       "Error: cannot add the same kind of tag twice.");
     }
-    struct TagData* head = CreateTagData(tag.GetSerializedSize());
+    uint32_t size = tag.GetSerializedSize();
+    if (m_nInline < INLINE_TAGS && size <= INLINE_TAG_SIZE)
+    {
+        PacketTagList* list = const_cast<PacketTagList*>(this);
+        InlineTag& inlineTag = list->m_inline[list->m_nInline++];
+        inlineTag.tid = tag.GetInstanceTypeId();
+        inlineTag.size = size;
+        tag.Serialize(TagBuffer(inlineTag.data, inlineTag.data + size));
+        return;
+    }
+    struct TagData* head = CreateTagData(size);
     head->count = 1;
     head->next = nullptr;
     head->tid = tag.GetInstanceTypeId();
@@ -283,6 +328,13 @@ PacketTagList::Peek(Tag& tag) const
 {
     NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
     TypeId tid = tag.GetInstanceTypeId();
+    uint32_t i = FindInline(tid);
+    if (i != INLINE_TAGS)
+    {
+        tag.Deserialize(TagBuffer(const_cast<uint8_t*>(m_inline[i].data),
+                                  const_cast<uint8_t*>(m_inline[i].data) + m_inline[i].size));
+        return true;
+    }
     for (struct TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
         if (cur->tid == tid)
@@ -311,6 +363,19 @@ PacketTagList::GetSerializedSize() const
 
     size = 4; // numberOfTags
 
+    for (uint32_t i = 0; i < m_nInline; ++i)
+    {
+        size += 4; // InlineTag -> size
+
+        // TypeId hash; ensure size is multiple of 4 bytes
+        uint32_t hashSize = (sizeof(TypeId::hash_t) + 3) & (~3);
+        size += hashSize;
+
+        // InlineTag -> data; ensure size is multiple of 4 bytes
+        uint32_t tagWordSize = (m_inline[i].size + 3) & (~3);
+        size += tagWordSize;
+    }
+
     for (struct TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
         size += 4; // TagData -> size
@@ -348,48 +413,63 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
         return 0;
     }
 
-    for (struct TagData* cur = m_next; cur != nullptr; cur = cur->next)
-    {
+    auto serializeTag = [&](TypeId tagTid, const uint8_t* data, uint32_t dataSize) {
         if (size + 4 <= maxSize)
         {
-            *p++ = cur->size;
+            *p++ = dataSize;
             size += 4;
         }
         else
         {
-            return 0;
+            return false;
         }
 
-        NS_LOG_INFO("Serializing tag id " << cur->tid);
+        NS_LOG_INFO("Serializing tag id " << tagTid);
 
         // ensure size is multiple of 4 bytes for 4 byte boundaries
         uint32_t hashSize = (sizeof(TypeId::hash_t) + 3) & (~3);
         if (size + hashSize <= maxSize)
         {
-            TypeId::hash_t tid = cur->tid.GetHash();
+            TypeId::hash_t tid = tagTid.GetHash();
             memcpy(p, &tid, sizeof(TypeId::hash_t));
             p += hashSize / 4;
             size += hashSize;
         }
         else
         {
-            return 0;
+            return false;
         }
 
         // ensure size is multiple of 4 bytes for 4 byte boundaries
-        uint32_t tagWordSize = (cur->size + 3) & (~3);
+        uint32_t tagWordSize = (dataSize + 3) & (~3);
         if (size + tagWordSize <= maxSize)
         {
-            memcpy(p, cur->data, cur->size);
+            memcpy(p, data, dataSize);
             size += tagWordSize;
             p += tagWordSize / 4;
         }
         else
         {
-            return 0;
+            return false;
         }
 
         (*numberOfTags)++;
+        return true;
+    };
+
+    for (uint32_t i = 0; i < m_nInline; ++i)
+    {
+        if (!serializeTag(m_inline[i].tid, m_inline[i].data, m_inline[i].size))
+        {
+            return 0;
+        }
+    }
+    for (struct TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    {
+        if (!serializeTag(cur->tid, cur->data, cur->size))
+        {
+            return 0;
+        }
     }
 
     // Serialized successfully
@@ -427,6 +507,22 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 
         NS_LOG_INFO("Deserializing tag of type " << tid);
 
+        if (m_nInline < INLINE_TAGS && tagSize <= INLINE_TAG_SIZE)
+        {
+            InlineTag& inlineTag = m_inline[m_nInline++];
+            inlineTag.tid = tid;
+            inlineTag.size = tagSize;
+
+            NS_ASSERT(sizeCheck >= tagSize);
+            memcpy(inlineTag.data, p, tagSize);
+
+            // ensure 4 byte boundary
+            uint32_t tagWordSize = (tagSize + 3) & (~3);
+            p += tagWordSize / 4;
+            sizeCheck -= tagWordSize;
+            continue;
+        }
+
         struct TagData* newTag = CreateTagData(tagSize);
         newTag->count = 1;
         newTag->next = nullptr;
@@ -441,7 +537,7 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
         sizeCheck -= tagWordSize;
 
         // Set link list pointers.
-        if (i == 0)
+        if (prevTag == nullptr)
         {
             m_next = newTag;
         }
@@ -29,6 +29,10 @@
 #include <ostream>
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -120,6 +124,16 @@ class Tag;
  *       The portion of the list between the first branch and the target is
  *       shared. This portion is copied before the #Remove or #Replace is
  *       performed.
+ *
+ * \par <b> Inline tags </b>
+ *
+ *   - Most packets carry a few small tags, such as a FlowIdTag or a
+ *     TimestampTag.  The first #INLINE_TAGS tags whose serialized size is
+ *     at most #INLINE_TAG_SIZE bytes are stored in an array of InlineTag
+ *     inside the PacketTagList itself, and do not allocate any TagData.
+ *
+ *   - The inline tags are copied along with the PacketTagList, rather than
+ *     shared; the other tags are kept in the tree of TagData described above.
  */
 class PacketTagList
 {
@@ -142,12 +156,36 @@ class PacketTagList
     struct TagData
     {
         struct TagData* next; //!< Pointer to next in list
+#ifdef NS3_MTP
+        std::atomic<uint32_t> count; //!< Number of incoming links
+#else
         uint32_t count;       //!< Number of incoming links
+#endif
         TypeId tid;           //!< Type of the tag serialized into #data
         uint32_t size;        //!< Size of the \c data buffer
         uint8_t data[1];      //!< Serialization buffer
     };
 
+    /// The number of tags stored in the PacketTagList itself
+    static constexpr uint32_t INLINE_TAGS = 4;
+    /// The maximum serialized size of a tag stored in the PacketTagList itself
+    static constexpr uint32_t INLINE_TAG_SIZE = 20;
+
+    /**
+     * Storage of a small tag inside the PacketTagList.
+     *
+     * See PacketTagList for a discussion of the data structure.
+     *
+     * \internal
+     * This has to be public for the same reason as TagData.
+     */
+    struct InlineTag
+    {
+        TypeId tid;                    //!< Type of the tag serialized into #data
+        uint32_t size;                 //!< Size of the serialized tag
+        uint8_t data[INLINE_TAG_SIZE]; //!< Serialization buffer
+    };
+
     /**
      * Create a new PacketTagList.
      */
@@ -158,7 +196,8 @@ class PacketTagList
      * \param [in] o The PacketTagList to copy.
      *
      * This makes a light-weight copy by #RemoveAll, then
-     * pointing to the same \ref TagData as \pname{o}.
+     * pointing to the same \ref TagData as \pname{o}, and
+     * copying the inline tags of \pname{o}.
      */
     inline PacketTagList(const PacketTagList& o);
     /**
@@ -168,7 +207,8 @@ class PacketTagList
      * \returns the copied object
      *
      * This makes a light-weight copy by #RemoveAll, then
-     * pointing to the same \ref TagData as \pname{o}.
+     * pointing to the same \ref TagData as \pname{o}, and
+     * copying the inline tags of \pname{o}.
      */
     inline PacketTagList& operator=(const PacketTagList& o);
     /**
@@ -215,9 +255,17 @@ class PacketTagList
      */
     inline void RemoveAll();
     /**
-     * \returns pointer to head of tag list
+     * \returns pointer to head of the list of the tags which are not inline
      */
     const struct PacketTagList::TagData* Head() const;
+    /**
+     * \returns pointer to the first inline tag
+     */
+    inline const struct PacketTagList::InlineTag* InlineTags() const;
+    /**
+     * \returns the number of inline tags
+     */
+    inline uint32_t GetNInlineTags() const;
     /**
      * Returns number of bytes required for packet serialization.
      *
@@ -301,6 +349,22 @@ class PacketTagList
      */
     bool ReplaceWriter(Tag& tag, bool preMerge, struct TagData* cur, struct TagData** prevNext);
 
+    /**
+     * Find an inline tag.
+     *
+     * \param [in] tid The type of the tag.
+     * \returns The index of the inline tag, or #INLINE_TAGS if not found.
+     */
+    inline uint32_t FindInline(TypeId tid) const;
+    /**
+     * Remove an inline tag, keeping the order of the others.
+     *
+     * \param [in] i The index of the inline tag.
+     */
+    void RemoveInline(uint32_t i);
+
+    InlineTag m_inline[INLINE_TAGS]; //!< The inline tags, in the order they were added
+    uint32_t m_nInline;              //!< The number of inline tags
     /**
      * Pointer to first \ref TagData on the list
      */
@@ -317,13 +381,19 @@ namespace ns3
 {
 
 PacketTagList::PacketTagList()
-    : m_next()
+    : m_nInline(0),
+      m_next()
 {
 }
 
 PacketTagList::PacketTagList(const PacketTagList& o)
-    : m_next(o.m_next)
+    : m_nInline(o.m_nInline),
+      m_next(o.m_next)
 {
+    for (uint32_t i = 0; i < m_nInline; ++i)
+    {
+        m_inline[i] = o.m_inline[i];
+    }
     if (m_next != nullptr)
     {
         m_next->count++;
@@ -334,15 +404,23 @@ PacketTagList&
 PacketTagList::operator=(const PacketTagList& o)
 {
     // self assignment
-    if (m_next == o.m_next)
+    if (this == &o)
     {
         return *this;
     }
-    RemoveAll();
-    m_next = o.m_next;
-    if (m_next != nullptr)
+    if (m_next != o.m_next)
     {
-        m_next->count++;
+        RemoveAll();
+        m_next = o.m_next;
+        if (m_next != nullptr)
+        {
+            m_next->count++;
+        }
+    }
+    m_nInline = o.m_nInline;
+    for (uint32_t i = 0; i < m_nInline; ++i)
+    {
+        m_inline[i] = o.m_inline[i];
     }
     return *this;
 }
@@ -355,11 +433,11 @@ PacketTagList::~PacketTagList()
 void
 PacketTagList::RemoveAll()
 {
+    m_nInline = 0;
     struct TagData* prev = nullptr;
     for (struct TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
-        cur->count--;
-        if (cur->count > 0)
+        if (--cur->count > 0)
         {
             break;
         }
@@ -378,6 +456,31 @@ PacketTagList::RemoveAll()
     m_next = nullptr;
 }
 
+const struct PacketTagList::InlineTag*
+PacketTagList::InlineTags() const
+{
+    return m_inline;
+}
+
+uint32_t
+PacketTagList::GetNInlineTags() const
+{
+    return m_nInline;
+}
+
+uint32_t
+PacketTagList::FindInline(TypeId tid) const
+{
+    for (uint32_t i = 0; i < m_nInline; ++i)
+    {
+        if (m_inline[i].tid == tid)
+        {
+            return i;
+        }
+    }
+    return INLINE_TAGS;
+}
+
 } // namespace ns3
 
 #endif /* PACKET_TAG_LIST_H */
@@ -21,7 +21,10 @@
 #include "ns3/assert.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/thread-cache.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdarg>
 #include <string>
 
@@ -30,7 +33,53 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Packet");
 
+#ifdef NS3_MTP
+std::atomic<uint32_t> Packet::m_globalUid = 0;
+#else
 uint32_t Packet::m_globalUid = 0;
+#endif
+bool Packet::m_scatterGather = false;
+bool Packet::m_pool = true;
+
+/**
+ * \ingroup packet
+ * Traits of the pool of packets, see ThreadCache.
+ *
+ * A thread which mostly frees packets created by other threads, as the
+ * receiver of a channel, passes them through the shared cache to the
+ * threads which create them.
+ */
+struct Packet::PoolTraits
+{
+    /// Type of the blocks: the raw memory of a packet
+    using Block = void;
+    /// Number of size classes
+    static constexpr uint32_t N_CLASSES = 1;
+    /// Maximum number of packets in the pool of a thread
+    static constexpr uint32_t THREAD_CACHE_SIZE = 256;
+    /// Number of packets moved at once between a thread pool and the shared pool
+    static constexpr uint32_t BATCH_SIZE = THREAD_CACHE_SIZE / 2;
+    /// Maximum number of packets in the shared pool
+    static constexpr uint32_t SHARED_CACHE_SIZE = 4096;
+
+    /**
+     * Allocate the memory of a packet on the heap.
+     * \returns The memory.
+     */
+    static void* Allocate(uint32_t /* sizeClass */)
+    {
+        return ::operator new(sizeof(Packet));
+    }
+
+    /**
+     * Free the memory of a packet on the heap.
+     * \param [in] p The memory.
+     */
+    static void Deallocate(void* p)
+    {
+        ::operator delete(p);
+    }
+};
 
 TypeId
 ByteTagIterator::Item::GetTypeId() const
@@ -89,42 +138,53 @@ ByteTagIterator::ByteTagIterator(ByteTagList::Iterator i)
 {
 }
 
-PacketTagIterator::PacketTagIterator(const struct PacketTagList::TagData* head)
-    : m_current(head)
+PacketTagIterator::PacketTagIterator(const PacketTagList& list)
+    : m_inline(list.InlineTags()),
+      m_nInline(list.GetNInlineTags()),
+      m_current(list.Head())
 {
 }
 
 bool
 PacketTagIterator::HasNext() const
 {
-    return m_current != nullptr;
+    return m_nInline != 0 || m_current != nullptr;
 }
 
 PacketTagIterator::Item
 PacketTagIterator::Next()
 {
     NS_ASSERT(HasNext());
+    if (m_nInline != 0)
+    {
+        const struct PacketTagList::InlineTag* prev = m_inline;
+        m_inline++;
+        m_nInline--;
+        return PacketTagIterator::Item(prev->tid, prev->data, prev->size);
+    }
     const struct PacketTagList::TagData* prev = m_current;
     m_current = m_current->next;
-    return PacketTagIterator::Item(prev);
+    return PacketTagIterator::Item(prev->tid, prev->data, prev->size);
 }
 
-PacketTagIterator::Item::Item(const struct PacketTagList::TagData* data)
-    : m_data(data)
+PacketTagIterator::Item::Item(TypeId tid, const uint8_t* data, uint32_t size)
+    : m_tid(tid),
+      m_data(data),
+      m_size(size)
 {
 }
 
 TypeId
 PacketTagIterator::Item::GetTypeId() const
 {
-    return m_data->tid;
+    return m_tid;
 }
 
 void
 PacketTagIterator::Item::GetTag(Tag& tag) const
 {
-    NS_ASSERT(tag.GetInstanceTypeId() == m_data->tid);
-    tag.Deserialize(TagBuffer((uint8_t*)m_data->data, (uint8_t*)m_data->data + m_data->size));
+    NS_ASSERT(tag.GetInstanceTypeId() == m_tid);
+    tag.Deserialize(TagBuffer((uint8_t*)m_data, (uint8_t*)m_data + m_size));
 }
 
 Ptr<Packet>
@@ -138,6 +198,7 @@ Packet::Copy() const
 
 Packet::Packet()
     : m_buffer(),
+      m_segmentsSize(0),
       m_byteTagList(),
       m_packetTagList(),
       /* The upper 32 bits of the packet id in
@@ -146,14 +207,15 @@ Packet::Packet()
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, 0),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++, 0),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const Packet& o)
     : m_buffer(o.m_buffer),
+      m_segments(o.m_segments),
+      m_segmentsSize(o.m_segmentsSize),
       m_byteTagList(o.m_byteTagList),
       m_packetTagList(o.m_packetTagList),
       m_metadata(o.m_metadata)
@@ -169,6 +231,8 @@ Packet::operator=(const Packet& o)
         return *this;
     }
     m_buffer = o.m_buffer;
+    m_segments = o.m_segments;
+    m_segmentsSize = o.m_segmentsSize;
     m_byteTagList = o.m_byteTagList;
     m_packetTagList = o.m_packetTagList;
     m_metadata = o.m_metadata;
@@ -178,6 +242,7 @@ Packet::operator=(const Packet& o)
 
 Packet::Packet(uint32_t size)
     : m_buffer(size),
+      m_segmentsSize(0),
       m_byteTagList(),
       m_packetTagList(),
       /* The upper 32 bits of the packet id in
@@ -186,14 +251,14 @@ Packet::Packet(uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++, size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
     : m_buffer(0, false),
+      m_segmentsSize(0),
       m_byteTagList(),
       m_packetTagList(),
       m_metadata(0, 0),
@@ -205,6 +270,7 @@ Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
 
 Packet::Packet(const uint8_t* buffer, uint32_t size)
     : m_buffer(),
+      m_segmentsSize(0),
       m_byteTagList(),
       m_packetTagList(),
       /* The upper 32 bits of the packet id in
@@ -213,10 +279,9 @@ Packet::Packet(const uint8_t* buffer, uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++, size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
     m_buffer.AddAtStart(size);
     Buffer::Iterator i = m_buffer.Begin();
     i.Write(buffer, size);
@@ -227,6 +292,7 @@ Packet::Packet(const Buffer& buffer,
                const PacketTagList& packetTagList,
                const PacketMetadata& metadata)
     : m_buffer(buffer),
+      m_segmentsSize(0),
       m_byteTagList(byteTagList),
       m_packetTagList(packetTagList),
       m_metadata(metadata),
@@ -238,16 +304,31 @@ Ptr<Packet>
 Packet::CreateFragment(uint32_t start, uint32_t length) const
 {
     NS_LOG_FUNCTION(this << start << length);
-    Buffer buffer = m_buffer.CreateFragment(start, length);
+    NS_ASSERT(GetSize() >= start + length);
+    uint32_t headSize = m_buffer.GetSize();
+    uint32_t headStart = std::min(start, headSize);
+    uint32_t headEnd = std::min(start + length, headSize);
+    Buffer buffer = m_buffer.CreateFragment(headStart, headEnd - headStart);
     ByteTagList byteTagList = m_byteTagList;
     byteTagList.Adjust(-start);
-    NS_ASSERT(m_buffer.GetSize() >= start + length);
-    uint32_t end = m_buffer.GetSize() - (start + length);
+    uint32_t end = GetSize() - (start + length);
     PacketMetadata metadata = m_metadata.CreateFragment(start, end);
     // again, call the constructor directly rather than
     // through Create because it is private.
     Ptr<Packet> ret =
         Ptr<Packet>(new Packet(buffer, byteTagList, m_packetTagList, metadata), false);
+    uint32_t offset = headSize;
+    for (const auto& segment : m_segments)
+    {
+        uint32_t size = segment.GetSize();
+        if (offset < start + length && offset + size > start)
+        {
+            uint32_t sliceStart = std::max(start, offset) - offset;
+            uint32_t sliceEnd = std::min(start + length, offset + size) - offset;
+            ret->AddSegment(segment.CreateFragment(sliceStart, sliceEnd - sliceStart));
+        }
+        offset += size;
+    }
     ret->SetNixVector(GetNixVector());
     return ret;
 }
@@ -279,6 +360,7 @@ Packet::AddHeader(const Header& header)
 uint32_t
 Packet::RemoveHeader(Header& header, uint32_t size)
 {
+    PullUp(size);
     Buffer::Iterator end;
     end = m_buffer.Begin();
     end.Next(size);
@@ -293,6 +375,7 @@ Packet::RemoveHeader(Header& header, uint32_t size)
 uint32_t
 Packet::RemoveHeader(Header& header)
 {
+    PullUp(std::max(header.GetSerializedSize(), MIN_PULL_UP));
     uint32_t deserialized = header.Deserialize(m_buffer.Begin());
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
     m_buffer.RemoveAtStart(deserialized);
@@ -304,6 +387,7 @@ Packet::RemoveHeader(Header& header)
 uint32_t
 Packet::PeekHeader(Header& header) const
 {
+    PullUp(std::max(header.GetSerializedSize(), MIN_PULL_UP));
     uint32_t deserialized = header.Deserialize(m_buffer.Begin());
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
     return deserialized;
@@ -312,6 +396,7 @@ Packet::PeekHeader(Header& header) const
 uint32_t
 Packet::PeekHeader(Header& header, uint32_t size) const
 {
+    PullUp(size);
     Buffer::Iterator end;
     end = m_buffer.Begin();
     end.Next(size);
@@ -326,8 +411,10 @@ Packet::AddTrailer(const Trailer& trailer)
     uint32_t size = trailer.GetSerializedSize();
     NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << size);
     m_byteTagList.AddAtEnd(GetSize());
-    m_buffer.AddAtEnd(size);
-    Buffer::Iterator end = m_buffer.End();
+    Buffer& last = m_segments.empty() ? m_buffer : m_segments.back();
+    last.AddAtEnd(size);
+    m_segmentsSize += m_segments.empty() ? 0 : size;
+    Buffer::Iterator end = last.End();
     trailer.Serialize(end);
     m_metadata.AddTrailer(trailer, size);
 }
@@ -335,9 +422,24 @@ Packet::AddTrailer(const Trailer& trailer)
 uint32_t
 Packet::RemoveTrailer(Trailer& trailer)
 {
-    uint32_t deserialized = trailer.Deserialize(m_buffer.End());
+    PullDown(std::max(trailer.GetSerializedSize(), MIN_PULL_UP));
+    Buffer& last = m_segments.empty() ? m_buffer : m_segments.back();
+    uint32_t deserialized = trailer.Deserialize(last.End());
     NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << deserialized);
-    m_buffer.RemoveAtEnd(deserialized);
+    if (m_segments.empty())
+    {
+        m_buffer.RemoveAtEnd(deserialized);
+    }
+    else if (deserialized == last.GetSize())
+    {
+        m_segmentsSize -= deserialized;
+        m_segments.pop_back();
+    }
+    else
+    {
+        m_segmentsSize -= deserialized;
+        last.RemoveAtEnd(deserialized);
+    }
     m_metadata.RemoveTrailer(trailer, deserialized);
     return deserialized;
 }
@@ -345,7 +447,9 @@ Packet::RemoveTrailer(Trailer& trailer)
 uint32_t
 Packet::PeekTrailer(Trailer& trailer)
 {
-    uint32_t deserialized = trailer.Deserialize(m_buffer.End());
+    PullDown(std::max(trailer.GetSerializedSize(), MIN_PULL_UP));
+    const Buffer& last = m_segments.empty() ? m_buffer : m_segments.back();
+    uint32_t deserialized = trailer.Deserialize(last.End());
     NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << deserialized);
     return deserialized;
 }
@@ -359,7 +463,23 @@ Packet::AddAtEnd(Ptr<const Packet> packet)
     copy.AddAtStart(0);
     copy.Adjust(GetSize());
     m_byteTagList.Add(copy);
-    m_buffer.AddAtEnd(packet->m_buffer);
+    if (m_scatterGather)
+    {
+        // By index, as packet may be this packet.
+        std::size_t n = packet->m_segments.size();
+        AddSegment(packet->m_buffer);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            AddSegment(packet->m_segments[i]);
+        }
+    }
+    else
+    {
+        packet->Linearize();
+        Buffer& last = m_segments.empty() ? m_buffer : m_segments.back();
+        last.AddAtEnd(packet->m_buffer);
+        m_segmentsSize += m_segments.empty() ? 0 : packet->m_buffer.GetSize();
+    }
     m_metadata.AddAtEnd(packet->m_metadata);
 }
 
@@ -368,7 +488,9 @@ Packet::AddPaddingAtEnd(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
     m_byteTagList.AddAtEnd(GetSize());
-    m_buffer.AddAtEnd(size);
+    Buffer& last = m_segments.empty() ? m_buffer : m_segments.back();
+    last.AddAtEnd(size);
+    m_segmentsSize += m_segments.empty() ? 0 : size;
     m_metadata.AddPaddingAtEnd(size);
 }
 
@@ -376,17 +498,39 @@ void
 Packet::RemoveAtEnd(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    m_buffer.RemoveAtEnd(size);
     m_metadata.RemoveAtEnd(size);
+    while (!m_segments.empty() && size > 0)
+    {
+        Buffer& last = m_segments.back();
+        uint32_t removed = std::min(size, last.GetSize());
+        m_segmentsSize -= removed;
+        size -= removed;
+        if (removed == last.GetSize())
+        {
+            m_segments.pop_back();
+        }
+        else
+        {
+            last.RemoveAtEnd(removed);
+        }
+    }
+    m_buffer.RemoveAtEnd(size);
 }
 
 void
 Packet::RemoveAtStart(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    m_buffer.RemoveAtStart(size);
     m_byteTagList.Adjust(-size);
     m_metadata.RemoveAtStart(size);
+    while (!m_segments.empty() && size >= m_buffer.GetSize())
+    {
+        size -= m_buffer.GetSize();
+        m_buffer = m_segments.front();
+        m_segmentsSize -= m_buffer.GetSize();
+        m_segments.erase(m_segments.begin());
+    }
+    m_buffer.RemoveAtStart(size);
 }
 
 void
@@ -399,13 +543,26 @@ Packet::RemoveAllByteTags()
 uint32_t
 Packet::CopyData(uint8_t* buffer, uint32_t size) const
 {
-    return m_buffer.CopyData(buffer, size);
+    uint32_t copied = m_buffer.CopyData(buffer, size);
+    for (auto i = m_segments.begin(); i != m_segments.end() && copied < size; ++i)
+    {
+        copied += i->CopyData(buffer + copied, size - copied);
+    }
+    return copied;
 }
 
 void
 Packet::CopyData(std::ostream* os, uint32_t size) const
 {
-    return m_buffer.CopyData(os, size);
+    uint32_t headSize = std::min(size, m_buffer.GetSize());
+    m_buffer.CopyData(os, headSize);
+    size -= headSize;
+    for (auto i = m_segments.begin(); i != m_segments.end() && size > 0; ++i)
+    {
+        uint32_t segmentSize = std::min(size, i->GetSize());
+        i->CopyData(os, segmentSize);
+        size -= segmentSize;
+    }
 }
 
 uint64_t
@@ -455,6 +612,7 @@ Packet::ToString() const
 void
 Packet::Print(std::ostream& os) const
 {
+    Linearize();
     PacketMetadata::ItemIterator i = m_metadata.BeginItem(m_buffer);
     while (i.HasNext())
     {
@@ -589,6 +747,7 @@ Packet::Print(std::ostream& os) const
 PacketMetadata::ItemIterator
 Packet::BeginItem() const
 {
+    Linearize();
     return m_metadata.BeginItem(m_buffer);
 }
 
@@ -606,9 +765,166 @@ Packet::EnableChecking()
     PacketMetadata::EnableChecking();
 }
 
+void
+Packet::EnableScatterGather()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_scatterGather = true;
+}
+
+void
+Packet::DisableScatterGather()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_scatterGather = false;
+}
+
+void*
+Packet::operator new(size_t size)
+{
+    // The classes derived from Packet, if any, are not pooled.
+    if (m_pool && size == sizeof(Packet))
+    {
+        ThreadCache<PoolTraits>* pool = ThreadCache<PoolTraits>::Get();
+        if (pool != nullptr)
+        {
+            return pool->Pop();
+        }
+    }
+    return ::operator new(size);
+}
+
+void
+Packet::operator delete(void* p, size_t size)
+{
+    if (m_pool && size == sizeof(Packet))
+    {
+        ThreadCache<PoolTraits>* pool = ThreadCache<PoolTraits>::Get();
+        if (pool != nullptr)
+        {
+            pool->Push(p);
+            return;
+        }
+    }
+    ::operator delete(p);
+}
+
+void
+PacketDeleter::Delete(Packet* packet)
+{
+    delete packet;
+}
+
+void
+Packet::EnablePool()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_pool = true;
+}
+
+void
+Packet::DisablePool()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_pool = false;
+}
+
+Packet::PoolStats
+Packet::GetPoolStats()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    ThreadCacheStats stats = ThreadCache<PoolTraits>::GetStats();
+    return {stats.hits, stats.misses, stats.releases};
+}
+
+void
+Packet::Linearize() const
+{
+    PullUp(GetSize());
+}
+
+void
+Packet::PullUp(uint32_t size) const
+{
+    if (m_segments.empty() || m_buffer.GetSize() >= size)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this << size << m_segments.size());
+    auto end = m_segments.begin();
+    uint32_t merged = m_buffer.GetSize();
+    while (end != m_segments.end() && merged < size)
+    {
+        merged += end->GetSize();
+        ++end;
+    }
+    // Copy the bytes once into new storage, rather than
+    // growing m_buffer segment by segment.
+    Buffer buffer;
+    buffer.AddAtEnd(merged);
+    Buffer::Iterator i = buffer.Begin();
+    i.Write(m_buffer.Begin(), m_buffer.End());
+    for (auto segment = m_segments.begin(); segment != end; ++segment)
+    {
+        i.Write(segment->Begin(), segment->End());
+    }
+    m_segmentsSize -= merged - m_buffer.GetSize();
+    m_segments.erase(m_segments.begin(), end);
+    m_buffer = buffer;
+}
+
+void
+Packet::PullDown(uint32_t size) const
+{
+    if (m_segments.empty() || m_segments.back().GetSize() >= size)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this << size << m_segments.size());
+    auto begin = m_segments.end();
+    uint32_t merged = 0;
+    while (begin != m_segments.begin() && merged < size)
+    {
+        --begin;
+        merged += begin->GetSize();
+    }
+    if (merged < size)
+    {
+        // The bytes start in m_buffer.
+        Linearize();
+        return;
+    }
+    Buffer buffer;
+    buffer.AddAtEnd(merged);
+    Buffer::Iterator i = buffer.Begin();
+    for (auto segment = begin; segment != m_segments.end(); ++segment)
+    {
+        i.Write(segment->Begin(), segment->End());
+    }
+    m_segments.erase(begin, m_segments.end());
+    m_segments.push_back(buffer);
+}
+
+void
+Packet::AddSegment(const Buffer& segment)
+{
+    if (segment.GetSize() == 0)
+    {
+        return;
+    }
+    if (m_buffer.GetSize() == 0 && m_segments.empty())
+    {
+        m_buffer = segment;
+        return;
+    }
+    m_segments.push_back(segment);
+    m_segmentsSize += segment.GetSize();
+}
+
 uint32_t
 Packet::GetSerializedSize() const
 {
+    Linearize();
     uint32_t size = 0;
 
     if (m_nixVector)
@@ -662,6 +978,7 @@ Packet::GetSerializedSize() const
 uint32_t
 Packet::Serialize(uint8_t* buffer, uint32_t maxSize) const
 {
+    Linearize();
     uint32_t* p = reinterpret_cast<uint32_t*>(buffer);
     uint32_t size = 0;
 
@@ -1038,7 +1355,7 @@ Packet::PrintPacketTags(std::ostream& os) const
 PacketTagIterator
 Packet::GetPacketTagIterator() const
 {
-    return PacketTagIterator(m_packetTagList.Head());
+    return PacketTagIterator(m_packetTagList);
 }
 
 std::ostream&
@@ -35,6 +35,11 @@
 #include "ns3/ptr.h"
 
 #include <stdint.h>
+#include <vector>
+
+#ifdef NS3_MTP
+#include <atomic>
+#endif
 
 namespace ns3
 {
@@ -161,10 +166,14 @@ class PacketTagIterator
         friend class PacketTagIterator;
         /**
          * Constructor
-         * \param data the data to copy.
+         * \param tid the type of the tag.
+         * \param data the serialized tag.
+         * \param size the size of the serialized tag.
          */
-        Item(const struct PacketTagList::TagData* data);
-        const struct PacketTagList::TagData* m_data; //!< the tag data
+        Item(TypeId tid, const uint8_t* data, uint32_t size);
+        TypeId m_tid;          //!< the type of the tag
+        const uint8_t* m_data; //!< the serialized tag
+        uint32_t m_size;       //!< the size of the serialized tag
     };
 
     /**
@@ -181,13 +190,34 @@ class PacketTagIterator
     friend class Packet;
     /**
      * Constructor
-     * \param head head of the items
+     * \param list the tags of the packet
      */
-    PacketTagIterator(const struct PacketTagList::TagData* head);
+    PacketTagIterator(const PacketTagList& list);
+    const struct PacketTagList::InlineTag* m_inline; //!< the next inline tag
+    uint32_t m_nInline;                              //!< the number of inline tags left
     const struct PacketTagList::TagData*
         m_current; //!< actual position over the set of tags in a packet
 };
 
+class Packet;
+
+/**
+ * \ingroup packet
+ * \brief Delete the packets whose last reference disappears.
+ *
+ * The deletion is not inlined in the users of the packets, where it
+ * would call Packet::operator delete(): GCC then warns of a use after
+ * free in Ptr<Packet> assignments, which it cannot prove safe.
+ */
+struct PacketDeleter
+{
+    /**
+     * Delete a packet, into the pool if it is enabled.
+     * \param [in] packet The packet to delete.
+     */
+    static void Delete(Packet* packet);
+};
+
 /**
  * \ingroup packet
  * \brief network packets
@@ -237,7 +267,7 @@ class PacketTagIterator
  * The performance aspects copy-on-write semantics of the
  * Packet API are discussed in \ref packetperf
  */
-class Packet : public SimpleRefCount<Packet>
+class Packet : public SimpleRefCount<Packet, Empty, PacketDeleter>
 {
   public:
     /**
@@ -538,6 +568,85 @@ class Packet : public SimpleRefCount<Packet>
      * errors will be detected and will abort the program.
      */
     static void EnableChecking();
+    /**
+     * \brief Enable scatter-gather packet bodies.
+     *
+     * By default, AddAtEnd copies the bytes of the added packet into
+     * the buffer of this packet, which makes a reassembly of n fragments
+     * cost O(n^2) bytes of copies.  Once this method is invoked,
+     * AddAtEnd instead appends the buffers of the added packet as
+     * segments which share its storage, and CreateFragment slices the
+     * segments of a packet, so that both cost O(segments).
+     *
+     * The segments are copied into one contiguous buffer only when
+     * contiguous bytes are needed: to print the packet, to iterate over
+     * the metadata items, or to serialize the packet.  Adding a header or
+     * a trailer works on the first or the last segment.  Removing or
+     * peeking a header merges only the first segments, when the header
+     * does not fit in the first one, and likewise for a trailer and the
+     * last segments.  A header or a trailer read without its size is
+     * expected in its GetSerializedSize() bytes or in the first or last 128
+     * bytes, whichever is larger: a header which can be larger than both,
+     * depending on its content, is read with its size.
+     */
+    static void EnableScatterGather();
+    /**
+     * \brief Disable scatter-gather packet bodies.
+     *
+     * The packets which already have several segments keep them until
+     * they need contiguous bytes.
+     */
+    static void DisableScatterGather();
+
+    /**
+     * \brief Statistics of the pool of packets.
+     */
+    struct PoolStats
+    {
+        uint64_t hits;     //!< Packets reused from the pool.
+        uint64_t misses;   //!< Packets allocated on the heap.
+        uint64_t releases; //!< Packets returned to the heap.
+    };
+
+    /**
+     * \brief Enable the pool of packets.
+     *
+     * The pool is enabled by default.  When the last reference to a
+     * packet is released, SimpleRefCount deletes it: the destructor
+     * resets its buffer, tags and metadata, and the memory of the packet
+     * is kept in a pool of the thread for the next packet created or
+     * copied, instead of going back to the heap.
+     */
+    static void EnablePool();
+    /**
+     * \brief Disable the pool of packets.
+     *
+     * The packets are then allocated and freed on the heap, which helps
+     * memory checkers to find the uses of freed packets.  The packets
+     * which are already in the pool stay there.
+     */
+    static void DisablePool();
+    /**
+     * \brief Get the statistics of the pool of packets of all the threads.
+     *
+     * \returns The statistics since the start of the program.
+     */
+    static PoolStats GetPoolStats();
+
+    /**
+     * \brief Allocate a packet, from the pool if it is enabled.
+     *
+     * \param [in] size The size of the object.
+     * \returns The memory of the object.
+     */
+    static void* operator new(size_t size);
+    /**
+     * \brief Free a packet, into the pool if it is enabled.
+     *
+     * \param [in] p The memory of the object.
+     * \param [in] size The size of the object.
+     */
+    static void operator delete(void* p, size_t size);
 
     /**
      * \brief Returns number of bytes required for packet
@@ -789,15 +898,62 @@ class Packet : public SimpleRefCount<Packet>
      */
     uint32_t Deserialize(const uint8_t* buffer, uint32_t size);
 
-    Buffer m_buffer;               //!< the packet buffer (it's actual contents)
-    ByteTagList m_byteTagList;     //!< the ByteTag list
-    PacketTagList m_packetTagList; //!< the packet's Tag list
-    PacketMetadata m_metadata;     //!< the packet's metadata
+    /**
+     * \brief Copy the segments into m_buffer.
+     *
+     * This does not change the bytes of the packet, only their
+     * representation, hence the mutable members it changes.
+     */
+    void Linearize() const;
+    /**
+     * \brief Copy the first segments into m_buffer, until m_buffer holds
+     * the first bytes of the packet, or the whole packet.
+     *
+     * \param [in] size the number of bytes
+     */
+    void PullUp(uint32_t size) const;
+    /**
+     * \brief Copy the last segments into one, until it holds the last bytes
+     * of the packet, or the whole packet.
+     *
+     * \param [in] size the number of bytes
+     */
+    void PullDown(uint32_t size) const;
+    /**
+     * \brief Append a segment to the packet body.
+     *
+     * Only the buffer is appended: the metadata and tags are left to the caller.
+     *
+     * \param [in] segment the segment
+     */
+    void AddSegment(const Buffer& segment);
+
+    struct PoolTraits; //!< Traits of the pool of packets, see packet.cc
+
+    /* The const methods which need contiguous bytes, e.g., PeekHeader or
+     * Serialize, merge the segments into m_buffer: the bytes of the packet
+     * stay the same, so m_buffer and the segments are mutable.  Hence
+     * threads which share a packet with segments each read their own copy.
+     */
+    mutable Buffer m_buffer;                //!< the packet buffer (it's actual contents)
+    mutable std::vector<Buffer> m_segments; //!< the segments after m_buffer
+    mutable uint32_t m_segmentsSize;        //!< the total size of m_segments
+    ByteTagList m_byteTagList;              //!< the ByteTag list
+    PacketTagList m_packetTagList;          //!< the packet's Tag list
+    PacketMetadata m_metadata;              //!< the packet's metadata
+    static bool m_scatterGather;            //!< whether AddAtEnd appends segments
+    static bool m_pool;                     //!< whether deleted packets are kept in a pool
+    /// Minimum number of bytes merged to read a header or a trailer without its size
+    static constexpr uint32_t MIN_PULL_UP = 128;
 
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
+#ifdef NS3_MTP
+    static std::atomic<uint32_t> m_globalUid; //!< Global counter of packets Uid
+#else
     static uint32_t m_globalUid; //!< Global counter of packets Uid
+#endif
 };
 
 /**
@@ -862,7 +1018,7 @@ namespace ns3
 uint32_t
 Packet::GetSize() const
 {
-    return m_buffer.GetSize();
+    return m_buffer.GetSize() + m_segmentsSize;
 }
 
 } // namespace ns3
@@ -22,6 +22,9 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/test.h"
 
+#include <thread>
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -395,6 +398,68 @@ BufferTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(val1, val2, "Bad ReadNtohU16()");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check that the storage of buffers of mixed sizes is reused, also
+ * when it is freed by another thread.
+ */
+class BufferAllocatorTest : public TestCase
+{
+  public:
+    BufferAllocatorTest();
+    void DoRun() override;
+};
+
+BufferAllocatorTest::BufferAllocatorTest()
+    : TestCase("Buffer allocator")
+{
+}
+
+void
+BufferAllocatorTest::DoRun()
+{
+    const uint32_t sizes[] = {64, 1500, 9000};
+    // Warm up the caches of all the sizes.
+    for (uint32_t size : sizes)
+    {
+        Buffer buffer;
+        buffer.AddAtStart(size);
+    }
+
+    Buffer::AllocatorStats before = Buffer::GetAllocatorStats();
+    for (uint32_t i = 0; i < 300; ++i)
+    {
+        Buffer buffer;
+        buffer.AddAtStart(sizes[i % 3]);
+        buffer.Begin().WriteU8(i, sizes[i % 3]);
+    }
+    Buffer::AllocatorStats after = Buffer::GetAllocatorStats();
+    NS_TEST_ASSERT_MSG_EQ(after.misses, before.misses, "A jumbo buffer evicted smaller ones");
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(after.hits - before.hits, 300, "Storage was not reused");
+
+    std::vector<Buffer> buffers(200);
+    for (auto& buffer : buffers)
+    {
+        buffer.AddAtStart(1500);
+    }
+    std::thread other([&buffers]() {
+        buffers.clear();
+        for (uint32_t i = 0; i < 100; ++i)
+        {
+            Buffer buffer;
+            buffer.AddAtStart(1500);
+        }
+    });
+    other.join();
+    Buffer::AllocatorStats joined = Buffer::GetAllocatorStats();
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(joined.hits - after.hits,
+                                100,
+                                "Storage freed by another thread was not reused");
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(joined.releases, joined.misses, "Storage was freed twice");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -411,6 +476,7 @@ BufferTestSuite::BufferTestSuite()
     : TestSuite("buffer", UNIT)
 {
     AddTestCase(new BufferTest, TestCase::QUICK);
+    AddTestCase(new BufferAllocatorTest, TestCase::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite; //!< Static variable for test initialization
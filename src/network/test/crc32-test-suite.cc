@@ -0,0 +1,121 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/crc32.h"
+#include "ns3/ethernet-trailer.h"
+#include "ns3/packet.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that the implementations of the CRC-32 compute the same
+ * checksums, for every length and alignment of the buffer.
+ */
+class Crc32TestCase : public TestCase
+{
+  public:
+    Crc32TestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Crc32TestCase::Crc32TestCase()
+    : TestCase("Check that the CRC-32 implementations compute the same checksums")
+{
+}
+
+void
+Crc32TestCase::DoRun()
+{
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    for (auto implementation : {CRC32_BYTEWISE, CRC32_SLICE_BY_8, CRC32_PCLMUL})
+    {
+        NS_TEST_EXPECT_MSG_EQ(CRC32Calculate(check, sizeof(check), implementation),
+                              0xCBF43926,
+                              "Wrong check value of implementation " << implementation);
+        NS_TEST_EXPECT_MSG_EQ(CRC32Calculate(check, 0, implementation),
+                              0,
+                              "Wrong checksum of an empty buffer");
+    }
+    NS_TEST_EXPECT_MSG_EQ(CRC32Calculate(check, sizeof(check)), 0xCBF43926, "Wrong check value");
+
+    // Pseudo random bytes, from a linear congruential generator
+    std::vector<uint8_t> buffer(9216 + 16);
+    uint32_t seed = 1;
+    for (auto& byte : buffer)
+    {
+        seed = seed * 1103515245 + 12345;
+        byte = seed >> 24;
+    }
+    for (uint32_t offset = 0; offset < 16; offset += 5)
+    {
+        for (uint32_t length = 0; length <= 9216; length += (length < 300 ? 1 : 251))
+        {
+            const uint8_t* data = buffer.data() + offset;
+            uint32_t expected = CRC32Calculate(data, length, CRC32_BYTEWISE);
+            NS_TEST_ASSERT_MSG_EQ(CRC32Calculate(data, length, CRC32_SLICE_BY_8),
+                                  expected,
+                                  "Wrong slice-by-8 checksum of " << length << " bytes");
+            NS_TEST_ASSERT_MSG_EQ(CRC32Calculate(data, length, CRC32_PCLMUL),
+                                  expected,
+                                  "Wrong PCLMUL checksum of " << length << " bytes");
+            NS_TEST_ASSERT_MSG_EQ(CRC32Calculate(data, length),
+                                  expected,
+                                  "Wrong checksum of " << length << " bytes");
+        }
+    }
+
+    // The checksum of a frame followed by its FCS is the CRC-32 residue
+    Ptr<Packet> packet = Create<Packet>(buffer.data(), 1500);
+    EthernetTrailer trailer;
+    trailer.EnableFcs(true);
+    trailer.CalcFcs(packet);
+    NS_TEST_EXPECT_MSG_EQ(trailer.CheckFcs(packet), true, "Wrong FCS");
+    uint32_t fcs = trailer.GetFcs();
+    for (int i = 0; i < 4; ++i)
+    {
+        buffer[1500 + i] = (fcs >> (8 * i)) & 0xFF;
+    }
+    NS_TEST_EXPECT_MSG_EQ(CRC32Calculate(buffer.data(), 1504),
+                          0x2144DF1C,
+                          "Wrong checksum of a frame followed by its FCS");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief CRC-32 TestSuite
+ */
+class Crc32TestSuite : public TestSuite
+{
+  public:
+    Crc32TestSuite();
+};
+
+Crc32TestSuite::Crc32TestSuite()
+    : TestSuite("crc32", UNIT)
+{
+    AddTestCase(new Crc32TestCase, TestCase::QUICK);
+}
+
+static Crc32TestSuite g_crc32TestSuite; //!< Static variable for test initialization
@@ -16,9 +16,13 @@
  */
 
 #include "ns3/drop-tail-queue.h"
+#include "ns3/ring-buffer.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <algorithm>
+#include <deque>
+
 using namespace ns3;
 
 /**
@@ -87,6 +91,149 @@ DropTailQueueTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(packet, nullptr, "There are really no packets in there");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * DropTailQueue test of the order of the packets, while its ring buffer
+ * wraps around and grows.
+ */
+class DropTailQueueWrapTestCase : public TestCase
+{
+  public:
+    DropTailQueueWrapTestCase();
+    void DoRun() override;
+};
+
+DropTailQueueWrapTestCase::DropTailQueueWrapTestCase()
+    : TestCase("Check the order of the packets of a drop tail queue whose buffer wraps around")
+{
+}
+
+void
+DropTailQueueWrapTestCase::DoRun()
+{
+    Ptr<DropTailQueue<Packet>> queue = CreateObject<DropTailQueue<Packet>>();
+    queue->SetMaxSize(QueueSize("40p"));
+
+    std::deque<uint64_t> uids;
+    for (uint32_t round = 0; round < 50; ++round)
+    {
+        // Enqueue up to 45 packets, so that the last ones are dropped
+        uint32_t enqueued = (round * 7) % 46;
+        for (uint32_t i = 0; i < enqueued; ++i)
+        {
+            Ptr<Packet> packet = Create<Packet>(round + 1);
+            if (queue->Enqueue(packet))
+            {
+                uids.push_back(packet->GetUid());
+            }
+        }
+        NS_TEST_ASSERT_MSG_EQ(queue->GetNPackets(), uids.size(), "Wrong number of packets");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(queue->GetNPackets(), 40, "Too many packets");
+
+        uint32_t dequeued = (round * 5) % 31;
+        for (uint32_t i = 0; i < dequeued && !uids.empty(); ++i)
+        {
+            NS_TEST_ASSERT_MSG_EQ(queue->Peek()->GetUid(), uids.front(), "Wrong first packet");
+            Ptr<Packet> packet = (i % 4 == 3) ? queue->Remove() : queue->Dequeue();
+            NS_TEST_ASSERT_MSG_NE(packet, nullptr, "No packet dequeued");
+            NS_TEST_ASSERT_MSG_EQ(packet->GetUid(), uids.front(), "Wrong packet dequeued");
+            uids.pop_front();
+        }
+    }
+
+    // A packet dequeued from the queue is only referenced by its holder
+    queue->Flush();
+    NS_TEST_EXPECT_MSG_EQ(queue->IsEmpty(), true, "The queue should be empty");
+    Ptr<Packet> packet = Create<Packet>();
+    queue->Enqueue(packet);
+    NS_TEST_EXPECT_MSG_EQ(packet->GetReferenceCount(), 2, "The queue should hold the packet");
+    queue->Dequeue();
+    NS_TEST_EXPECT_MSG_EQ(packet->GetReferenceCount(), 1, "The queue should release the packet");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * RingBuffer test against a std::deque, inserting and erasing elements at
+ * every position.
+ */
+class RingBufferTestCase : public TestCase
+{
+  public:
+    RingBufferTestCase();
+    void DoRun() override;
+};
+
+RingBufferTestCase::RingBufferTestCase()
+    : TestCase("Check the ring buffer container of the queues")
+{
+}
+
+void
+RingBufferTestCase::DoRun()
+{
+    RingBuffer<uint32_t> buffer;
+    std::deque<uint32_t> expected;
+    NS_TEST_EXPECT_MSG_EQ(buffer.empty(), true, "The buffer should be empty");
+    NS_TEST_EXPECT_MSG_EQ(buffer.capacity(), 0, "The buffer should not allocate memory");
+
+    // Append elements and remove the first ones, the buffer growing twice
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        buffer.insert(buffer.end(), i);
+        if (i % 3 != 0)
+        {
+            NS_TEST_ASSERT_MSG_EQ(buffer.front(), i - buffer.size() + 1, "Wrong first element");
+            buffer.erase(buffer.begin());
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(buffer.size(), 34, "Wrong number of elements");
+    NS_TEST_EXPECT_MSG_EQ(buffer.capacity(), 64, "The capacity should be a power of two");
+    buffer.clear();
+    NS_TEST_EXPECT_MSG_EQ(buffer.size(), 0, "The buffer should be empty");
+    NS_TEST_EXPECT_MSG_EQ(buffer.capacity(), 64, "The capacity should be kept");
+
+    // Insert and erase elements at pseudo random positions
+    uint32_t seed = 1;
+    for (uint32_t i = 0; i < 2000; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        uint32_t random = seed >> 16;
+        if (random % 5 < 3 || expected.empty())
+        {
+            uint32_t pos = random % (expected.size() + 1);
+            auto it = buffer.insert(buffer.cbegin() + pos, i);
+            expected.insert(expected.begin() + pos, i);
+            NS_TEST_ASSERT_MSG_EQ(*it, i, "Wrong iterator to the inserted element");
+        }
+        else
+        {
+            uint32_t pos = random % expected.size();
+            auto it = buffer.erase(buffer.cbegin() + pos);
+            expected.erase(expected.begin() + pos);
+            NS_TEST_ASSERT_MSG_EQ((it == buffer.end() || *it == expected[pos]),
+                                  true,
+                                  "Wrong iterator to the next element");
+        }
+        NS_TEST_ASSERT_MSG_EQ(buffer.size(), expected.size(), "Wrong number of elements");
+        NS_TEST_ASSERT_MSG_EQ(std::equal(buffer.begin(), buffer.end(), expected.begin()),
+                              true,
+                              "Wrong elements after operation " << i);
+    }
+
+    // The removed elements are destroyed
+    RingBuffer<Ptr<Packet>> packets;
+    Ptr<Packet> packet = Create<Packet>();
+    packets.insert(packets.end(), packet);
+    packets.insert(packets.begin(), Create<Packet>());
+    NS_TEST_EXPECT_MSG_EQ(packet->GetReferenceCount(), 2, "The buffer should hold the packet");
+    packets.erase(packets.begin() + 1);
+    NS_TEST_EXPECT_MSG_EQ(packet->GetReferenceCount(), 1, "The buffer should release the packet");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -100,6 +247,8 @@ class DropTailQueueTestSuite : public TestSuite
         : TestSuite("drop-tail-queue", UNIT)
     {
         AddTestCase(new DropTailQueueTestCase(), TestCase::QUICK);
+        AddTestCase(new DropTailQueueWrapTestCase(), TestCase::QUICK);
+        AddTestCase(new RingBufferTestCase(), TestCase::QUICK);
     }
 };
 
@@ -879,6 +879,32 @@ PacketMetadataTest::DoRun()
     NS_TEST_EXPECT_MSG_EQ(msg,
                           std::string("hello world"),
                           "Could not find original data in received packet");
+
+    // Copies of a packet whose metadata outgrows the inline buffer.
+    p = Create<Packet>(10);
+    ADD_HEADER(p, 1);
+    ADD_HEADER(p, 2);
+    p1 = p->Copy();
+    ADD_HEADER(p, 3);
+    ADD_HEADER(p1, 4);
+    CHECK_HISTORY(p, 4, 3, 2, 1, 10);
+    CHECK_HISTORY(p1, 4, 4, 2, 1, 10);
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        ADD_HEADER(p, 5);
+        ADD_HEADER(p, 6);
+        ADD_HEADER(p, 7);
+    }
+    p2 = p->Copy();
+    ADD_TRAILER(p2, 8);
+    ADD_HEADER(p1, 9);
+    CHECK_HISTORY(p, 16, 7, 6, 5, 7, 6, 5, 7, 6, 5, 7, 6, 5, 3, 2, 1, 10);
+    CHECK_HISTORY(p1, 5, 9, 4, 2, 1, 10);
+    CHECK_HISTORY(p2, 17, 7, 6, 5, 7, 6, 5, 7, 6, 5, 7, 6, 5, 3, 2, 1, 10, 8);
+    REM_HEADER(p2, 7);
+    REM_TRAILER(p2, 8);
+    CHECK_HISTORY(p2, 15, 6, 5, 7, 6, 5, 7, 6, 5, 7, 6, 5, 3, 2, 1, 10);
+    CHECK_HISTORY(p, 16, 7, 6, 5, 7, 6, 5, 7, 6, 5, 7, 6, 5, 3, 2, 1, 10);
 }
 
 /**
@@ -26,6 +26,7 @@
 #include <iostream>
 #include <limits> // std:numeric_limits
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -1260,6 +1261,350 @@ PacketTagListTest::DoRun()
 } // Timing
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Packet scatter-gather bodies unit test.
+ */
+class PacketScatterGatherTest : public TestCase
+{
+  public:
+    PacketScatterGatherTest();
+
+  private:
+    void DoRun() override;
+    /**
+     * Create a packet with some bytes of the reference pattern.
+     * \param [in] start The offset of the first byte in the pattern.
+     * \param [in] size The number of bytes.
+     * \returns The packet.
+     */
+    Ptr<Packet> CreatePattern(uint32_t start, uint32_t size) const;
+    /**
+     * Check that a packet holds some bytes of the reference pattern.
+     * \param [in] p The packet.
+     * \param [in] start The offset of the first byte in the pattern.
+     * \param [in] size The expected size of the packet.
+     */
+    void CheckPattern(Ptr<const Packet> p, uint32_t start, uint32_t size);
+
+    std::vector<uint8_t> m_pattern; //!< The reference pattern.
+};
+
+PacketScatterGatherTest::PacketScatterGatherTest()
+    : TestCase("Scatter-gather packet bodies")
+{
+    for (uint32_t i = 0; i < 5000; ++i)
+    {
+        m_pattern.push_back(i % 251);
+    }
+}
+
+Ptr<Packet>
+PacketScatterGatherTest::CreatePattern(uint32_t start, uint32_t size) const
+{
+    return Create<Packet>(m_pattern.data() + start, size);
+}
+
+void
+PacketScatterGatherTest::CheckPattern(Ptr<const Packet> p, uint32_t start, uint32_t size)
+{
+    NS_TEST_ASSERT_MSG_EQ(p->GetSize(), size, "Wrong packet size");
+    std::vector<uint8_t> bytes(size);
+    NS_TEST_ASSERT_MSG_EQ(p->CopyData(bytes.data(), size), size, "Wrong copied size");
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(bytes[i], m_pattern[start + i], "Wrong byte " << i);
+    }
+}
+
+void
+PacketScatterGatherTest::DoRun()
+{
+    Packet::EnableScatterGather();
+
+    Ptr<Packet> whole = CreatePattern(0, 1000);
+    Ptr<Packet> b = CreatePattern(1000, 2000);
+    Ptr<Packet> c = CreatePattern(3000, 500);
+    Buffer::AllocatorStats before = Buffer::GetAllocatorStats();
+    whole->AddAtEnd(b);
+    whole->AddAtEnd(c);
+    Buffer::AllocatorStats after = Buffer::GetAllocatorStats();
+    NS_TEST_ASSERT_MSG_EQ(after.hits + after.misses,
+                          before.hits + before.misses,
+                          "AddAtEnd copied the bytes");
+    CheckPattern(whole, 0, 3500);
+
+    Ptr<Packet> fragment = whole->CreateFragment(500, 2800);
+    CheckPattern(fragment, 500, 2800);
+    fragment->RemoveAtStart(600);
+    CheckPattern(fragment, 1100, 2200);
+    fragment->RemoveAtEnd(700);
+    CheckPattern(fragment, 1100, 1500);
+    fragment->AddPaddingAtEnd(10);
+    fragment->RemoveAtEnd(10);
+    CheckPattern(fragment, 1100, 1500);
+
+    // Reassemble fragments out of order, like a reassembly buffer.
+    Ptr<Packet> reassembled = whole->CreateFragment(0, 700);
+    Ptr<Packet> last = whole->CreateFragment(2100, 1400);
+    Ptr<Packet> middle = whole->CreateFragment(700, 1400);
+    reassembled->AddAtEnd(middle);
+    reassembled->AddAtEnd(last);
+    CheckPattern(reassembled, 0, 3500);
+
+    // Headers and trailers need contiguous bytes.
+    ATestHeader<10> header;
+    reassembled->AddHeader(header);
+    ATestTrailer<10> trailer;
+    reassembled->AddTrailer(trailer);
+    NS_TEST_ASSERT_MSG_EQ(reassembled->GetSize(), 3520, "Wrong size with header and trailer");
+    ATestHeader<10> removedHeader;
+    reassembled->RemoveHeader(removedHeader);
+    NS_TEST_ASSERT_MSG_EQ(removedHeader.m_error, false, "Wrong header");
+    ATestTrailer<10> removedTrailer;
+    reassembled->RemoveTrailer(removedTrailer);
+    NS_TEST_ASSERT_MSG_EQ(removedTrailer.m_error, false, "Wrong trailer");
+    CheckPattern(reassembled, 0, 3500);
+
+    // Appending a packet to itself.
+    Ptr<Packet> twice = whole->CreateFragment(0, 1500);
+    twice->AddAtEnd(twice);
+    CheckPattern(twice->CreateFragment(0, 1500), 0, 1500);
+    CheckPattern(twice->CreateFragment(1500, 1500), 0, 1500);
+
+    // Without scatter-gather, the segments are copied.
+    Packet::DisableScatterGather();
+    Ptr<Packet> linear = whole->CreateFragment(0, 1000);
+    linear->AddAtEnd(whole->CreateFragment(1000, 2500));
+    CheckPattern(linear, 0, 3500);
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Inline storage of the packet and byte tags unit test.
+ */
+class PacketInlineTagTest : public TestCase
+{
+  public:
+    PacketInlineTagTest();
+
+  private:
+    void DoRun() override;
+    /**
+     * Count the packet tags of a packet.
+     * \param p The packet.
+     * \return the number of packet tags.
+     */
+    uint32_t CountPacketTags(Ptr<const Packet> p) const;
+    /**
+     * Count the byte tags of a packet.
+     * \param p The packet.
+     * \return the number of byte tags.
+     */
+    uint32_t CountByteTags(Ptr<const Packet> p) const;
+    /**
+     * Measure the time to add, peek and remove a packet tag.
+     * \param tag The tag.
+     * \return the ticks to add, peek and remove the tag.
+     */
+    int PacketTagTime(ATestTagBase& tag) const;
+    /**
+     * Measure the time to add a byte tag to a copy of a packet and iterate over it.
+     * \param tag The tag.
+     * \return the ticks to add the tag and iterate over it.
+     */
+    int ByteTagTime(const ATestTagBase& tag) const;
+};
+
+PacketInlineTagTest::PacketInlineTagTest()
+    : TestCase("Inline packet and byte tags")
+{
+}
+
+uint32_t
+PacketInlineTagTest::CountPacketTags(Ptr<const Packet> p) const
+{
+    uint32_t n = 0;
+    PacketTagIterator i = p->GetPacketTagIterator();
+    while (i.HasNext())
+    {
+        i.Next();
+        n++;
+    }
+    return n;
+}
+
+uint32_t
+PacketInlineTagTest::CountByteTags(Ptr<const Packet> p) const
+{
+    uint32_t n = 0;
+    ByteTagIterator i = p->GetByteTagIterator();
+    while (i.HasNext())
+    {
+        i.Next();
+        n++;
+    }
+    return n;
+}
+
+int
+PacketInlineTagTest::PacketTagTime(ATestTagBase& tag) const
+{
+    const int reps = 100000;
+    Ptr<Packet> p = Create<Packet>(100);
+    int start = clock();
+    for (int i = 0; i < reps; ++i)
+    {
+        p->AddPacketTag(tag);
+        p->PeekPacketTag(tag);
+        p->RemovePacketTag(tag);
+    }
+    return clock() - start;
+}
+
+int
+PacketInlineTagTest::ByteTagTime(const ATestTagBase& tag) const
+{
+    const int reps = 100000;
+    Ptr<Packet> p = Create<Packet>(100);
+    int start = clock();
+    for (int i = 0; i < reps; ++i)
+    {
+        Ptr<Packet> copy = p->Copy();
+        copy->AddByteTag(tag);
+        CountByteTags(copy);
+    }
+    return clock() - start;
+}
+
+void
+PacketInlineTagTest::DoRun()
+{
+    // The fifth small tag, and the large tags, are not inline.
+    Ptr<Packet> p = Create<Packet>(100);
+    p->AddPacketTag(ATestTag<1>(1));
+    p->AddPacketTag(ATestTag<2>(1));
+    p->AddPacketTag(ATestTag<3>(1));
+    p->AddPacketTag(ATestTag<4>(1));
+    p->AddPacketTag(ATestTag<5>(1));
+    p->AddPacketTag(ALargeTestTag());
+    NS_TEST_EXPECT_MSG_EQ(CountPacketTags(p), 6, "Wrong number of packet tags");
+
+    Ptr<Packet> copy = p->Copy();
+    ATestTag<1> t1;
+    NS_TEST_EXPECT_MSG_EQ(copy->RemovePacketTag(t1), true, "Missing inline tag");
+    ATestTag<2> t2(2);
+    copy->ReplacePacketTag(t2);
+    ATestTag<30> large(3);
+    copy->ReplacePacketTag(large);
+    NS_TEST_EXPECT_MSG_EQ(CountPacketTags(copy), 6, "Wrong number of packet tags in the copy");
+    NS_TEST_EXPECT_MSG_EQ(CountPacketTags(p), 6, "The copy changed the packet tags");
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(t1), true, "The copy removed the original tag");
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(t2), true, "Missing inline tag");
+    NS_TEST_EXPECT_MSG_EQ(t2.GetData(), 1, "The copy replaced the original tag");
+    NS_TEST_EXPECT_MSG_EQ(copy->PeekPacketTag(t2), true, "Missing replaced tag");
+    NS_TEST_EXPECT_MSG_EQ(t2.GetData(), 2, "Wrong replaced tag");
+    ATestTag<5> t5;
+    NS_TEST_EXPECT_MSG_EQ(copy->PeekPacketTag(t5), true, "Missing tag");
+    ALargeTestTag largeTag;
+    NS_TEST_EXPECT_MSG_EQ(copy->PeekPacketTag(largeTag), true, "Missing large tag");
+
+    // A removed inline tag, added again and replaced.
+    ATestTag<1> grown(4);
+    copy->AddPacketTag(grown);
+    ATestTag<1> replaced(5);
+    NS_TEST_EXPECT_MSG_EQ(copy->ReplacePacketTag(replaced), true, "Missing inline tag");
+    NS_TEST_EXPECT_MSG_EQ(copy->PeekPacketTag(t1), true, "Missing replaced tag");
+    NS_TEST_EXPECT_MSG_EQ(t1.GetData(), 5, "Wrong replaced tag");
+
+    // The third small byte tag is not inline.
+    Ptr<Packet> bytes = Create<Packet>(100);
+    bytes->AddByteTag(ATestTag<1>(1), 0, 50);
+    Ptr<Packet> bytesCopy = bytes->Copy();
+    bytesCopy->AddByteTag(ATestTag<2>(1), 50, 100);
+    bytesCopy->AddByteTag(ATestTag<3>(1));
+    NS_TEST_EXPECT_MSG_EQ(CountByteTags(bytes), 1, "The copy changed the byte tags");
+    NS_TEST_EXPECT_MSG_EQ(CountByteTags(bytesCopy), 3, "Wrong number of byte tags");
+    bytesCopy->AddAtEnd(bytes);
+    NS_TEST_EXPECT_MSG_EQ(CountByteTags(bytesCopy), 4, "Wrong number of appended byte tags");
+    NS_TEST_EXPECT_MSG_EQ(CountByteTags(bytesCopy->CreateFragment(0, 50)),
+                          2,
+                          "Wrong number of byte tags in the fragment");
+
+    std::cout << GetName() << ": add+peek+remove packet tag time: inline " << std::setw(8)
+              << PacketTagTime(t1) << " ticks, list " << std::setw(8) << PacketTagTime(large)
+              << " ticks" << std::endl;
+    ATestTag<40> largeByteTag;
+    std::cout << GetName() << ": add+iterate byte tag time: inline " << std::setw(8)
+              << ByteTagTime(t1) << " ticks, heap " << std::setw(8) << ByteTagTime(largeByteTag)
+              << " ticks" << std::endl;
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Pool of packets unit test.
+ */
+class PacketPoolTest : public TestCase
+{
+  public:
+    PacketPoolTest();
+
+  private:
+    void DoRun() override;
+};
+
+PacketPoolTest::PacketPoolTest()
+    : TestCase("Pool of packets")
+{
+}
+
+void
+PacketPoolTest::DoRun()
+{
+    Packet::EnablePool();
+    {
+        // Fill the pool of this thread.
+        std::vector<Ptr<Packet>> packets;
+        for (uint32_t i = 0; i < 10; ++i)
+        {
+            Ptr<Packet> p = Create<Packet>(100);
+            p->AddPacketTag(ATestTag<1>(1));
+            p->AddByteTag(ATestTag<2>(1));
+            packets.push_back(p);
+        }
+    }
+
+    Packet::PoolStats before = Packet::GetPoolStats();
+    Ptr<Packet> reused = Create<Packet>(10);
+    Ptr<Packet> copy = reused->Copy();
+    Packet::PoolStats after = Packet::GetPoolStats();
+    NS_TEST_EXPECT_MSG_EQ(after.hits, before.hits + 2, "The packets were not reused");
+    NS_TEST_EXPECT_MSG_EQ(after.misses, before.misses, "The packets were allocated");
+    NS_TEST_EXPECT_MSG_EQ(reused->GetSize(), 10, "Wrong size of the reused packet");
+    NS_TEST_EXPECT_MSG_EQ(copy->GetSize(), 10, "Wrong size of the reused copy");
+    ATestTag<1> packetTag;
+    NS_TEST_EXPECT_MSG_EQ(reused->PeekPacketTag(packetTag), false, "Stale packet tag");
+    NS_TEST_EXPECT_MSG_EQ(reused->GetByteTagIterator().HasNext(), false, "Stale byte tag");
+    NS_TEST_EXPECT_MSG_EQ(copy->GetUid(), reused->GetUid(), "Wrong uid of the copy");
+
+    // Without the pool, the packets do not go through it.
+    Packet::DisablePool();
+    before = Packet::GetPoolStats();
+    copy = nullptr;
+    reused = Create<Packet>(10);
+    reused = nullptr;
+    after = Packet::GetPoolStats();
+    NS_TEST_EXPECT_MSG_EQ(after.hits, before.hits, "The pool was used while disabled");
+    NS_TEST_EXPECT_MSG_EQ(after.misses, before.misses, "The pool was used while disabled");
+    Packet::EnablePool();
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1277,6 +1622,9 @@ PacketTestSuite::PacketTestSuite()
 {
     AddTestCase(new PacketTest, TestCase::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::QUICK);
+    AddTestCase(new PacketScatterGatherTest, TestCase::QUICK);
+    AddTestCase(new PacketInlineTagTest, TestCase::QUICK);
+    AddTestCase(new PacketPoolTest, TestCase::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
@@ -17,13 +17,22 @@
 
 #include "ns3/log.h"
 #include "ns3/pcap-file.h"
+#include "ns3/pcap-reader.h"
 #include "ns3/test.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <sstream>
+#include <vector>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 using namespace ns3;
 
@@ -1375,6 +1384,276 @@ DiffTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that the pcapng, asynchronous and compressed
+ * outputs write the expected records.
+ */
+class WriterTestCase : public TestCase
+{
+  public:
+    WriterTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Write the test records to a file.
+     * \param filename The name of the file.
+     * \param format The format of the file.
+     * \param async Whether the records are written by a background thread.
+     * \param compress Whether the file is compressed.
+     */
+    void WriteFile(std::string filename, PcapFile::Format format, bool async, bool compress);
+    /**
+     * Read the bytes of a file.
+     * \param filename The name of the file.
+     * \returns The bytes of the file.
+     */
+    std::vector<uint8_t> ReadFile(std::string filename);
+
+    static const uint32_t N_RECORDS = 5000; //!< Number of records written, a few blocks
+    static const uint32_t SNAPLEN = 1000;   //!< Snaplen of the files
+    uint8_t m_data[1500];                   //!< The data of the packets
+};
+
+WriterTestCase::WriterTestCase()
+    : TestCase("Check the pcapng, asynchronous and compressed outputs")
+{
+}
+
+void
+WriterTestCase::WriteFile(std::string filename, PcapFile::Format format, bool async, bool compress)
+{
+    PcapFile f;
+    f.SetFormat(format);
+    f.SetAsynchronous(async);
+    f.SetCompression(compress);
+    f.Open(filename, std::ios::out);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Open (" << filename << ") returns error");
+    f.Init(1, SNAPLEN);
+    for (uint32_t i = 0; i < N_RECORDS; ++i)
+    {
+        f.Write(i / 100, (i % 100) * 10000, m_data, i * 37 % 1500 + 1);
+    }
+    NS_TEST_EXPECT_MSG_EQ(f.Fail(), false, "Write to " << filename << " returns error");
+    f.Close();
+    NS_TEST_EXPECT_MSG_EQ(f.Fail(), false, "Close (" << filename << ") returns error");
+}
+
+std::vector<uint8_t>
+WriterTestCase::ReadFile(std::string filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file),
+                                std::istreambuf_iterator<char>());
+}
+
+void
+WriterTestCase::DoRun()
+{
+    for (uint32_t i = 0; i < sizeof(m_data); ++i)
+    {
+        m_data[i] = i * 7;
+    }
+
+    std::string pcapFilename = CreateTempDirFilename("writer.pcap");
+    std::string asyncFilename = CreateTempDirFilename("writer-async.pcap");
+    WriteFile(pcapFilename, PcapFile::PCAP, false, false);
+    WriteFile(asyncFilename, PcapFile::PCAP, true, false);
+    std::vector<uint8_t> pcap = ReadFile(pcapFilename);
+    NS_TEST_EXPECT_MSG_EQ((ReadFile(asyncFilename) == pcap),
+                          true,
+                          "Asynchronous output differs from the synchronous one");
+    uint32_t sec = 0;
+    uint32_t usec = 0;
+    uint32_t packets = 0;
+    NS_TEST_EXPECT_MSG_EQ(PcapFile::Diff(pcapFilename, asyncFilename, sec, usec, packets),
+                          false,
+                          "Asynchronous output is not a valid pcap file");
+    NS_TEST_EXPECT_MSG_EQ(packets, N_RECORDS, "Wrong number of packets read back");
+
+    //
+    // Walk the blocks of the pcapng file: a section header, an interface
+    // description and the enhanced packet blocks.
+    //
+    std::string pcapngFilename = CreateTempDirFilename("writer.pcapng");
+    std::string asyncPcapngFilename = CreateTempDirFilename("writer-async.pcapng");
+    WriteFile(pcapngFilename, PcapFile::PCAPNG, false, false);
+    WriteFile(asyncPcapngFilename, PcapFile::PCAPNG, true, false);
+    std::vector<uint8_t> pcapng = ReadFile(pcapngFilename);
+    NS_TEST_EXPECT_MSG_EQ((ReadFile(asyncPcapngFilename) == pcapng),
+                          true,
+                          "Asynchronous pcapng output differs from the synchronous one");
+    auto field = [&pcapng](uint32_t offset) {
+        uint32_t value;
+        std::memcpy(&value, &pcapng[offset], sizeof(value));
+        return value;
+    };
+    NS_TEST_ASSERT_MSG_GT(pcapng.size(), 60, "pcapng file too short");
+    NS_TEST_EXPECT_MSG_EQ(field(0), 0x0a0d0d0a, "Missing section header block");
+    NS_TEST_EXPECT_MSG_EQ(field(8), 0x1a2b3c4d, "Wrong byte order magic");
+    NS_TEST_EXPECT_MSG_EQ(field(28), 1, "Missing interface description block");
+    NS_TEST_EXPECT_MSG_EQ(field(28 + 12), SNAPLEN, "Wrong interface snaplen");
+    NS_TEST_EXPECT_MSG_EQ(pcapng[28 + 20], 6, "Wrong timestamp resolution");
+    uint32_t offset = 28 + 32;
+    uint32_t records = 0;
+    while (offset + 32 <= pcapng.size())
+    {
+        uint32_t origLen = records * 37 % 1500 + 1;
+        uint32_t inclLen = std::min(origLen, SNAPLEN);
+        uint64_t ts = (records / 100) * 1000000ULL + (records % 100) * 10000;
+        uint32_t length = field(offset + 4);
+        NS_TEST_ASSERT_MSG_EQ(field(offset), 6, "Missing enhanced packet block " << records);
+        NS_TEST_ASSERT_MSG_EQ(length, 32 + ((inclLen + 3) & ~3U), "Wrong block length");
+        NS_TEST_ASSERT_MSG_EQ(field(offset + length - 4), length, "Wrong trailing length");
+        NS_TEST_EXPECT_MSG_EQ(field(offset + 12), (ts >> 32), "Wrong timestamp");
+        NS_TEST_EXPECT_MSG_EQ(field(offset + 16), (ts & 0xffffffff), "Wrong timestamp");
+        NS_TEST_EXPECT_MSG_EQ(field(offset + 20), inclLen, "Wrong captured length");
+        NS_TEST_EXPECT_MSG_EQ(field(offset + 24), origLen, "Wrong original length");
+        NS_TEST_EXPECT_MSG_EQ(std::memcmp(&pcapng[offset + 28], m_data, inclLen),
+                              0,
+                              "Wrong packet data");
+        offset += length;
+        records++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(offset, pcapng.size(), "Trailing bytes in the pcapng file");
+    NS_TEST_EXPECT_MSG_EQ(records, N_RECORDS, "Wrong number of enhanced packet blocks");
+
+#ifdef HAVE_ZLIB
+    std::string gzFilename = CreateTempDirFilename("writer.pcap.gz");
+    WriteFile(gzFilename, PcapFile::PCAP, true, true);
+    NS_TEST_EXPECT_MSG_LT(ReadFile(gzFilename).size(),
+                          pcap.size() / 2,
+                          "Compressed output is not compressed");
+    std::vector<uint8_t> uncompressed(pcap.size() + 1);
+    gzFile gz = gzopen(gzFilename.c_str(), "rb");
+    NS_TEST_ASSERT_MSG_NE(gz, nullptr, "Unable to open the compressed output");
+    int read = gzread(gz, uncompressed.data(), uncompressed.size());
+    gzclose(gz);
+    uncompressed.resize(std::max(read, 0));
+    NS_TEST_EXPECT_MSG_EQ((uncompressed == pcap),
+                          true,
+                          "Compressed output differs from the uncompressed one");
+#endif
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that PcapReader reads the records of pcap
+ * and pcapng files.
+ */
+class PcapReaderTestCase : public TestCase
+{
+  public:
+    PcapReaderTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PcapReaderTestCase::PcapReaderTestCase()
+    : TestCase("Check that PcapReader reads pcap and pcapng files")
+{
+}
+
+void
+PcapReaderTestCase::DoRun()
+{
+    //
+    // The records of the known good pcap file, as read by PcapFile.
+    //
+    std::string filename = CreateDataDirFilename("known.pcap");
+    PcapFile f;
+    f.Open(filename, std::ios::in);
+    PcapReader reader;
+    NS_TEST_ASSERT_MSG_EQ(reader.Open(filename), true, "Unable to open " << filename);
+    NS_TEST_EXPECT_MSG_EQ(reader.IsPcapNg(), false, "known.pcap is not a pcapng file");
+    NS_TEST_EXPECT_MSG_EQ(reader.GetDataLinkType(), f.GetDataLinkType(), "Wrong data link type");
+    uint8_t data[PcapFile::SNAPLEN_DEFAULT];
+    uint32_t tsSec;
+    uint32_t tsUsec;
+    uint32_t inclLen;
+    uint32_t origLen;
+    uint32_t readLen;
+    PcapReader::Record record;
+    uint32_t records = 0;
+    while (reader.Next(record))
+    {
+        f.Read(data, sizeof(data), tsSec, tsUsec, inclLen, origLen, readLen);
+        NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "PcapReader reads too many records");
+        NS_TEST_EXPECT_MSG_EQ(record.time,
+                              tsSec * 1000000000ULL + tsUsec * 1000,
+                              "Wrong timestamp of record " << records);
+        NS_TEST_EXPECT_MSG_EQ(record.inclLen, inclLen, "Wrong length of record " << records);
+        NS_TEST_EXPECT_MSG_EQ(record.origLen, origLen, "Wrong length of record " << records);
+        NS_TEST_EXPECT_MSG_EQ(std::memcmp(record.data, data, inclLen),
+                              0,
+                              "Wrong data of record " << records);
+        records++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(reader.Fail(), false, "PcapReader fails on a valid file");
+    NS_TEST_EXPECT_MSG_EQ(records, N_KNOWN_PACKETS, "Wrong number of records");
+    reader.Rewind();
+    NS_TEST_EXPECT_MSG_EQ(reader.Next(record), true, "Unable to read a rewound file");
+    NS_TEST_EXPECT_MSG_EQ(record.time, 2000000000ULL + 3696000, "Wrong first record");
+
+    //
+    // A truncated copy of it.
+    //
+    std::ifstream known(filename, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(known)), std::istreambuf_iterator<char>());
+    std::string truncatedFilename = CreateTempDirFilename("truncated.pcap");
+    std::ofstream(truncatedFilename, std::ios::binary).write(bytes.data(), bytes.size() - 5);
+    NS_TEST_ASSERT_MSG_EQ(reader.Open(truncatedFilename), true, "Unable to open a truncated file");
+    records = 0;
+    while (reader.Next(record))
+    {
+        records++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(records, N_KNOWN_PACKETS - 1, "Wrong number of complete records");
+    NS_TEST_EXPECT_MSG_EQ(reader.Fail(), true, "PcapReader does not fail on a truncated file");
+
+    //
+    // A nanosecond pcapng file, in the foreign byte order.
+    //
+    std::string pcapngFilename = CreateTempDirFilename("reader.pcapng");
+    PcapFile g;
+    g.SetFormat(PcapFile::PCAPNG);
+    g.Open(pcapngFilename, std::ios::out);
+    g.Init(113, 8, 0, true, true);
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        g.Write(i, i * 1000 + 1, reinterpret_cast<const uint8_t*>("0123456789"), i + 1);
+    }
+    g.Close();
+    NS_TEST_ASSERT_MSG_EQ(reader.Open(pcapngFilename), true, "Unable to open a pcapng file");
+    NS_TEST_EXPECT_MSG_EQ(reader.IsPcapNg(), true, "Not read as a pcapng file");
+    NS_TEST_EXPECT_MSG_EQ(reader.GetDataLinkType(), 113, "Wrong data link type");
+    records = 0;
+    while (reader.Next(record))
+    {
+        NS_TEST_EXPECT_MSG_EQ(record.time,
+                              records * 1000000000ULL + records * 1000 + 1,
+                              "Wrong timestamp of record " << records);
+        NS_TEST_EXPECT_MSG_EQ(record.inclLen,
+                              std::min(records + 1, 8U),
+                              "Wrong length of record " << records);
+        NS_TEST_EXPECT_MSG_EQ(record.origLen, records + 1, "Wrong length of record " << records);
+        NS_TEST_EXPECT_MSG_EQ(std::memcmp(record.data, "0123456789", record.inclLen),
+                              0,
+                              "Wrong data of record " << records);
+        NS_TEST_EXPECT_MSG_EQ(record.linkType, 113, "Wrong data link type of record " << records);
+        records++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(reader.Fail(), false, "PcapReader fails on a valid pcapng file");
+    NS_TEST_EXPECT_MSG_EQ(records, 10, "Wrong number of pcapng records");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1398,6 +1677,8 @@ PcapFileTestSuite::PcapFileTestSuite()
     AddTestCase(new RecordHeaderTestCase, TestCase::QUICK);
     AddTestCase(new ReadFileTestCase, TestCase::QUICK);
     AddTestCase(new DiffTestCase, TestCase::QUICK);
+    AddTestCase(new WriterTestCase, TestCase::QUICK);
+    AddTestCase(new PcapReaderTestCase, TestCase::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,175 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/double.h"
+#include "ns3/mac48-address.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/pcap-file.h"
+#include "ns3/pcap-replay-application.h"
+#include "ns3/pointer.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Replay captures through a SimpleNetDevice, and check the frames
+ * received by another one.
+ */
+class PcapReplayTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * \param pcapng Whether the capture is a pcapng file of raw IPv6 packets,
+     * rather than a pcap file of Ethernet frames.
+     */
+    PcapReplayTestCase(bool pcapng);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Receive a frame
+     * \param device The receiving device.
+     * \param packet The received packet.
+     * \param protocol The protocol number.
+     * \param sender The sender address.
+     * \return true
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& sender);
+
+    bool m_pcapng;                     //!< Whether the capture is a pcapng file
+    std::vector<Time> m_times;         //!< Reception times
+    std::vector<uint32_t> m_sizes;     //!< Sizes of the received packets
+    std::vector<uint16_t> m_protocols; //!< Protocols of the received packets
+};
+
+PcapReplayTestCase::PcapReplayTestCase(bool pcapng)
+    : TestCase(pcapng ? "Replay a pcapng file of IPv6 packets"
+                      : "Replay a pcap file of Ethernet frames"),
+      m_pcapng(pcapng)
+{
+}
+
+bool
+PcapReplayTestCase::Receive(Ptr<NetDevice> device,
+                            Ptr<const Packet> packet,
+                            uint16_t protocol,
+                            const Address& sender)
+{
+    m_times.push_back(Simulator::Now());
+    m_sizes.push_back(packet->GetSize());
+    m_protocols.push_back(protocol);
+    return true;
+}
+
+void
+PcapReplayTestCase::DoRun()
+{
+    NodeContainer nodes(2);
+    SimpleNetDeviceHelper helper;
+    NetDeviceContainer devices = helper.Install(nodes);
+    devices.Get(1)->SetReceiveCallback(MakeCallback(&PcapReplayTestCase::Receive, this));
+    Mac48Address destination = Mac48Address::ConvertFrom(devices.Get(1)->GetAddress());
+
+    //
+    // Four frames of 114 bytes, sent 0, 1, 1 and 3 ms after the first one,
+    // and captured with a snaplen of 64 bytes.
+    //
+    std::string filename = CreateTempDirFilename(m_pcapng ? "replay.pcapng" : "replay.pcap");
+    PcapFile file;
+    file.SetFormat(m_pcapng ? PcapFile::PCAPNG : PcapFile::PCAP);
+    file.Open(filename, std::ios::out);
+    file.Init(m_pcapng ? 229 : 1, 64, 0, false, m_pcapng);
+    uint8_t frame[114] = {};
+    if (m_pcapng)
+    {
+        frame[0] = 0x60;
+    }
+    else
+    {
+        destination.CopyTo(frame);
+        frame[12] = 0x08;
+    }
+    uint32_t offsets[] = {0, 1, 1, 3};
+    for (uint32_t offset : offsets)
+    {
+        file.Write(5, (m_pcapng ? 1000000 : 1000) * offset, frame, sizeof(frame));
+    }
+    file.Close();
+
+    Ptr<PcapReplayApplication> app = CreateObject<PcapReplayApplication>();
+    app->SetAttribute("File", StringValue(filename));
+    app->SetAttribute("Device", PointerValue(devices.Get(0)));
+    if (m_pcapng)
+    {
+        app->SetAttribute("RemoteAddress", AddressValue(destination));
+        app->SetAttribute("TimeScale", DoubleValue(0));
+    }
+    else
+    {
+        app->SetAttribute("TimeScale", DoubleValue(2));
+    }
+    app->SetStartTime(Seconds(1));
+    nodes.Get(0)->AddApplication(app);
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(app->GetSent(), 4, "Wrong number of frames sent");
+    NS_TEST_ASSERT_MSG_EQ(m_times.size(), 4, "Wrong number of frames received");
+    uint32_t size = m_pcapng ? 114 : 100;
+    uint16_t protocol = m_pcapng ? 0x86dd : 0x0800;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        Time expected = m_pcapng ? Seconds(1) : Seconds(1) + MilliSeconds(2 * offsets[i]);
+        NS_TEST_EXPECT_MSG_EQ(m_times[i], expected, "Wrong reception time of frame " << i);
+        NS_TEST_EXPECT_MSG_EQ(m_sizes[i], size, "Wrong size of frame " << i << ", with padding");
+        NS_TEST_EXPECT_MSG_EQ(m_protocols[i], protocol, "Wrong protocol of frame " << i);
+    }
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief PcapReplayApplication TestSuite
+ */
+class PcapReplayTestSuite : public TestSuite
+{
+  public:
+    PcapReplayTestSuite();
+};
+
+PcapReplayTestSuite::PcapReplayTestSuite()
+    : TestSuite("pcap-replay", UNIT)
+{
+    AddTestCase(new PcapReplayTestCase(false), TestCase::QUICK);
+    AddTestCase(new PcapReplayTestCase(true), TestCase::QUICK);
+}
+
+static PcapReplayTestSuite g_pcapReplayTestSuite; //!< Static variable for test initialization
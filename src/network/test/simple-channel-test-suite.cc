@@ -0,0 +1,200 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/mac48-address.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Send unicast and broadcast frames through a SimpleChannel, and
+ * check which devices receive them, in which order and context, while the
+ * addresses, the blacklists and the promiscuous devices change.
+ */
+class SimpleChannelTestCase : public TestCase
+{
+  public:
+    SimpleChannelTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Receive a frame
+     * \param device The receiving device.
+     * \param packet The received packet.
+     * \param protocol The protocol number.
+     * \param sender The sender address.
+     * \return true
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& sender);
+
+    /**
+     * Receive a frame in promiscuous mode
+     * \param device The receiving device.
+     * \param packet The received packet.
+     * \param protocol The protocol number.
+     * \param sender The sender address.
+     * \param receiver The destination address.
+     * \param packetType The packet type.
+     * \return true
+     */
+    bool PromiscReceive(Ptr<NetDevice> device,
+                        Ptr<const Packet> packet,
+                        uint16_t protocol,
+                        const Address& sender,
+                        const Address& receiver,
+                        NetDevice::PacketType packetType);
+
+    /**
+     * Send a frame
+     * \param device The sending device.
+     * \param destination The destination address.
+     */
+    void Send(Ptr<NetDevice> device, Address destination);
+
+    NetDeviceContainer m_devices; //!< The devices
+    std::ostringstream m_log;     //!< The receptions, as "time:device:context:kind"
+};
+
+SimpleChannelTestCase::SimpleChannelTestCase()
+    : TestCase("Check the receivers of the frames sent through a SimpleChannel")
+{
+}
+
+bool
+SimpleChannelTestCase::Receive(Ptr<NetDevice> device,
+                               Ptr<const Packet> packet,
+                               uint16_t protocol,
+                               const Address& sender)
+{
+    m_log << Simulator::Now().GetSeconds() << ":" << device->GetIfIndex() << ":"
+          << Simulator::GetContext() << ":rx ";
+    return true;
+}
+
+bool
+SimpleChannelTestCase::PromiscReceive(Ptr<NetDevice> device,
+                                      Ptr<const Packet> packet,
+                                      uint16_t protocol,
+                                      const Address& sender,
+                                      const Address& receiver,
+                                      NetDevice::PacketType packetType)
+{
+    if (packetType == NetDevice::PACKET_OTHERHOST)
+    {
+        m_log << Simulator::Now().GetSeconds() << ":" << device->GetIfIndex() << ":"
+              << Simulator::GetContext() << ":other ";
+    }
+    return true;
+}
+
+void
+SimpleChannelTestCase::Send(Ptr<NetDevice> device, Address destination)
+{
+    device->Send(Create<Packet>(100), destination, 0x0800);
+}
+
+void
+SimpleChannelTestCase::DoRun()
+{
+    // Devices 0, 1 and 2 on nodes 0, 1 and 2, and device 3 on node 2
+    NodeContainer nodes(3);
+    SimpleNetDeviceHelper helper;
+    m_devices = helper.Install(nodes);
+    Ptr<SimpleChannel> channel = DynamicCast<SimpleChannel>(m_devices.Get(0)->GetChannel());
+    m_devices.Add(helper.Install(nodes.Get(2), channel));
+    for (uint32_t i = 0; i < m_devices.GetN(); ++i)
+    {
+        m_devices.Get(i)->SetIfIndex(i);
+        m_devices.Get(i)->SetReceiveCallback(MakeCallback(&SimpleChannelTestCase::Receive, this));
+    }
+    Ptr<SimpleNetDevice> device0 = DynamicCast<SimpleNetDevice>(m_devices.Get(0));
+    Ptr<SimpleNetDevice> device2 = DynamicCast<SimpleNetDevice>(m_devices.Get(2));
+    Ptr<SimpleNetDevice> device3 = DynamicCast<SimpleNetDevice>(m_devices.Get(3));
+    Address broadcast = device0->GetBroadcast();
+    Address address1 = m_devices.Get(1)->GetAddress();
+    Address address3 = m_devices.Get(3)->GetAddress();
+    Mac48Address newAddress1 = Mac48Address::Allocate();
+
+    // Unicast and broadcast
+    Simulator::Schedule(Seconds(1), &SimpleChannelTestCase::Send, this, device0, address1);
+    Simulator::Schedule(Seconds(2), &SimpleChannelTestCase::Send, this, device0, broadcast);
+    Simulator::Schedule(Seconds(3), &SimpleChannelTestCase::Send, this, device2, broadcast);
+    // Device 3 blocks device 0
+    Simulator::Schedule(Seconds(4), &SimpleChannel::BlackList, channel, device0, device3);
+    Simulator::Schedule(Seconds(5), &SimpleChannelTestCase::Send, this, device0, broadcast);
+    Simulator::Schedule(Seconds(5), &SimpleChannelTestCase::Send, this, device0, address3);
+    Simulator::Schedule(Seconds(6), &SimpleChannel::UnBlackList, channel, device0, device3);
+    Simulator::Schedule(Seconds(7), &SimpleChannelTestCase::Send, this, device0, address3);
+    // Device 2 receives the frames addressed to other devices
+    Simulator::Schedule(Seconds(8),
+                        &SimpleNetDevice::SetPromiscReceiveCallback,
+                        device2,
+                        MakeCallback(&SimpleChannelTestCase::PromiscReceive, this));
+    Simulator::Schedule(Seconds(9), &SimpleChannelTestCase::Send, this, device0, address1);
+    // Device 1 changes its address
+    Simulator::Schedule(Seconds(10), &NetDevice::SetAddress, m_devices.Get(1), newAddress1);
+    Simulator::Schedule(Seconds(11), &SimpleChannelTestCase::Send, this, device0, address1);
+    Simulator::Schedule(Seconds(12), &SimpleChannelTestCase::Send, this, device3, newAddress1);
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    std::string expected = "1:1:1:rx "
+                           "2:1:1:rx 2:2:2:rx 2:3:2:rx "
+                           "3:0:0:rx 3:1:1:rx 3:3:2:rx "
+                           "5:1:1:rx 5:2:2:rx "
+                           "7:3:2:rx "
+                           "9:1:1:rx 9:2:2:other "
+                           "11:2:2:other "
+                           "12:1:1:rx 12:2:2:other ";
+    NS_TEST_EXPECT_MSG_EQ(m_log.str(), expected, "Wrong receivers");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief SimpleChannel TestSuite
+ */
+class SimpleChannelTestSuite : public TestSuite
+{
+  public:
+    SimpleChannelTestSuite();
+};
+
+SimpleChannelTestSuite::SimpleChannelTestSuite()
+    : TestSuite("simple-channel", UNIT)
+{
+    AddTestCase(new SimpleChannelTestCase, TestCase::QUICK);
+}
+
+static SimpleChannelTestSuite g_simpleChannelTestSuite; //!< Static variable for test initialization
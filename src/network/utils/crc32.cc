@@ -24,8 +24,17 @@
  * COPYRIGHT (C) 1986 Gary S. Brown.  You may use this program, or
  * code or tables extracted from it, as desired without restriction.
  */
+#include "crc32.h"
+
+#include <stddef.h>
 #include <stdint.h>
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define NS3_CRC32_PCLMUL
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 namespace ns3
 {
 
@@ -67,16 +76,275 @@ static uint32_t crc32table[256] = {
     0xB3667A2E, 0xC4614AB8, 0x5D681B02, 0x2A6F2B94, 0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D,
 };
 
-uint32_t
-CRC32Calculate(const uint8_t* data, int length)
+/**
+ * Tables of the slice-by-8 algorithm: entry i of table k is the CRC-32
+ * state after byte i followed by k zero bytes, so that table 0 is
+ * crc32table.
+ */
+struct Crc32SliceTables
 {
-    uint32_t crc = 0xffffffff;
+    uint32_t table[8][256]; //!< The tables
+};
+
+/**
+ * Compute the tables of the slice-by-8 algorithm.
+ * \returns the tables
+ */
+static constexpr Crc32SliceTables
+MakeCrc32SliceTables()
+{
+    Crc32SliceTables tables{};
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+        }
+        tables.table[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        for (int k = 1; k < 8; ++k)
+        {
+            uint32_t previous = tables.table[k - 1][i];
+            tables.table[k][i] = (previous >> 8) ^ tables.table[0][previous & 0xFF];
+        }
+    }
+    return tables;
+}
 
+/**
+ * Tables of the slice-by-8 algorithm.
+ */
+static constexpr Crc32SliceTables crc32SliceTables = MakeCrc32SliceTables();
+
+/**
+ * Update a CRC-32 state one byte at a time.
+ * \param crc the state
+ * \param data the bytes
+ * \param length the number of bytes
+ * \returns the new state
+ */
+static uint32_t
+Crc32UpdateBytewise(uint32_t crc, const uint8_t* data, size_t length)
+{
     while (length--)
     {
         crc = (crc >> 8) ^ crc32table[(crc & 0xFF) ^ *data++];
     }
+    return crc;
+}
+
+/**
+ * Update a CRC-32 state eight bytes at a time.
+ * \param crc the state
+ * \param data the bytes
+ * \param length the number of bytes
+ * \returns the new state
+ */
+static uint32_t
+Crc32UpdateSliceBy8(uint32_t crc, const uint8_t* data, size_t length)
+{
+    const auto& t = crc32SliceTables.table;
+    while (length >= 8)
+    {
+        // Assembled byte by byte, to be independent of the host byte order;
+        // compilers turn this into a single load on little endian hosts.
+        uint32_t low = crc ^ (data[0] | (data[1] << 8) | (data[2] << 16) |
+                              (static_cast<uint32_t>(data[3]) << 24));
+        uint32_t high =
+            data[4] | (data[5] << 8) | (data[6] << 16) | (static_cast<uint32_t>(data[7]) << 24);
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^
+              t[4][low >> 24] ^ t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^
+              t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+        data += 8;
+        length -= 8;
+    }
+    return Crc32UpdateBytewise(crc, data, length);
+}
+
+#ifdef NS3_CRC32_PCLMUL
+/**
+ * Load 16 unaligned bytes.
+ * \param data the bytes
+ * \returns the bytes
+ */
+__attribute__((target("pclmul,sse4.1"))) static inline __m128i
+Crc32Load(const uint8_t* data)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+/**
+ * Fold 128 bits of remainder into the next 128 bits.
+ * \param x the remainder
+ * \param y the next bits
+ * \param k the folding constants
+ * \returns the new remainder
+ */
+__attribute__((target("pclmul,sse4.1"))) static inline __m128i
+Crc32Fold(__m128i x, __m128i y, __m128i k)
+{
+    return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), y),
+                         _mm_clmulepi64_si128(x, k, 0x00));
+}
+
+/**
+ * Update a CRC-32 state by folding 64 bytes at a time with carry-less
+ * multiplications, then reducing the remainder with a Barrett reduction,
+ * as described in "Fast CRC Computation for Generic Polynomials Using
+ * PCLMULQDQ Instruction" (Intel, 2009).
+ *
+ * \param crc the state
+ * \param data the bytes
+ * \param length the number of bytes, a multiple of 16 and at least 64
+ * \returns the new state
+ */
+__attribute__((target("pclmul,sse4.1"))) static uint32_t
+Crc32UpdatePclmulBlocks(uint32_t crc, const uint8_t* data, size_t length)
+{
+    // x^(4*128+32) mod P and x^(4*128-32) mod P, bit reflected, and so on
+    alignas(16) static const uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+    alignas(16) static const uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+    alignas(16) static const uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+    alignas(16) static const uint64_t poly[] = {0x01db710641, 0x01f7011641};
+
+    __m128i x1 = _mm_xor_si128(Crc32Load(data), _mm_cvtsi32_si128(static_cast<int>(crc)));
+    __m128i x2 = Crc32Load(data + 16);
+    __m128i x3 = Crc32Load(data + 32);
+    __m128i x4 = Crc32Load(data + 48);
+    data += 64;
+    length -= 64;
+
+    // Fold four 128 bit lanes in parallel
+    __m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+    while (length >= 64)
+    {
+        x1 = Crc32Fold(x1, Crc32Load(data), k);
+        x2 = Crc32Fold(x2, Crc32Load(data + 16), k);
+        x3 = Crc32Fold(x3, Crc32Load(data + 32), k);
+        x4 = Crc32Fold(x4, Crc32Load(data + 48), k);
+        data += 64;
+        length -= 64;
+    }
+
+    // Fold the four lanes, then the remaining 16 byte blocks, into one
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+    x1 = Crc32Fold(x1, x2, k);
+    x1 = Crc32Fold(x1, x3, k);
+    x1 = Crc32Fold(x1, x4, k);
+    while (length >= 16)
+    {
+        x1 = Crc32Fold(x1, Crc32Load(data), k);
+        data += 16;
+        length -= 16;
+    }
+
+    // Fold 128 bits into 64 bits
+    __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+    x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask), k, 0x00), x2);
+
+    // Barrett reduction into 32 bits
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), k, 0x10);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+/**
+ * Update a CRC-32 state with carry-less multiplications, and the
+ * slice-by-8 algorithm for short buffers and the last bytes.
+ * \param crc the state
+ * \param data the bytes
+ * \param length the number of bytes
+ * \returns the new state
+ */
+static uint32_t
+Crc32UpdatePclmul(uint32_t crc, const uint8_t* data, size_t length)
+{
+    if (length >= 64)
+    {
+        size_t blocks = length & ~static_cast<size_t>(15);
+        crc = Crc32UpdatePclmulBlocks(crc, data, blocks);
+        data += blocks;
+        length -= blocks;
+    }
+    return Crc32UpdateSliceBy8(crc, data, length);
+}
+
+/**
+ * \returns true if the CPU has the PCLMULQDQ and SSE4.1 instructions
+ */
+static bool
+Crc32DetectPclmul()
+{
+    unsigned int eax;
+    unsigned int ebx;
+    unsigned int ecx;
+    unsigned int edx;
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_PCLMUL) && (ecx & bit_SSE4_1);
+}
+#endif
+
+bool
+CRC32IsSupported(Crc32Implementation implementation)
+{
+    switch (implementation)
+    {
+    case CRC32_BYTEWISE:
+    case CRC32_SLICE_BY_8:
+        return true;
+    case CRC32_PCLMUL: {
+#ifdef NS3_CRC32_PCLMUL
+        static const bool supported = Crc32DetectPclmul();
+        return supported;
+#else
+        return false;
+#endif
+    }
+    }
+    return false;
+}
+
+uint32_t
+CRC32Calculate(const uint8_t* data, int length, Crc32Implementation implementation)
+{
+    uint32_t crc = 0xffffffff;
+    size_t size = length > 0 ? length : 0;
+
+    switch (implementation)
+    {
+    case CRC32_BYTEWISE:
+        crc = Crc32UpdateBytewise(crc, data, size);
+        break;
+#ifdef NS3_CRC32_PCLMUL
+    case CRC32_PCLMUL:
+        if (CRC32IsSupported(CRC32_PCLMUL))
+        {
+            crc = Crc32UpdatePclmul(crc, data, size);
+            break;
+        }
+        [[fallthrough]];
+#endif
+    default:
+        crc = Crc32UpdateSliceBy8(crc, data, size);
+        break;
+    }
     return ~crc;
 }
 
+uint32_t
+CRC32Calculate(const uint8_t* data, int length)
+{
+    static const Crc32Implementation implementation =
+        CRC32IsSupported(CRC32_PCLMUL) ? CRC32_PCLMUL : CRC32_SLICE_BY_8;
+    return CRC32Calculate(data, length, implementation);
+}
+
 } // namespace ns3
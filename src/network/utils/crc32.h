@@ -23,9 +23,22 @@
 namespace ns3
 {
 
+/**
+ * The implementations of the CRC-32, which all compute the same checksum.
+ */
+enum Crc32Implementation
+{
+    CRC32_BYTEWISE,   //!< One table lookup per byte
+    CRC32_SLICE_BY_8, //!< Eight table lookups per 8 bytes
+    CRC32_PCLMUL,     //!< Folding with carry-less multiplications (x86 PCLMULQDQ)
+};
+
 /**
  * Calculates the CRC-32 for a given input
  *
+ * The fastest implementation supported by the CPU is selected at run
+ * time, the first time the function is called.
+ *
  * \param data buffer to calculate the checksum for
  * \param length the length of the buffer (bytes)
  * \returns the computed crc-32.
@@ -33,6 +46,25 @@ namespace ns3
  */
 uint32_t CRC32Calculate(const uint8_t* data, int length);
 
+/**
+ * Calculates the CRC-32 for a given input, with a given implementation
+ *
+ * An implementation which is not supported by the CPU falls back to the
+ * slice-by-8 one.
+ *
+ * \param data buffer to calculate the checksum for
+ * \param length the length of the buffer (bytes)
+ * \param implementation the implementation to use
+ * \returns the computed crc-32.
+ */
+uint32_t CRC32Calculate(const uint8_t* data, int length, Crc32Implementation implementation);
+
+/**
+ * \param implementation an implementation of the CRC-32
+ * \returns true if the implementation is supported by the CPU.
+ */
+bool CRC32IsSupported(Crc32Implementation implementation);
+
 } // namespace ns3
 
 #endif
@@ -19,6 +19,7 @@
 
 #include "ns3/boolean.h"
 #include "ns3/buffer.h"
+#include "ns3/enum.h"
 #include "ns3/header.h"
 #include "ns3/log.h"
 #include "ns3/uinteger.h"
@@ -48,6 +49,23 @@ PcapFileWrapper::GetTypeId()
                           "microseconds(default).",
                           BooleanValue(false),
                           MakeBooleanAccessor(&PcapFileWrapper::m_nanosecMode),
+                          MakeBooleanChecker())
+            .AddAttribute("Format",
+                          "The format of the files written.",
+                          EnumValue(PcapFile::PCAP),
+                          MakeEnumAccessor(&PcapFileWrapper::m_format),
+                          MakeEnumChecker(PcapFile::PCAP, "Pcap", PcapFile::PCAPNG, "PcapNg"))
+            .AddAttribute("Asynchronous",
+                          "Whether the records are serialized into large blocks in memory, "
+                          "which a background thread writes to the file.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PcapFileWrapper::m_async),
+                          MakeBooleanChecker())
+            .AddAttribute("Compression",
+                          "Whether the files written are compressed with gzip, which needs "
+                          "ns-3 to be built with zlib.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PcapFileWrapper::m_compress),
                           MakeBooleanChecker());
     return tid;
 }
@@ -95,6 +113,9 @@ void
 PcapFileWrapper::Open(const std::string& filename, std::ios::openmode mode)
 {
     NS_LOG_FUNCTION(this << filename << mode);
+    m_file.SetFormat(m_format);
+    m_file.SetAsynchronous(m_async);
+    m_file.SetCompression(m_compress);
     m_file.Open(filename, mode);
 }
 
@@ -222,9 +222,12 @@ class PcapFileWrapper : public Object
     uint32_t GetDataLinkType();
 
   private:
-    PcapFile m_file;    //!< Pcap file
-    uint32_t m_snapLen; //!< max length of saved packets
-    bool m_nanosecMode; //!< Timestamps in nanosecond mode
+    PcapFile m_file;           //!< Pcap file
+    uint32_t m_snapLen;        //!< max length of saved packets
+    bool m_nanosecMode;        //!< Timestamps in nanosecond mode
+    PcapFile::Format m_format; //!< Format of the files written
+    bool m_async;              //!< Records written by a background thread
+    bool m_compress;           //!< Files written compressed with gzip
 };
 
 } // namespace ns3
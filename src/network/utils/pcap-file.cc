@@ -28,8 +28,17 @@
 #include "ns3/log.h"
 #include "ns3/packet.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <iostream>
+#include <mutex>
+#include <thread>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 //
 // This file is used as part of the ns-3 test framework, so please refrain from
@@ -51,10 +60,216 @@ const uint32_t NS_SWAPPED_MAGIC = 0x4d3cb2a1; /**< Looks this way if byte swappi
 const uint16_t VERSION_MAJOR = 2; /**< Major version of supported pcap file format */
 const uint16_t VERSION_MINOR = 4; /**< Minor version of supported pcap file format */
 
+const uint32_t PCAPNG_SECTION_HEADER = 0x0a0d0d0a;   /**< pcapng section header block type */
+const uint32_t PCAPNG_INTERFACE = 0x00000001;        /**< pcapng interface block type */
+const uint32_t PCAPNG_ENHANCED_PACKET = 0x00000006;  /**< pcapng enhanced packet block type */
+const uint32_t PCAPNG_BYTE_ORDER_MAGIC = 0x1a2b3c4d; /**< pcapng byte order magic */
+
+const uint32_t PCAPNG_SECTION_HEADER_SIZE = 28;      /**< Size of our section header block */
+const uint32_t PCAPNG_INTERFACE_SIZE = 32;           /**< Size of our interface block */
+const uint32_t PCAPNG_ENHANCED_PACKET_OVERHEAD = 32; /**< Size of a packet block, but the data */
+
+const uint16_t PCAPNG_OPTION_END = 0;     /**< pcapng opt_endofopt option code */
+const uint16_t PCAPNG_OPTION_TSRESOL = 9; /**< pcapng if_tsresol option code */
+
+const uint32_t BLOCK_SIZE = 1 << 20;  /**< Size of the blocks of records handed to a writer */
+const uint32_t MAX_QUEUED_BLOCKS = 8; /**< Blocks queued for the writer thread before waiting */
+
+/**
+ * The output of the blocks of records to the file stream, through a
+ * background thread when the file is written asynchronously, and through
+ * a gzip stream when it is compressed.
+ *
+ * Once the thread runs, it alone touches the file stream until Finish.
+ */
+struct PcapFile::Writer
+{
+    /**
+     * Start the output to a file stream.
+     * \param [in] file The file stream, open for writing.
+     * \param [in] async Whether the blocks are written by a background thread.
+     * \param [in] compress Whether the blocks are compressed.
+     */
+    Writer(std::fstream* file, bool async, bool compress);
+    /**
+     * Hand a block of records to the output.
+     * \param [in,out] block The block, which is replaced by an empty one.
+     */
+    void Submit(std::vector<uint8_t>& block);
+    /** Write the queued blocks, complete the compression and stop the thread. */
+    void Finish();
+    /**
+     * Write a block of records, compressed if needed, to the file stream.
+     * \param [in] block The block.
+     */
+    void Output(const std::vector<uint8_t>& block);
+    /**
+     * Write a buffer to the file stream, and record its failures.
+     * \param [in] data The buffer.
+     * \param [in] size The size of the buffer.
+     */
+    void Write(const uint8_t* data, size_t size);
+    /** Write the queued blocks until Finish, in the background thread. */
+    void Run();
+
+    std::fstream* m_file;                      //!< The file stream
+    bool m_compress;                           //!< Whether the blocks are compressed
+    std::atomic<bool> m_failed;                //!< Whether a write failed
+    std::thread m_thread;                      //!< The writer thread, if asynchronous
+    std::mutex m_mutex;                        //!< Protect the queue and the spare blocks
+    std::condition_variable m_queued;          //!< Signal a block or the stop to the thread
+    std::condition_variable m_written;         //!< Signal a block written to Submit
+    std::deque<std::vector<uint8_t>> m_queue;  //!< The blocks to write
+    std::vector<std::vector<uint8_t>> m_spare; //!< The written blocks, to be reused
+    bool m_stop;                               //!< Whether Finish was called
+#ifdef HAVE_ZLIB
+    z_stream m_stream;                 //!< The gzip stream, if compressed
+    std::vector<uint8_t> m_compressed; //!< The output buffer of the gzip stream
+#endif
+};
+
+PcapFile::Writer::Writer(std::fstream* file, bool async, bool compress)
+    : m_file(file),
+      m_compress(compress),
+      m_failed(false),
+      m_stop(false)
+{
+    if (m_compress)
+    {
+#ifdef HAVE_ZLIB
+        // A window of 15 bits, plus 16 for a gzip header and trailer.
+        std::memset(&m_stream, 0, sizeof(m_stream));
+        if (deflateInit2(&m_stream, Z_BEST_SPEED, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) !=
+            Z_OK)
+        {
+            NS_FATAL_ERROR("Unable to start the compression of a pcap file");
+        }
+        m_compressed.resize(BLOCK_SIZE);
+#else
+        NS_FATAL_ERROR("Compressed pcap files need ns-3 to be built with zlib");
+#endif
+    }
+    if (async)
+    {
+        m_thread = std::thread(&Writer::Run, this);
+    }
+}
+
+void
+PcapFile::Writer::Submit(std::vector<uint8_t>& block)
+{
+    if (!m_thread.joinable())
+    {
+        Output(block);
+        block.clear();
+        return;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_written.wait(lock, [this] { return m_queue.size() < MAX_QUEUED_BLOCKS; });
+    m_queue.push_back(std::move(block));
+    block.clear();
+    if (!m_spare.empty())
+    {
+        block.swap(m_spare.back());
+        m_spare.pop_back();
+    }
+    lock.unlock();
+    m_queued.notify_one();
+}
+
+void
+PcapFile::Writer::Finish()
+{
+    if (m_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_queued.notify_one();
+        m_thread.join();
+    }
+#ifdef HAVE_ZLIB
+    if (m_compress)
+    {
+        int status;
+        do
+        {
+            m_stream.next_out = m_compressed.data();
+            m_stream.avail_out = m_compressed.size();
+            status = deflate(&m_stream, Z_FINISH);
+            Write(m_compressed.data(), m_compressed.size() - m_stream.avail_out);
+        } while (status == Z_OK);
+        deflateEnd(&m_stream);
+    }
+#endif
+    m_file->flush();
+}
+
+void
+PcapFile::Writer::Output(const std::vector<uint8_t>& block)
+{
+    if (!m_compress)
+    {
+        Write(block.data(), block.size());
+        return;
+    }
+#ifdef HAVE_ZLIB
+    m_stream.next_in = const_cast<uint8_t*>(block.data());
+    m_stream.avail_in = block.size();
+    do
+    {
+        m_stream.next_out = m_compressed.data();
+        m_stream.avail_out = m_compressed.size();
+        deflate(&m_stream, Z_NO_FLUSH);
+        Write(m_compressed.data(), m_compressed.size() - m_stream.avail_out);
+    } while (m_stream.avail_out == 0);
+#endif
+}
+
+void
+PcapFile::Writer::Write(const uint8_t* data, size_t size)
+{
+    m_file->write(reinterpret_cast<const char*>(data), size);
+    if (m_file->fail())
+    {
+        m_failed = true;
+    }
+}
+
+void
+PcapFile::Writer::Run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_queued.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty())
+        {
+            break;
+        }
+        std::vector<uint8_t> block = std::move(m_queue.front());
+        m_queue.pop_front();
+        lock.unlock();
+        Output(block);
+        block.clear();
+        lock.lock();
+        if (m_spare.size() < MAX_QUEUED_BLOCKS)
+        {
+            m_spare.push_back(std::move(block));
+        }
+        m_written.notify_one();
+    }
+}
+
 PcapFile::PcapFile()
     : m_file(),
       m_swapMode(false),
-      m_nanosecMode(false)
+      m_nanosecMode(false),
+      m_format(PCAP),
+      m_async(false),
+      m_compress(false),
+      m_writer(nullptr)
 {
     NS_LOG_FUNCTION(this);
     FatalImpl::RegisterStream(&m_file);
@@ -71,6 +286,10 @@ bool
 PcapFile::Fail() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_writer != nullptr)
+    {
+        return m_writer->m_failed;
+    }
     return m_file.fail();
 }
 
@@ -92,9 +311,47 @@ void
 PcapFile::Close()
 {
     NS_LOG_FUNCTION(this);
+    if (m_writer != nullptr)
+    {
+        if (!m_block.empty())
+        {
+            m_writer->Submit(m_block);
+        }
+        m_writer->Finish();
+        bool failed = m_writer->m_failed;
+        delete m_writer;
+        m_writer = nullptr;
+        m_file.close();
+        if (failed)
+        {
+            m_file.setstate(std::ios::failbit);
+        }
+        return;
+    }
     m_file.close();
 }
 
+void
+PcapFile::SetFormat(Format format)
+{
+    NS_LOG_FUNCTION(this << format);
+    m_format = format;
+}
+
+void
+PcapFile::SetAsynchronous(bool async)
+{
+    NS_LOG_FUNCTION(this << async);
+    m_async = async;
+}
+
+void
+PcapFile::SetCompression(bool compress)
+{
+    NS_LOG_FUNCTION(this << compress);
+    m_compress = compress;
+}
+
 uint32_t
 PcapFile::GetMagic()
 {
@@ -203,49 +460,96 @@ PcapFile::Swap(PcapRecordHeader* from, PcapRecordHeader* to)
     to->m_origLen = Swap(from->m_origLen);
 }
 
+void
+PcapFile::Append16(uint16_t value)
+{
+    if (m_swapMode)
+    {
+        value = Swap(value);
+    }
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(&value);
+    m_block.insert(m_block.end(), bytes, bytes + sizeof(value));
+}
+
+void
+PcapFile::Append32(uint32_t value)
+{
+    if (m_swapMode)
+    {
+        value = Swap(value);
+    }
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(&value);
+    m_block.insert(m_block.end(), bytes, bytes + sizeof(value));
+}
+
+void
+PcapFile::Commit()
+{
+    if (m_writer == nullptr)
+    {
+        m_file.write(reinterpret_cast<const char*>(m_block.data()), m_block.size());
+        m_block.clear();
+        NS_BUILD_DEBUG(m_file.flush());
+    }
+    else if (m_block.size() >= BLOCK_SIZE)
+    {
+        m_writer->Submit(m_block);
+    }
+}
+
 void
 PcapFile::WriteFileHeader()
 {
     NS_LOG_FUNCTION(this);
     //
     // If we're initializing the file, we need to write the pcap file header
-    // at the start of the file.
+    // at the start of the file.  A buffered file has not been written yet.
     //
-    m_file.seekp(0, std::ios::beg);
-
-    //
-    // We have the ability to write out the pcap file header in a foreign endian
-    // format, so we need a temp place to swap on the way out.
-    //
-    PcapFileHeader header;
+    if (m_writer == nullptr)
+    {
+        m_file.seekp(0, std::ios::beg);
+    }
+    m_block.clear();
 
     //
-    // the pointer headerOut selects either the swapped or non-swapped version of
-    // the pcap file header.
+    // Append16 and Append32 write the fields in the byte order of the file,
+    // and one at a time to avoid memory alignment differences between machines.
     //
-    PcapFileHeader* headerOut = nullptr;
-
-    if (m_swapMode == false)
+    if (m_format == PCAPNG)
     {
-        headerOut = &m_fileHeader;
+        Append32(PCAPNG_SECTION_HEADER);
+        Append32(PCAPNG_SECTION_HEADER_SIZE);
+        Append32(PCAPNG_BYTE_ORDER_MAGIC);
+        Append16(1);
+        Append16(0);
+        Append32(0xffffffff); // Unknown section length
+        Append32(0xffffffff);
+        Append32(PCAPNG_SECTION_HEADER_SIZE);
+
+        Append32(PCAPNG_INTERFACE);
+        Append32(PCAPNG_INTERFACE_SIZE);
+        Append16(m_fileHeader.m_type);
+        Append16(0);
+        Append32(m_fileHeader.m_snapLen);
+        Append16(PCAPNG_OPTION_TSRESOL);
+        Append16(1);
+        m_block.push_back(m_nanosecMode ? 9 : 6); // A power of ten, then padding
+        m_block.insert(m_block.end(), 3, 0);
+        Append16(PCAPNG_OPTION_END);
+        Append16(0);
+        Append32(PCAPNG_INTERFACE_SIZE);
     }
     else
     {
-        Swap(&m_fileHeader, &header);
-        headerOut = &header;
+        Append32(m_fileHeader.m_magicNumber);
+        Append16(m_fileHeader.m_versionMajor);
+        Append16(m_fileHeader.m_versionMinor);
+        Append32(m_fileHeader.m_zone);
+        Append32(m_fileHeader.m_sigFigs);
+        Append32(m_fileHeader.m_snapLen);
+        Append32(m_fileHeader.m_type);
     }
-
-    //
-    // Watch out for memory alignment differences between machines, so write
-    // them all individually.
-    //
-    m_file.write((const char*)&headerOut->m_magicNumber, sizeof(headerOut->m_magicNumber));
-    m_file.write((const char*)&headerOut->m_versionMajor, sizeof(headerOut->m_versionMajor));
-    m_file.write((const char*)&headerOut->m_versionMinor, sizeof(headerOut->m_versionMinor));
-    m_file.write((const char*)&headerOut->m_zone, sizeof(headerOut->m_zone));
-    m_file.write((const char*)&headerOut->m_sigFigs, sizeof(headerOut->m_sigFigs));
-    m_file.write((const char*)&headerOut->m_snapLen, sizeof(headerOut->m_snapLen));
-    m_file.write((const char*)&headerOut->m_type, sizeof(headerOut->m_type));
+    Commit();
 }
 
 void
@@ -345,6 +649,11 @@ PcapFile::Open(const std::string& filename, std::ios::openmode mode)
         // will set the fail bit if file header is invalid.
         ReadAndVerifyFileHeader();
     }
+    else if ((m_async || m_compress) && !m_file.fail())
+    {
+        NS_ASSERT(m_writer == nullptr);
+        m_writer = new Writer(&m_file, m_async, m_compress);
+    }
 }
 
 void
@@ -413,40 +722,49 @@ uint32_t
 PcapFile::WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << totalLen);
-    NS_ASSERT(m_file.good());
+    NS_ASSERT(m_writer != nullptr || m_file.good());
 
     uint32_t inclLen = totalLen > m_fileHeader.m_snapLen ? m_fileHeader.m_snapLen : totalLen;
 
-    PcapRecordHeader header;
-    header.m_tsSec = tsSec;
-    header.m_tsUsec = tsUsec;
-    header.m_inclLen = inclLen;
-    header.m_origLen = totalLen;
-
-    if (m_swapMode)
+    if (m_format == PCAPNG)
     {
-        Swap(&header, &header);
+        uint64_t ts = tsSec * (m_nanosecMode ? 1000000000ULL : 1000000ULL) + tsUsec;
+        Append32(PCAPNG_ENHANCED_PACKET);
+        Append32(PCAPNG_ENHANCED_PACKET_OVERHEAD + ((inclLen + 3) & ~3U));
+        Append32(0); // Interface
+        Append32(ts >> 32);
+        Append32(ts & 0xffffffff);
+        Append32(inclLen);
+        Append32(totalLen);
+    }
+    else
+    {
+        Append32(tsSec);
+        Append32(tsUsec);
+        Append32(inclLen);
+        Append32(totalLen);
     }
-
-    //
-    // Watch out for memory alignment differences between machines, so write
-    // them all individually.
-    //
-    m_file.write((const char*)&header.m_tsSec, sizeof(header.m_tsSec));
-    m_file.write((const char*)&header.m_tsUsec, sizeof(header.m_tsUsec));
-    m_file.write((const char*)&header.m_inclLen, sizeof(header.m_inclLen));
-    m_file.write((const char*)&header.m_origLen, sizeof(header.m_origLen));
-    NS_BUILD_DEBUG(m_file.flush());
     return inclLen;
 }
 
+void
+PcapFile::WritePacketTrailer(uint32_t inclLen)
+{
+    if (m_format == PCAPNG)
+    {
+        m_block.insert(m_block.end(), ((inclLen + 3) & ~3U) - inclLen, 0);
+        Append32(PCAPNG_ENHANCED_PACKET_OVERHEAD + ((inclLen + 3) & ~3U));
+    }
+    Commit();
+}
+
 void
 PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const uint8_t* const data, uint32_t totalLen)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << &data << totalLen);
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, totalLen);
-    m_file.write((const char*)data, inclLen);
-    NS_BUILD_DEBUG(m_file.flush());
+    m_block.insert(m_block.end(), data, data + inclLen);
+    WritePacketTrailer(inclLen);
 }
 
 void
@@ -454,8 +772,10 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << p);
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, p->GetSize());
-    p->CopyData(&m_file, inclLen);
-    NS_BUILD_DEBUG(m_file.flush());
+    size_t offset = m_block.size();
+    m_block.resize(offset + inclLen);
+    p->CopyData(m_block.data() + offset, inclLen);
+    WritePacketTrailer(inclLen);
 }
 
 void
@@ -470,9 +790,11 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const Header& header, Ptr<const
     headerBuffer.AddAtStart(headerSize);
     header.Serialize(headerBuffer.Begin());
     uint32_t toCopy = std::min(headerSize, inclLen);
-    headerBuffer.CopyData(&m_file, toCopy);
-    inclLen -= toCopy;
-    p->CopyData(&m_file, inclLen);
+    size_t offset = m_block.size();
+    m_block.resize(offset + inclLen);
+    headerBuffer.CopyData(m_block.data() + offset, toCopy);
+    p->CopyData(m_block.data() + offset + toCopy, inclLen - toCopy);
+    WritePacketTrailer(inclLen);
 }
 
 void
@@ -25,6 +25,7 @@
 #include <fstream>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -38,6 +39,13 @@ class Header;
  * A class representing a pcap file.  This allows easy creation, writing and
  * reading of files composed of stored packets; which may be viewed using
  * standard tools.
+ *
+ * Files opened for writing can also be written in the pcapng format, be
+ * compressed with gzip, and be written by a background thread.  The
+ * records are then serialized into large blocks in memory, and the
+ * simulation only waits for the file system when the writer thread falls
+ * behind by several blocks.  These options must be set before the file
+ * is opened, and the files they produce can not be read back by this class.
  */
 class PcapFile
 {
@@ -46,6 +54,15 @@ class PcapFile
     static const uint32_t SNAPLEN_DEFAULT =
         65535; //!< Default value for maximum octets to save per packet
 
+    /**
+     * \brief The formats of the files written
+     */
+    enum Format
+    {
+        PCAP,   //!< The libpcap format
+        PCAPNG, //!< The pcapng format, with a single interface
+    };
+
   public:
     PcapFile();
     ~PcapFile();
@@ -83,9 +100,36 @@ class PcapFile
 
     /**
      * Close the underlying file.
+     *
+     * The records which are still in memory are written first.
      */
     void Close();
 
+    /**
+     * \brief Set the format of the file written.
+     *
+     * A pcapng file starts with a section header and the description of a
+     * single interface, which carries the snaplen, the data link type and
+     * the resolution of the timestamps of its records.
+     *
+     * \param [in] format The format of the file.
+     */
+    void SetFormat(Format format);
+    /**
+     * \brief Write the records from a background thread.
+     *
+     * \param [in] async Whether the records are written by a background thread.
+     */
+    void SetAsynchronous(bool async);
+    /**
+     * \brief Compress the file written with gzip.
+     *
+     * The compression needs ns-3 to be built with zlib.
+     *
+     * \param [in] compress Whether the file is compressed.
+     */
+    void SetCompression(bool compress);
+
     /**
      * Initialize the pcap file associated with this object.  This file must have
      * been previously opened with write permissions.
@@ -293,6 +337,8 @@ class PcapFile
                      uint32_t snapLen = SNAPLEN_DEFAULT);
 
   private:
+    struct Writer; //!< The output of the blocks of records, and its thread
+
     /**
      * \brief Pcap file header
      */
@@ -351,6 +397,24 @@ class PcapFile
      */
     void Swap(PcapRecordHeader* from, PcapRecordHeader* to);
 
+    /**
+     * \brief Append a field to the block of records, in the byte order of the file
+     * \param value the value of the field
+     */
+    void Append16(uint16_t value);
+    /**
+     * \brief Append a field to the block of records, in the byte order of the file
+     * \param value the value of the field
+     */
+    void Append32(uint32_t value);
+    /**
+     * \brief Hand the block of records to the file
+     *
+     * Without a writer, the block is written at once.  Otherwise it is
+     * handed to the writer once it is large enough.
+     */
+    void Commit();
+
     /**
      * \brief Write a Pcap file header
      */
@@ -367,17 +431,27 @@ class PcapFile
      * \returns the length of the packet to write in the Pcap file
      */
     uint32_t WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen);
+    /**
+     * \brief Complete the record of a packet, and commit it
+     * \param inclLen the length of the packet written in the record
+     */
+    void WritePacketTrailer(uint32_t inclLen);
 
     /**
      * \brief Read and verify a Pcap file header
      */
     void ReadAndVerifyFileHeader();
 
-    std::string m_filename;      //!< file name
-    std::fstream m_file;         //!< file stream
-    PcapFileHeader m_fileHeader; //!< file header
-    bool m_swapMode;             //!< swap mode
-    bool m_nanosecMode;          //!< nanosecond timestamp mode
+    std::string m_filename;       //!< file name
+    std::fstream m_file;          //!< file stream
+    PcapFileHeader m_fileHeader;  //!< file header
+    bool m_swapMode;              //!< swap mode
+    bool m_nanosecMode;           //!< nanosecond timestamp mode
+    Format m_format;              //!< format of the file written
+    bool m_async;                 //!< whether the records are written by a thread
+    bool m_compress;              //!< whether the file written is compressed
+    std::vector<uint8_t> m_block; //!< records not yet handed to the file
+    Writer* m_writer;             //!< output of the blocks, if buffered
 };
 
 } // namespace ns3
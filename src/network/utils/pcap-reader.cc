@@ -0,0 +1,422 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "pcap-reader.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifdef __WIN32__
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PcapReader");
+
+const uint32_t MAGIC = 0xa1b2c3d4;            /**< Magic number of pcap files */
+const uint32_t SWAPPED_MAGIC = 0xd4c3b2a1;    /**< Magic number of byte swapped pcap files */
+const uint32_t NS_MAGIC = 0xa1b23c4d;         /**< Magic number of nanosecond pcap files */
+const uint32_t NS_SWAPPED_MAGIC = 0x4d3cb2a1; /**< Magic number of swapped nanosecond files */
+
+const uint32_t PCAPNG_SECTION_HEADER = 0x0a0d0d0a;   /**< pcapng section header block type */
+const uint32_t PCAPNG_INTERFACE = 0x00000001;        /**< pcapng interface block type */
+const uint32_t PCAPNG_PACKET = 0x00000002;           /**< pcapng obsolete packet block type */
+const uint32_t PCAPNG_SIMPLE_PACKET = 0x00000003;    /**< pcapng simple packet block type */
+const uint32_t PCAPNG_ENHANCED_PACKET = 0x00000006;  /**< pcapng enhanced packet block type */
+const uint32_t PCAPNG_BYTE_ORDER_MAGIC = 0x1a2b3c4d; /**< pcapng byte order magic */
+const uint16_t PCAPNG_OPTION_END = 0;                /**< pcapng opt_endofopt option code */
+const uint16_t PCAPNG_OPTION_TSRESOL = 9;            /**< pcapng if_tsresol option code */
+
+/**
+ * Convert a pcapng timestamp to ns.
+ * \param [in] ts The timestamp.
+ * \param [in] tsResol The resolution of the timestamp, as the if_tsresol option:
+ * a negative power of ten, or of two if its most significant bit is set.
+ * \return The timestamp, in ns.
+ */
+static uint64_t
+ToNanoSeconds(uint64_t ts, uint8_t tsResol)
+{
+    uint8_t exponent = tsResol & 0x7f;
+    if (tsResol & 0x80)
+    {
+        if (exponent >= 64)
+        {
+            return std::ldexp(static_cast<long double>(ts), -exponent) * 1e9;
+        }
+        uint64_t seconds = ts >> exponent;
+        uint64_t fraction = ts & ((uint64_t(1) << exponent) - 1);
+        return seconds * 1000000000 +
+               std::ldexp(static_cast<long double>(fraction), -exponent) * 1e9;
+    }
+    uint64_t scale = 1;
+    for (uint8_t i = std::min<uint8_t>(exponent, 9); i < std::max<uint8_t>(exponent, 9); ++i)
+    {
+        scale *= 10;
+    }
+    return exponent <= 9 ? ts * scale : ts / scale;
+}
+
+PcapReader::PcapReader()
+    : m_data(nullptr),
+      m_size(0),
+      m_first(0),
+      m_offset(0),
+      m_swap(false),
+      m_nanosec(false),
+      m_pcapng(false),
+      m_fail(true),
+      m_linkType(0),
+      m_time(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PcapReader::~PcapReader()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+bool
+PcapReader::Open(const std::string& filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    Close();
+    m_fail = true;
+
+#ifdef __WIN32__
+    std::ifstream file(filename, std::ios::binary);
+    m_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (!file.is_open() || m_buffer.size() < 12)
+    {
+        m_buffer.clear();
+        return false;
+    }
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+#else
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < 12)
+    {
+        close(fd);
+        return false;
+    }
+    void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        return false;
+    }
+    madvise(map, st.st_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const uint8_t*>(map);
+    m_size = st.st_size;
+#endif
+
+    uint32_t magic;
+    std::memcpy(&magic, m_data, sizeof(magic));
+    if (magic == MAGIC || magic == SWAPPED_MAGIC || magic == NS_MAGIC || magic == NS_SWAPPED_MAGIC)
+    {
+        if (m_size < 24)
+        {
+            Close();
+            return false;
+        }
+        m_pcapng = false;
+        m_swap = (magic == SWAPPED_MAGIC || magic == NS_SWAPPED_MAGIC);
+        m_nanosec = (magic == NS_MAGIC || magic == NS_SWAPPED_MAGIC);
+        m_linkType = Read32(20);
+        m_first = 24;
+    }
+    else if (magic == PCAPNG_SECTION_HEADER)
+    {
+        //
+        // The section header is read again by NextPcapNg, which sets the
+        // byte order of each section; the first interface gives the data
+        // link type of the file.
+        //
+        uint32_t byteOrder;
+        std::memcpy(&byteOrder, m_data + 8, sizeof(byteOrder));
+        m_swap = (byteOrder != PCAPNG_BYTE_ORDER_MAGIC);
+        m_pcapng = true;
+        m_first = 0;
+        for (size_t offset = 0; m_size - offset >= 12;)
+        {
+            uint32_t length = Read32(offset + 4);
+            if (length < 12 || length > m_size - offset)
+            {
+                break;
+            }
+            if (Read32(offset) == PCAPNG_INTERFACE && length >= 20)
+            {
+                m_linkType = Read16(offset + 8);
+                break;
+            }
+            offset += length;
+        }
+    }
+    else
+    {
+        Close();
+        return false;
+    }
+    m_fail = false;
+    Rewind();
+    return true;
+}
+
+void
+PcapReader::Close()
+{
+    NS_LOG_FUNCTION(this);
+#ifndef __WIN32__
+    if (m_data != nullptr && m_buffer.empty())
+    {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+#endif
+    m_buffer.clear();
+    m_data = nullptr;
+    m_size = 0;
+    m_offset = 0;
+    m_interfaces.clear();
+}
+
+void
+PcapReader::Rewind()
+{
+    NS_LOG_FUNCTION(this);
+    m_offset = m_first;
+    m_interfaces.clear();
+    m_time = 0;
+}
+
+bool
+PcapReader::Fail() const
+{
+    return m_fail;
+}
+
+bool
+PcapReader::IsPcapNg() const
+{
+    return m_pcapng;
+}
+
+uint32_t
+PcapReader::GetDataLinkType() const
+{
+    return m_linkType;
+}
+
+uint16_t
+PcapReader::Read16(size_t offset) const
+{
+    uint16_t value;
+    std::memcpy(&value, m_data + offset, sizeof(value));
+    if (m_swap)
+    {
+        value = ((value >> 8) & 0x00ff) | ((value << 8) & 0xff00);
+    }
+    return value;
+}
+
+uint32_t
+PcapReader::Read32(size_t offset) const
+{
+    uint32_t value;
+    std::memcpy(&value, m_data + offset, sizeof(value));
+    if (m_swap)
+    {
+        value = ((value >> 24) & 0x000000ff) | ((value >> 8) & 0x0000ff00) |
+                ((value << 8) & 0x00ff0000) | ((value << 24) & 0xff000000);
+    }
+    return value;
+}
+
+bool
+PcapReader::Next(Record& record)
+{
+    if (m_data == nullptr || m_fail || m_offset == m_size)
+    {
+        return false;
+    }
+    if (m_pcapng)
+    {
+        return NextPcapNg(record);
+    }
+
+    if (m_size - m_offset < 16)
+    {
+        m_fail = true;
+        return false;
+    }
+    uint32_t tsSec = Read32(m_offset);
+    uint32_t tsFraction = Read32(m_offset + 4);
+    record.inclLen = Read32(m_offset + 8);
+    record.origLen = Read32(m_offset + 12);
+    if (m_size - m_offset - 16 < record.inclLen)
+    {
+        m_fail = true;
+        return false;
+    }
+    record.time = tsSec * 1000000000ULL + tsFraction * (m_nanosec ? 1ULL : 1000ULL);
+    record.data = m_data + m_offset + 16;
+    record.linkType = m_linkType;
+    record.interface = 0;
+    m_offset += 16 + record.inclLen;
+    return true;
+}
+
+bool
+PcapReader::NextPcapNg(Record& record)
+{
+    while (m_offset != m_size)
+    {
+        if (m_size - m_offset < 12)
+        {
+            m_fail = true;
+            return false;
+        }
+        size_t block = m_offset;
+        uint32_t type = Read32(block);
+        if (type == PCAPNG_SECTION_HEADER)
+        {
+            uint32_t byteOrder;
+            std::memcpy(&byteOrder, m_data + block + 8, sizeof(byteOrder));
+            m_swap = (byteOrder != PCAPNG_BYTE_ORDER_MAGIC);
+            m_interfaces.clear();
+        }
+        uint32_t length = Read32(block + 4);
+        if (length < 12 || length % 4 != 0 || length > m_size - block)
+        {
+            m_fail = true;
+            return false;
+        }
+        m_offset += length;
+
+        uint32_t interface;
+        uint32_t inclLen;
+        uint32_t origLen;
+        uint64_t ts;
+        size_t data;
+        switch (type)
+        {
+        case PCAPNG_INTERFACE:
+            ReadInterface(block, length);
+            continue;
+        case PCAPNG_ENHANCED_PACKET:
+            if (length < 32)
+            {
+                m_fail = true;
+                return false;
+            }
+            interface = Read32(block + 8);
+            ts = (uint64_t(Read32(block + 12)) << 32) | Read32(block + 16);
+            inclLen = Read32(block + 20);
+            origLen = Read32(block + 24);
+            data = block + 28;
+            break;
+        case PCAPNG_PACKET:
+            if (length < 32)
+            {
+                m_fail = true;
+                return false;
+            }
+            interface = Read16(block + 8);
+            ts = (uint64_t(Read32(block + 12)) << 32) | Read32(block + 16);
+            inclLen = Read32(block + 20);
+            origLen = Read32(block + 24);
+            data = block + 28;
+            break;
+        case PCAPNG_SIMPLE_PACKET:
+            if (length < 16)
+            {
+                m_fail = true;
+                return false;
+            }
+            // A simple packet has no timestamp: it keeps the previous one.
+            interface = 0;
+            ts = 0;
+            origLen = Read32(block + 8);
+            inclLen = std::min(origLen, length - 16);
+            data = block + 12;
+            break;
+        default:
+            continue;
+        }
+
+        if (interface >= m_interfaces.size() || inclLen > length - (data - block) - 4)
+        {
+            m_fail = true;
+            return false;
+        }
+        if (type != PCAPNG_SIMPLE_PACKET)
+        {
+            m_time = ToNanoSeconds(ts, m_interfaces[interface].tsResol);
+        }
+        record.time = m_time;
+        record.data = m_data + data;
+        record.inclLen = inclLen;
+        record.origLen = origLen;
+        record.linkType = m_interfaces[interface].linkType;
+        record.interface = interface;
+        return true;
+    }
+    return false;
+}
+
+void
+PcapReader::ReadInterface(size_t offset, uint32_t length)
+{
+    Interface interface;
+    interface.linkType = length >= 20 ? Read16(offset + 8) : 0;
+    interface.tsResol = 6;
+    size_t option = offset + 16;
+    size_t end = offset + length - 4;
+    while (option + 4 <= end)
+    {
+        uint16_t code = Read16(option);
+        uint16_t size = Read16(option + 2);
+        if (code == PCAPNG_OPTION_END || option + 4 + size > end)
+        {
+            break;
+        }
+        if (code == PCAPNG_OPTION_TSRESOL && size >= 1)
+        {
+            interface.tsResol = m_data[option + 4];
+        }
+        option += 4 + ((size + 3) & ~3U);
+    }
+    m_interfaces.push_back(interface);
+}
+
+} // namespace ns3
@@ -0,0 +1,153 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCAP_READER_H
+#define PCAP_READER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief A memory-mapped reader of pcap and pcapng files
+ *
+ * The file is mapped in memory when it is opened, and the records are
+ * returned in place, without copying them, so that large captures are
+ * read at the speed of the page cache rather than through an iostream.
+ *
+ * Both the microsecond and the nanosecond pcap formats are read, in either
+ * byte order.  In pcapng files, the enhanced, simple and obsolete packet
+ * blocks are read, and the other blocks are skipped; each interface has
+ * its own data link type and timestamp resolution, and each section its
+ * own byte order.
+ */
+class PcapReader
+{
+  public:
+    /**
+     * \brief A record of a capture
+     */
+    struct Record
+    {
+        uint64_t time;       //!< Timestamp, in ns
+        const uint8_t* data; //!< Captured bytes, valid until the file is closed
+        uint32_t inclLen;    //!< Number of captured bytes
+        uint32_t origLen;    //!< Length of the original packet
+        uint32_t linkType;   //!< Data link type of the packet
+        uint32_t interface;  //!< Interface of the packet, 0 in a pcap file
+    };
+
+    PcapReader();
+    ~PcapReader();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    PcapReader(const PcapReader&) = delete;
+    PcapReader& operator=(const PcapReader&) = delete;
+
+    /**
+     * \brief Map a pcap or pcapng file in memory.
+     *
+     * \param [in] filename The name of the file.
+     * \returns \c true if the file was mapped and has a valid header.
+     */
+    bool Open(const std::string& filename);
+    /**
+     * \brief Unmap the file.
+     */
+    void Close();
+
+    /**
+     * \brief Read the next record.
+     *
+     * \param [out] record The record.
+     * \returns \c false at the end of the file, or of its valid records.
+     */
+    bool Next(Record& record);
+    /**
+     * \brief Go back to the first record.
+     */
+    void Rewind();
+
+    /**
+     * \returns \c true if the file could not be opened, or if a record is
+     * truncated or malformed.
+     */
+    bool Fail() const;
+    /**
+     * \returns \c true if the file is in the pcapng format.
+     */
+    bool IsPcapNg() const;
+    /**
+     * \returns The data link type of a pcap file, or of the first interface
+     * of a pcapng file.
+     */
+    uint32_t GetDataLinkType() const;
+
+  private:
+    /**
+     * \brief An interface description of a pcapng file
+     */
+    struct Interface
+    {
+        uint32_t linkType; //!< Data link type
+        uint8_t tsResol;   //!< Timestamp resolution, as the if_tsresol option
+    };
+
+    /**
+     * \brief Read a 16 bit field in the byte order of the file or section
+     * \param offset the offset of the field
+     * \returns the field
+     */
+    uint16_t Read16(size_t offset) const;
+    /**
+     * \brief Read a 32 bit field in the byte order of the file or section
+     * \param offset the offset of the field
+     * \returns the field
+     */
+    uint32_t Read32(size_t offset) const;
+    /**
+     * \brief Read the next packet of a pcapng file, handling the other blocks
+     * \param [out] record The record.
+     * \returns \c false at the end of the file, or of its valid blocks.
+     */
+    bool NextPcapNg(Record& record);
+    /**
+     * \brief Read the description of a pcapng interface
+     * \param offset the offset of the interface description block
+     * \param length the length of the block
+     */
+    void ReadInterface(size_t offset, uint32_t length);
+
+    const uint8_t* m_data;               //!< The mapped file
+    size_t m_size;                       //!< The size of the file
+    std::vector<uint8_t> m_buffer;       //!< The file, where it is not mapped
+    size_t m_first;                      //!< The offset of the first record
+    size_t m_offset;                     //!< The offset of the next record
+    bool m_swap;                         //!< Whether the fields are byte swapped
+    bool m_nanosec;                      //!< Whether pcap timestamps are in ns
+    bool m_pcapng;                       //!< Whether the file is in the pcapng format
+    bool m_fail;                         //!< Whether the file is invalid
+    uint32_t m_linkType;                 //!< Data link type of a pcap file
+    std::vector<Interface> m_interfaces; //!< Interfaces of the pcapng section
+    uint64_t m_time;                     //!< Timestamp of the last pcapng packet, in ns
+};
+
+} // namespace ns3
+
+#endif /* PCAP_READER_H */
@@ -0,0 +1,230 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "pcap-replay-application.h"
+
+#include "mac48-address.h"
+
+#include "ns3/abort.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PcapReplayApplication");
+
+NS_OBJECT_ENSURE_REGISTERED(PcapReplayApplication);
+
+const uint32_t LINKTYPE_ETHERNET = 1; /**< Data link type of Ethernet frames */
+const uint32_t LINKTYPE_PPP = 9;      /**< Data link type of PPP frames */
+const uint32_t LINKTYPE_RAW = 101;    /**< Data link type of raw IP packets */
+const uint32_t LINKTYPE_IPV4 = 228;   /**< Data link type of raw IPv4 packets */
+const uint32_t LINKTYPE_IPV6 = 229;   /**< Data link type of raw IPv6 packets */
+
+const uint16_t ETHERTYPE_IPV4 = 0x0800; /**< EtherType of IPv4 */
+const uint16_t ETHERTYPE_IPV6 = 0x86dd; /**< EtherType of IPv6 */
+
+TypeId
+PcapReplayApplication::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::PcapReplayApplication")
+            .SetParent<Application>()
+            .SetGroupName("Network")
+            .AddConstructor<PcapReplayApplication>()
+            .AddAttribute("File",
+                          "The name of the pcap or pcapng file to replay.",
+                          StringValue(""),
+                          MakeStringAccessor(&PcapReplayApplication::m_filename),
+                          MakeStringChecker())
+            .AddAttribute("Device",
+                          "The device the frames are sent through.",
+                          PointerValue(),
+                          MakePointerAccessor(&PcapReplayApplication::m_device),
+                          MakePointerChecker<NetDevice>())
+            .AddAttribute("TimeScale",
+                          "The factor applied to the intervals between the frames: "
+                          "0.5 replays the capture twice as fast, and 0 sends all the "
+                          "frames at once.",
+                          DoubleValue(1.0),
+                          MakeDoubleAccessor(&PcapReplayApplication::m_timeScale),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("RemoteAddress",
+                          "The destination of all the frames, instead of the destination "
+                          "of their link layer header.",
+                          AddressValue(),
+                          MakeAddressAccessor(&PcapReplayApplication::m_peerAddress),
+                          MakeAddressChecker())
+            .AddAttribute("Protocol",
+                          "The protocol number of the frames whose link layer is unknown.",
+                          UintegerValue(ETHERTYPE_IPV4),
+                          MakeUintegerAccessor(&PcapReplayApplication::m_protocol),
+                          MakeUintegerChecker<uint16_t>())
+            .AddTraceSource("Tx",
+                            "A frame has been sent",
+                            MakeTraceSourceAccessor(&PcapReplayApplication::m_txTrace),
+                            "ns3::Packet::TracedCallback");
+    return tid;
+}
+
+PcapReplayApplication::PcapReplayApplication()
+    : m_firstTime(0),
+      m_sent(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PcapReplayApplication::~PcapReplayApplication()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint64_t
+PcapReplayApplication::GetSent() const
+{
+    return m_sent;
+}
+
+void
+PcapReplayApplication::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_device = nullptr;
+    m_reader.Close();
+    Application::DoDispose();
+}
+
+void
+PcapReplayApplication::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(!m_device, "PcapReplayApplication needs a device");
+    NS_ABORT_MSG_UNLESS(m_reader.Open(m_filename), "Unable to read " << m_filename);
+    if (!m_reader.Next(m_record))
+    {
+        return;
+    }
+    m_firstTime = m_record.time;
+    m_startTime = Simulator::Now();
+    m_sendEvent = Simulator::Schedule(GetSendTime(m_record) - Simulator::Now(),
+                                      &PcapReplayApplication::Send,
+                                      this);
+}
+
+void
+PcapReplayApplication::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+    Simulator::Cancel(m_sendEvent);
+    m_reader.Close();
+}
+
+Time
+PcapReplayApplication::GetSendTime(const PcapReader::Record& record) const
+{
+    if (record.time <= m_firstTime)
+    {
+        return m_startTime;
+    }
+    double interval = (record.time - m_firstTime) * m_timeScale;
+    return m_startTime + NanoSeconds(static_cast<int64_t>(interval));
+}
+
+void
+PcapReplayApplication::Send()
+{
+    NS_LOG_FUNCTION(this);
+    Time now = Simulator::Now();
+    do
+    {
+        SendRecord(m_record);
+        if (!m_reader.Next(m_record))
+        {
+            NS_LOG_LOGIC("Sent the " << m_sent << " frames of " << m_filename);
+            return;
+        }
+    } while (GetSendTime(m_record) <= now);
+    m_sendEvent =
+        Simulator::Schedule(GetSendTime(m_record) - now, &PcapReplayApplication::Send, this);
+}
+
+void
+PcapReplayApplication::SendRecord(const PcapReader::Record& record)
+{
+    Address destination = m_device->GetBroadcast();
+    uint16_t protocol = m_protocol;
+    uint32_t headerSize = 0;
+    const uint8_t* data = record.data;
+    switch (record.linkType)
+    {
+    case LINKTYPE_ETHERNET:
+        if (record.inclLen >= 14)
+        {
+            Mac48Address address;
+            address.CopyFrom(data);
+            destination = address;
+            protocol = (data[12] << 8) | data[13];
+            headerSize = 14;
+        }
+        break;
+    case LINKTYPE_PPP:
+        if (record.inclLen >= 2)
+        {
+            uint16_t pppProtocol = (data[0] << 8) | data[1];
+            if (pppProtocol == 0x0021)
+            {
+                protocol = ETHERTYPE_IPV4;
+            }
+            else if (pppProtocol == 0x0057)
+            {
+                protocol = ETHERTYPE_IPV6;
+            }
+            headerSize = 2;
+        }
+        break;
+    case LINKTYPE_RAW:
+    case LINKTYPE_IPV4:
+    case LINKTYPE_IPV6:
+        if (record.inclLen >= 1)
+        {
+            protocol = (data[0] >> 4) == 6 ? ETHERTYPE_IPV6 : ETHERTYPE_IPV4;
+        }
+        break;
+    default:
+        break;
+    }
+    if (!m_peerAddress.IsInvalid())
+    {
+        destination = m_peerAddress;
+    }
+
+    Ptr<Packet> packet = Create<Packet>(data + headerSize, record.inclLen - headerSize);
+    if (record.origLen > record.inclLen)
+    {
+        packet->AddPaddingAtEnd(record.origLen - record.inclLen);
+    }
+    m_txTrace(packet);
+    m_device->Send(packet, destination, protocol);
+    m_sent++;
+}
+
+} // namespace ns3
@@ -0,0 +1,118 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCAP_REPLAY_APPLICATION_H
+#define PCAP_REPLAY_APPLICATION_H
+
+#include "pcap-reader.h"
+
+#include "ns3/address.h"
+#include "ns3/application.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
+
+namespace ns3
+{
+
+class NetDevice;
+class Packet;
+
+/**
+ * \brief Replay the frames of a capture through a NetDevice.
+ *
+ * The frames of a pcap or pcapng file, read by a PcapReader, are sent
+ * through the NetDevice set by the "Device" attribute, with the intervals
+ * between their timestamps, multiplied by the "TimeScale" attribute.  The
+ * first frame is sent when the application starts.
+ *
+ * The link layer header of the frames is removed according to the data
+ * link type of their interface:
+ * - Ethernet frames are sent to their destination address, with their
+ *   EtherType as the protocol number;
+ * - PPP frames are sent to the broadcast address, with the EtherType of
+ *   their IPv4 or IPv6 packet;
+ * - raw IP packets are sent to the broadcast address, with the EtherType
+ *   of their version;
+ * - other frames are sent whole, to the broadcast address, with the
+ *   "Protocol" attribute as the protocol number.
+ *
+ * The "RemoteAddress" attribute, when set, replaces the destination of
+ * all the frames.  The bytes which were not captured are replaced by
+ * zeros, so that the packets have the size of the original frames.
+ *
+ * The application has at most one pending event: each event sends the
+ * frames which are due, and schedules the next one.
+ */
+class PcapReplayApplication : public Application
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    PcapReplayApplication();
+    ~PcapReplayApplication() override;
+
+    /**
+     * \return the number of frames sent
+     */
+    uint64_t GetSent() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    void StartApplication() override;
+    void StopApplication() override;
+
+    /**
+     * \brief Send the frames which are due, and schedule the next ones
+     */
+    void Send();
+    /**
+     * \brief Send a frame
+     * \param record The record of the frame.
+     */
+    void SendRecord(const PcapReader::Record& record);
+    /**
+     * \brief Get the time to send a frame
+     * \param record The record of the frame.
+     * \return The time to send the frame.
+     */
+    Time GetSendTime(const PcapReader::Record& record) const;
+
+    std::string m_filename;      //!< Name of the capture
+    Ptr<NetDevice> m_device;     //!< Device the frames are sent through
+    double m_timeScale;          //!< Factor applied to the intervals between frames
+    Address m_peerAddress;       //!< Destination of all the frames, if valid
+    uint16_t m_protocol;         //!< Protocol number of the frames of unknown type
+    PcapReader m_reader;         //!< Reader of the capture
+    PcapReader::Record m_record; //!< Next frame to send
+    uint64_t m_firstTime;        //!< Timestamp of the first frame, in ns
+    Time m_startTime;            //!< Time the first frame was sent
+    uint64_t m_sent;             //!< Counter for sent frames
+    EventId m_sendEvent;         //!< Event to send the next frames
+
+    /// Traced Callback: sent packets.
+    TracedCallback<Ptr<const Packet>> m_txTrace;
+};
+
+} // namespace ns3
+
+#endif /* PCAP_REPLAY_APPLICATION_H */
@@ -28,6 +28,7 @@
 #include "ns3/queue-fwd.h"
 #include "ns3/queue-item.h"
 #include "ns3/queue-size.h"
+#include "ns3/ring-buffer.h"
 #include "ns3/traced-callback.h"
 #include "ns3/traced-value.h"
 
@@ -245,7 +246,8 @@ class QueueBase : public Object
  * container used internally to store queue items. The container type must provide
  * the methods insert(), erase() and clear() and define the iterator and const_iterator
  * types, following the usual syntax of C++ containers. The default container type
- * is std::list (as defined in queue-fwd.h). In case the container is such that
+ * is RingBuffer (as defined in queue-fwd.h), which does not allocate memory for
+ * every enqueued item, unlike std::list. In case the container is such that
  * an object stored within the queue is obtained from a container element through
  * an operation other than dereferencing an iterator pointing to the container
  * element, the container has to provide a public method named GetItem that
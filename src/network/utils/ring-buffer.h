@@ -0,0 +1,547 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include "ns3/assert.h"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup queue
+ * ns3::RingBuffer declaration and implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup queue
+ * \brief A growable circular buffer, the default container of Queue
+ *
+ * The elements are stored in a vector whose capacity is a power of two,
+ * starting at a head index which wraps around, so that appending an
+ * element and removing the first one only move indices: unlike a
+ * std::list, which allocates a node for every element, the buffer only
+ * allocates when it grows beyond its capacity, which then doubles. The
+ * capacity is never reduced, hence it stays bounded by the largest number
+ * of elements stored at once, e.g., by the maximum size of a queue.
+ *
+ * The container provides the insert(), erase() and clear() methods and the
+ * iterator types required by Queue. Inserting or erasing an element at
+ * either end takes constant time; elsewhere, the elements on one side of
+ * the position are shifted. As for std::deque, inserting or erasing an
+ * element invalidates the iterators.
+ *
+ * The slots which do not hold an element hold a default constructed value,
+ * so that, e.g., a RingBuffer of Ptr does not keep removed objects alive.
+ *
+ * \tparam T \explicit Type of the elements, which must be default
+ * constructible
+ */
+template <typename T>
+class RingBuffer
+{
+  private:
+    /**
+     * \brief Iterator over the elements of a RingBuffer
+     * \tparam Const Whether the iterator gives access to const elements
+     */
+    template <bool Const>
+    class IteratorImpl
+    {
+      public:
+        /// Iterator category
+        using iterator_category = std::random_access_iterator_tag;
+        /// Type of the elements
+        using value_type = T;
+        /// Type of the distance between two iterators
+        using difference_type = std::ptrdiff_t;
+        /// Type of a pointer to an element
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        /// Type of a reference to an element
+        using reference = std::conditional_t<Const, const T&, T&>;
+        /// Type of a pointer to the buffer
+        using BufferPointer = std::conditional_t<Const, const RingBuffer*, RingBuffer*>;
+
+        IteratorImpl()
+            : m_buffer(nullptr),
+              m_index(0)
+        {
+        }
+
+        /**
+         * Constructor
+         * \param buffer the buffer
+         * \param index the position of the element in the buffer
+         */
+        IteratorImpl(BufferPointer buffer, std::size_t index)
+            : m_buffer(buffer),
+              m_index(index)
+        {
+        }
+
+        /**
+         * Conversion of an iterator into a const iterator
+         * \param other the iterator
+         */
+        template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        IteratorImpl(const IteratorImpl<OtherConst>& other)
+            : m_buffer(other.m_buffer),
+              m_index(other.m_index)
+        {
+        }
+
+        /// \return a reference to the element
+        reference operator*() const
+        {
+            return (*m_buffer)[m_index];
+        }
+
+        /// \return a pointer to the element
+        pointer operator->() const
+        {
+            return &(*m_buffer)[m_index];
+        }
+
+        /**
+         * \param n an offset
+         * \return a reference to the element at the given offset
+         */
+        reference operator[](difference_type n) const
+        {
+            return (*m_buffer)[m_index + n];
+        }
+
+        /// \return the iterator, moved to the next element
+        IteratorImpl& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        /// \return the iterator, before it was moved to the next element
+        IteratorImpl operator++(int)
+        {
+            IteratorImpl copy = *this;
+            ++m_index;
+            return copy;
+        }
+
+        /// \return the iterator, moved to the previous element
+        IteratorImpl& operator--()
+        {
+            --m_index;
+            return *this;
+        }
+
+        /// \return the iterator, before it was moved to the previous element
+        IteratorImpl operator--(int)
+        {
+            IteratorImpl copy = *this;
+            --m_index;
+            return copy;
+        }
+
+        /**
+         * \param n an offset
+         * \return the iterator, moved by the offset
+         */
+        IteratorImpl& operator+=(difference_type n)
+        {
+            m_index += n;
+            return *this;
+        }
+
+        /**
+         * \param n an offset
+         * \return the iterator, moved back by the offset
+         */
+        IteratorImpl& operator-=(difference_type n)
+        {
+            m_index -= n;
+            return *this;
+        }
+
+        /**
+         * \param n an offset
+         * \return an iterator to the element at the given offset
+         */
+        IteratorImpl operator+(difference_type n) const
+        {
+            return IteratorImpl(m_buffer, m_index + n);
+        }
+
+        /**
+         * \param n an offset
+         * \return an iterator to the element at the given offset backwards
+         */
+        IteratorImpl operator-(difference_type n) const
+        {
+            return IteratorImpl(m_buffer, m_index - n);
+        }
+
+        /**
+         * \param other another iterator over the same buffer
+         * \return the distance between the iterators
+         */
+        difference_type operator-(const IteratorImpl& other) const
+        {
+            return static_cast<difference_type>(m_index) -
+                   static_cast<difference_type>(other.m_index);
+        }
+
+        /**
+         * \param other another iterator over the same buffer
+         * \return true if the iterators point to the same element
+         */
+        bool operator==(const IteratorImpl& other) const
+        {
+            return m_index == other.m_index;
+        }
+
+        /**
+         * \param other another iterator over the same buffer
+         * \return true if the iterators point to different elements
+         */
+        bool operator!=(const IteratorImpl& other) const
+        {
+            return m_index != other.m_index;
+        }
+
+        /**
+         * \param other another iterator over the same buffer
+         * \return true if the iterator points to an element before the other
+         */
+        bool operator<(const IteratorImpl& other) const
+        {
+            return m_index < other.m_index;
+        }
+
+      private:
+        friend class RingBuffer;
+        friend class IteratorImpl<!Const>;
+
+        BufferPointer m_buffer; //!< The buffer
+        std::size_t m_index;    //!< The position of the element in the buffer
+    };
+
+  public:
+    /// Type of the elements
+    using value_type = T;
+    /// Type of the number of elements
+    using size_type = std::size_t;
+    /// Iterator
+    using iterator = IteratorImpl<false>;
+    /// Const iterator
+    using const_iterator = IteratorImpl<true>;
+
+    RingBuffer()
+        : m_head(0),
+          m_size(0)
+    {
+    }
+
+    /// \return an iterator to the first element
+    iterator begin()
+    {
+        return iterator(this, 0);
+    }
+
+    /// \return an iterator past the last element
+    iterator end()
+    {
+        return iterator(this, m_size);
+    }
+
+    /// \return a const iterator to the first element
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+
+    /// \return a const iterator past the last element
+    const_iterator end() const
+    {
+        return const_iterator(this, m_size);
+    }
+
+    /// \return a const iterator to the first element
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    /// \return a const iterator past the last element
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    /// \return the number of elements
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /// \return true if the buffer has no element
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// \return the number of elements the buffer holds without growing
+    size_type capacity() const
+    {
+        return m_slots.size();
+    }
+
+    /**
+     * \brief Grow the buffer so that it holds the given number of elements
+     * \param n the number of elements
+     */
+    void reserve(size_type n)
+    {
+        if (n > m_slots.size())
+        {
+            size_type capacity = m_slots.empty() ? MIN_CAPACITY : m_slots.size();
+            while (capacity < n)
+            {
+                capacity *= 2;
+            }
+            Reallocate(capacity);
+        }
+    }
+
+    /**
+     * \param i the position of an element
+     * \return a reference to the element
+     */
+    T& operator[](size_type i)
+    {
+        NS_ASSERT_MSG(i < m_size, "Position " << i << " out of a buffer of " << m_size);
+        return m_slots[Slot(i)];
+    }
+
+    /**
+     * \param i the position of an element
+     * \return a const reference to the element
+     */
+    const T& operator[](size_type i) const
+    {
+        NS_ASSERT_MSG(i < m_size, "Position " << i << " out of a buffer of " << m_size);
+        return m_slots[Slot(i)];
+    }
+
+    /// \return a reference to the first element
+    T& front()
+    {
+        return (*this)[0];
+    }
+
+    /// \return a const reference to the first element
+    const T& front() const
+    {
+        return (*this)[0];
+    }
+
+    /// \return a reference to the last element
+    T& back()
+    {
+        return (*this)[m_size - 1];
+    }
+
+    /// \return a const reference to the last element
+    const T& back() const
+    {
+        return (*this)[m_size - 1];
+    }
+
+    /**
+     * \brief Append an element
+     * \param value the element
+     */
+    void push_back(T value)
+    {
+        Grow();
+        m_slots[Slot(m_size)] = std::move(value);
+        m_size++;
+    }
+
+    /**
+     * \brief Prepend an element
+     * \param value the element
+     */
+    void push_front(T value)
+    {
+        Grow();
+        m_head = (m_head - 1) & (m_slots.size() - 1);
+        m_slots[m_head] = std::move(value);
+        m_size++;
+    }
+
+    /**
+     * \brief Remove the first element
+     */
+    void pop_front()
+    {
+        NS_ASSERT_MSG(m_size > 0, "Empty buffer");
+        m_slots[m_head] = T();
+        m_head = (m_head + 1) & (m_slots.size() - 1);
+        m_size--;
+    }
+
+    /**
+     * \brief Remove the last element
+     */
+    void pop_back()
+    {
+        NS_ASSERT_MSG(m_size > 0, "Empty buffer");
+        m_size--;
+        m_slots[Slot(m_size)] = T();
+    }
+
+    /**
+     * \brief Insert an element
+     * \param pos the position before which the element is inserted
+     * \param value the element
+     * \return an iterator to the inserted element
+     */
+    iterator insert(const_iterator pos, T value)
+    {
+        size_type index = pos.m_index;
+        NS_ASSERT_MSG(index <= m_size, "Position " << index << " out of a buffer of " << m_size);
+        if (index == m_size)
+        {
+            push_back(std::move(value));
+        }
+        else if (index == 0)
+        {
+            push_front(std::move(value));
+        }
+        else if (index < m_size / 2)
+        {
+            push_front(T());
+            for (size_type i = 0; i < index; ++i)
+            {
+                (*this)[i] = std::move((*this)[i + 1]);
+            }
+            (*this)[index] = std::move(value);
+        }
+        else
+        {
+            push_back(T());
+            for (size_type i = m_size - 1; i > index; --i)
+            {
+                (*this)[i] = std::move((*this)[i - 1]);
+            }
+            (*this)[index] = std::move(value);
+        }
+        return iterator(this, index);
+    }
+
+    /**
+     * \brief Remove an element
+     * \param pos the position of the element
+     * \return an iterator to the element which followed the removed one
+     */
+    iterator erase(const_iterator pos)
+    {
+        size_type index = pos.m_index;
+        NS_ASSERT_MSG(index < m_size, "Position " << index << " out of a buffer of " << m_size);
+        if (index < m_size / 2)
+        {
+            for (size_type i = index; i > 0; --i)
+            {
+                (*this)[i] = std::move((*this)[i - 1]);
+            }
+            pop_front();
+        }
+        else
+        {
+            for (size_type i = index; i + 1 < m_size; ++i)
+            {
+                (*this)[i] = std::move((*this)[i + 1]);
+            }
+            pop_back();
+        }
+        return iterator(this, index);
+    }
+
+    /**
+     * \brief Remove all the elements, keeping the capacity
+     */
+    void clear()
+    {
+        while (m_size > 0)
+        {
+            pop_back();
+        }
+        m_head = 0;
+    }
+
+  private:
+    /// The capacity of a buffer when it first grows
+    static constexpr size_type MIN_CAPACITY = 16;
+
+    /**
+     * \param i the position of an element
+     * \return the slot of the element
+     */
+    size_type Slot(size_type i) const
+    {
+        return (m_head + i) & (m_slots.size() - 1);
+    }
+
+    /**
+     * \brief Double the capacity of a full buffer
+     */
+    void Grow()
+    {
+        if (m_size == m_slots.size())
+        {
+            Reallocate(m_slots.empty() ? MIN_CAPACITY : 2 * m_slots.size());
+        }
+    }
+
+    /**
+     * \brief Move the elements to new slots, starting at the first one
+     * \param capacity the new capacity, a power of two
+     */
+    void Reallocate(size_type capacity)
+    {
+        std::vector<T> slots(capacity);
+        for (size_type i = 0; i < m_size; ++i)
+        {
+            slots[i] = std::move(m_slots[Slot(i)]);
+        }
+        m_slots.swap(slots);
+        m_head = 0;
+    }
+
+    std::vector<T> m_slots; //!< The slots, whose number is zero or a power of two
+    size_type m_head;       //!< The slot of the first element
+    size_type m_size;       //!< The number of elements
+};
+
+} // namespace ns3
+
+#endif /* RING_BUFFER_H */
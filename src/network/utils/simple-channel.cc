@@ -26,6 +26,7 @@
 #include "ns3/simulator.h"
 
 #include <algorithm>
+#include <iterator>
 
 namespace ns3
 {
@@ -54,6 +55,23 @@ SimpleChannel::SimpleChannel()
     NS_LOG_FUNCTION(this);
 }
 
+/**
+ * \param address a MAC address
+ * \return the address as an integer, the key of the address index
+ */
+static uint64_t
+AddressKey(Mac48Address address)
+{
+    uint8_t buffer[6];
+    address.CopyTo(buffer);
+    uint64_t key = 0;
+    for (uint8_t byte : buffer)
+    {
+        key = (key << 8) | byte;
+    }
+    return key;
+}
+
 void
 SimpleChannel::Send(Ptr<Packet> p,
                     uint16_t protocol,
@@ -62,22 +80,89 @@ SimpleChannel::Send(Ptr<Packet> p,
                     Ptr<SimpleNetDevice> sender)
 {
     NS_LOG_FUNCTION(this << p << protocol << to << from << sender);
-    for (std::vector<Ptr<SimpleNetDevice>>::const_iterator i = m_devices.begin();
-         i != m_devices.end();
-         ++i)
+
+    if (to.IsGroup())
     {
-        Ptr<SimpleNetDevice> tmp = *i;
-        if (tmp == sender)
-        {
-            continue;
-        }
-        if (m_blackListedDevices.find(tmp) != m_blackListedDevices.end())
+        for (const auto& node : m_nodeDevices)
         {
-            if (find(m_blackListedDevices[tmp].begin(), m_blackListedDevices[tmp].end(), sender) !=
-                m_blackListedDevices[tmp].end())
+            if (node.devices.size() == 1)
             {
+                Ptr<SimpleNetDevice> tmp = m_devices[node.devices.front()];
+                if (tmp != sender && !IsBlackListed(sender, tmp))
+                {
+                    Simulator::ScheduleWithContext(node.context,
+                                                   m_delay,
+                                                   &SimpleNetDevice::Receive,
+                                                   tmp,
+                                                   p->Copy(),
+                                                   protocol,
+                                                   to,
+                                                   from);
+                }
                 continue;
             }
+            std::vector<Ptr<SimpleNetDevice>> receivers;
+            for (std::size_t i : node.devices)
+            {
+                Ptr<SimpleNetDevice> tmp = m_devices[i];
+                if (tmp != sender && !IsBlackListed(sender, tmp))
+                {
+                    receivers.push_back(tmp);
+                }
+            }
+            if (receivers.size() == 1)
+            {
+                Simulator::ScheduleWithContext(node.context,
+                                               m_delay,
+                                               &SimpleNetDevice::Receive,
+                                               receivers.front(),
+                                               p->Copy(),
+                                               protocol,
+                                               to,
+                                               from);
+            }
+            else if (!receivers.empty())
+            {
+                Simulator::ScheduleWithContext(node.context,
+                                               m_delay,
+                                               &SimpleChannel::Deliver,
+                                               this,
+                                               std::move(receivers),
+                                               p->Copy(),
+                                               protocol,
+                                               to,
+                                               from);
+            }
+        }
+        return;
+    }
+
+    // The devices with the destination address, and those receiving all the
+    // frames, in the order they were attached to the channel.  Send may run
+    // concurrently for the devices of different nodes, so the indexes are
+    // only read here.
+    const std::vector<std::size_t>* receivers = &m_allFramesDevices;
+    std::vector<std::size_t> merged;
+    auto it = m_addressIndex.find(AddressKey(to));
+    if (it != m_addressIndex.end())
+    {
+        receivers = &it->second;
+        if (!m_allFramesDevices.empty())
+        {
+            std::merge(it->second.begin(),
+                       it->second.end(),
+                       m_allFramesDevices.begin(),
+                       m_allFramesDevices.end(),
+                       std::back_inserter(merged));
+            receivers = &merged;
+        }
+    }
+    for (std::size_t i : *receivers)
+    {
+        Ptr<SimpleNetDevice> tmp = m_devices[i];
+        if (tmp == sender || IsBlackListed(sender, tmp))
+        {
+            continue;
         }
         Simulator::ScheduleWithContext(tmp->GetNode()->GetId(),
                                        m_delay,
@@ -90,11 +175,88 @@ SimpleChannel::Send(Ptr<Packet> p,
     }
 }
 
+void
+SimpleChannel::Deliver(std::vector<Ptr<SimpleNetDevice>> receivers,
+                       Ptr<Packet> p,
+                       uint16_t protocol,
+                       Mac48Address to,
+                       Mac48Address from)
+{
+    NS_LOG_FUNCTION(this << receivers.size() << p << protocol << to << from);
+    for (std::size_t i = 0; i + 1 < receivers.size(); ++i)
+    {
+        receivers[i]->Receive(p->Copy(), protocol, to, from);
+    }
+    receivers.back()->Receive(p, protocol, to, from);
+}
+
+bool
+SimpleChannel::IsBlackListed(Ptr<SimpleNetDevice> sender, Ptr<SimpleNetDevice> receiver) const
+{
+    if (m_blackListedDevices.empty())
+    {
+        return false;
+    }
+    auto it = m_blackListedDevices.find(receiver);
+    return it != m_blackListedDevices.end() &&
+           std::find(it->second.begin(), it->second.end(), sender) != it->second.end();
+}
+
+void
+SimpleChannel::BuildIndex()
+{
+    NS_LOG_FUNCTION(this);
+    m_addressIndex.clear();
+    m_allFramesDevices.clear();
+    m_nodeDevices.clear();
+    m_nodeIndex.clear();
+    for (std::size_t i = 0; i < m_devices.size(); ++i)
+    {
+        IndexDevice(i);
+    }
+}
+
+void
+SimpleChannel::IndexDevice(std::size_t i)
+{
+    NS_LOG_FUNCTION(this << i);
+    Ptr<SimpleNetDevice> device = m_devices[i];
+    if (!device->GetNode())
+    {
+        return;
+    }
+    if (device->ReceivesAllFrames())
+    {
+        m_allFramesDevices.push_back(i);
+    }
+    else
+    {
+        Mac48Address address = Mac48Address::ConvertFrom(device->GetAddress());
+        m_addressIndex[AddressKey(address)].push_back(i);
+    }
+    uint32_t context = device->GetNode()->GetId();
+    auto node = m_nodeIndex.find(context);
+    if (node == m_nodeIndex.end())
+    {
+        node = m_nodeIndex.emplace(context, m_nodeDevices.size()).first;
+        m_nodeDevices.push_back({context, {}});
+    }
+    m_nodeDevices[node->second].devices.push_back(i);
+}
+
+void
+SimpleChannel::NotifyDeviceChanged()
+{
+    NS_LOG_FUNCTION(this);
+    BuildIndex();
+}
+
 void
 SimpleChannel::Add(Ptr<SimpleNetDevice> device)
 {
     NS_LOG_FUNCTION(this << device);
     m_devices.push_back(device);
+    IndexDevice(m_devices.size() - 1);
 }
 
 std::size_t
@@ -25,6 +25,7 @@
 #include "ns3/nstime.h"
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -44,6 +45,17 @@ class Packet;
  * are using 48-bit MAC addresses.
  *
  * This channel is meant to be used by ns3::SimpleNetDevices.
+ *
+ * The devices are indexed by address, so that a unicast frame is only
+ * delivered to the devices with its destination address, and to the
+ * devices which receive all the frames (see
+ * SimpleNetDevice::ReceivesAllFrames), rather than to every device.
+ * A broadcast or multicast frame is delivered to all the devices of a
+ * node by a single event.  The devices of different nodes which receive
+ * a frame at the same time therefore receive it in the order in which
+ * their nodes were first attached to the channel, which differs from the
+ * order in which the devices were attached if the devices of a node were
+ * not attached consecutively.
  */
 class SimpleChannel : public Channel
 {
@@ -57,8 +69,10 @@ class SimpleChannel : public Channel
 
     /**
      * A packet is sent by a net device.  A receive event will be
-     * scheduled for all net device connected to the channel other
-     * than the net device who sent the packet
+     * scheduled for the net devices connected to the channel, other
+     * than the net device who sent the packet, which receive it: all of
+     * them for a broadcast or multicast packet, and those with the
+     * destination address, or receiving all the frames, for a unicast one
      *
      * \param p packet to be sent
      * \param protocol protocol number
@@ -98,15 +112,73 @@ class SimpleChannel : public Channel
      */
     virtual void UnBlackList(Ptr<SimpleNetDevice> from, Ptr<SimpleNetDevice> to);
 
+    /**
+     * Notify the channel that the address or the node of an attached device
+     * has changed, or whether it receives all the frames, so that the
+     * devices are indexed again.
+     */
+    void NotifyDeviceChanged();
+
     // inherited from ns3::Channel
     std::size_t GetNDevices() const override;
     Ptr<NetDevice> GetDevice(std::size_t i) const override;
 
   private:
+    /**
+     * \brief The devices of a node connected by the channel
+     */
+    struct NodeDevices
+    {
+        uint32_t context;                 //!< The id of the node
+        std::vector<std::size_t> devices; //!< The positions of the devices in m_devices
+    };
+
+    /**
+     * Index the devices by address and by node.
+     */
+    void BuildIndex();
+
+    /**
+     * Add a device to the indexes.  The devices without a node are not
+     * indexed until their node is set.
+     *
+     * \param i the position of the device in m_devices
+     */
+    void IndexDevice(std::size_t i);
+
+    /**
+     * \param sender the device sending a packet
+     * \param receiver a device connected to the channel
+     * \return true if the receiver blocks the packets of the sender
+     */
+    bool IsBlackListed(Ptr<SimpleNetDevice> sender, Ptr<SimpleNetDevice> receiver) const;
+
+    /**
+     * Deliver a packet to the devices of a node.
+     *
+     * \param receivers the devices
+     * \param p packet to deliver, a copy of the packet sent
+     * \param protocol protocol number
+     * \param to address the packet is sent to
+     * \param from address the packet is coming from
+     */
+    void Deliver(std::vector<Ptr<SimpleNetDevice>> receivers,
+                 Ptr<Packet> p,
+                 uint16_t protocol,
+                 Mac48Address to,
+                 Mac48Address from);
+
     Time m_delay; //!< The assigned speed-of-light delay of the channel
     std::vector<Ptr<SimpleNetDevice>> m_devices; //!< devices connected by the channel
     std::map<Ptr<SimpleNetDevice>, std::vector<Ptr<SimpleNetDevice>>>
         m_blackListedDevices; //!< devices blocked on a device
+
+    /// Positions of the devices by address, except those receiving all the frames
+    std::unordered_map<uint64_t, std::vector<std::size_t>> m_addressIndex;
+    std::vector<std::size_t> m_allFramesDevices; //!< Positions of the devices receiving all frames
+    std::vector<NodeDevices> m_nodeDevices;      //!< Devices by node, in the order of attachment
+    /// Positions of the nodes in m_nodeDevices, by node id
+    std::unordered_map<uint32_t, std::size_t> m_nodeIndex;
 };
 
 } // namespace ns3
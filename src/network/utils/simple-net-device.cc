@@ -196,7 +196,8 @@ SimpleNetDevice::GetTypeId()
             .AddAttribute("ReceiveErrorModel",
                           "The receiver error model used to simulate packet loss",
                           PointerValue(),
-                          MakePointerAccessor(&SimpleNetDevice::m_receiveErrorModel),
+                          MakePointerAccessor(&SimpleNetDevice::SetReceiveErrorModel,
+                                              &SimpleNetDevice::GetReceiveErrorModel),
                           MakePointerChecker<ErrorModel>())
             .AddAttribute("PointToPointMode",
                           "The device is configured in Point to Point mode",
@@ -300,6 +301,22 @@ SimpleNetDevice::SetReceiveErrorModel(Ptr<ErrorModel> em)
 {
     NS_LOG_FUNCTION(this << em);
     m_receiveErrorModel = em;
+    if (m_channel)
+    {
+        m_channel->NotifyDeviceChanged();
+    }
+}
+
+Ptr<ErrorModel>
+SimpleNetDevice::GetReceiveErrorModel() const
+{
+    return m_receiveErrorModel;
+}
+
+bool
+SimpleNetDevice::ReceivesAllFrames() const
+{
+    return !m_promiscCallback.IsNull() || m_receiveErrorModel;
 }
 
 void
@@ -328,6 +345,10 @@ SimpleNetDevice::SetAddress(Address address)
 {
     NS_LOG_FUNCTION(this << address);
     m_address = Mac48Address::ConvertFrom(address);
+    if (m_channel)
+    {
+        m_channel->NotifyDeviceChanged();
+    }
 }
 
 Address
@@ -534,6 +555,10 @@ SimpleNetDevice::SetNode(Ptr<Node> node)
 {
     NS_LOG_FUNCTION(this << node);
     m_node = node;
+    if (m_channel)
+    {
+        m_channel->NotifyDeviceChanged();
+    }
 }
 
 bool
@@ -574,6 +599,10 @@ SimpleNetDevice::SetPromiscReceiveCallback(PromiscReceiveCallback cb)
 {
     NS_LOG_FUNCTION(this << &cb);
     m_promiscCallback = cb;
+    if (m_channel)
+    {
+        m_channel->NotifyDeviceChanged();
+    }
 }
 
 bool
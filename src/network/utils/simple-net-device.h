@@ -107,6 +107,21 @@ class SimpleNetDevice : public NetDevice
      */
     void SetReceiveErrorModel(Ptr<ErrorModel> em);
 
+    /**
+     * \return the receive ErrorModel of the SimpleNetDevice, if any.
+     */
+    Ptr<ErrorModel> GetReceiveErrorModel() const;
+
+    /**
+     * Whether the device receives the frames addressed to other devices,
+     * so that the channel delivers them all to it. This is the case if the
+     * device has a promiscuous receive callback, or a receive ErrorModel,
+     * which handles every frame received.
+     *
+     * \return true if the device receives all the frames.
+     */
+    bool ReceivesAllFrames() const;
+
     // inherited from NetDevice base class.
     void SetIfIndex(const uint32_t index) override;
     uint32_t GetIfIndex() const override;
@@ -0,0 +1,339 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef THREAD_CACHE_H
+#define THREAD_CACHE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup packet
+ * ns3::ThreadCache declaration and implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup packet
+ * \brief Statistics of the allocations of a ThreadCache.
+ */
+struct ThreadCacheStats
+{
+    uint64_t hits;     //!< Blocks reused from a cache.
+    uint64_t misses;   //!< Blocks allocated on the heap.
+    uint64_t releases; //!< Blocks returned to the heap.
+};
+
+/**
+ * \ingroup packet
+ * \brief A cache of memory blocks of each thread, backed by a cache shared
+ * by the threads.
+ *
+ * Each thread first reuses the blocks it freed itself, without any lock.
+ * The blocks move by batches to and from the shared cache, under its
+ * lock, when a class of the thread cache is empty or full: a thread which
+ * mostly frees blocks allocated by other threads, as the receiver of a
+ * channel, passes them to the threads which allocate them.
+ *
+ * The caches are created on demand.  The cache of a thread is destroyed
+ * at the exit of the thread, and the shared cache by the static
+ * destructors; the blocks are then allocated and freed on the heap.
+ *
+ * The traits provide:
+ * - \c Block, the type of the blocks;
+ * - \c N_CLASSES, the number of size classes of the blocks;
+ * - \c THREAD_CACHE_SIZE, the maximum number of blocks of each class in
+ *   a thread cache;
+ * - \c BATCH_SIZE, the number of blocks moved at once between a thread
+ *   cache and the shared cache;
+ * - \c SHARED_CACHE_SIZE, the maximum number of blocks of each class in
+ *   the shared cache;
+ * - \c Allocate(sizeClass), which allocates a block of a class on the heap;
+ * - \c Deallocate(block), which frees a block on the heap.
+ *
+ * \tparam Traits \explicit The traits of the blocks
+ */
+template <typename Traits>
+class ThreadCache
+{
+  public:
+    /// Type of the blocks
+    using Block = typename Traits::Block;
+
+    /**
+     * Get the cache of the calling thread, created on first use.
+     * \returns The cache, or nullptr if it was destroyed.
+     */
+    static ThreadCache* Get();
+
+    /**
+     * Get a block of a class, from the caches or from the heap.
+     * \param [in] sizeClass The size class.
+     * \returns The block.
+     */
+    Block* Pop(uint32_t sizeClass = 0);
+    /**
+     * Cache a block, or free it if the caches are full.
+     * \param [in] block The block.
+     * \param [in] sizeClass The size class of \p block.
+     */
+    void Push(Block* block, uint32_t sizeClass = 0);
+
+    /**
+     * Count a block allocated on the heap by the caller.
+     */
+    void CountMiss()
+    {
+        Increment(m_misses);
+    }
+
+    /**
+     * Count a block returned to the heap by the caller.
+     */
+    void CountRelease()
+    {
+        Increment(m_releases);
+    }
+
+    /**
+     * Get the statistics of the allocations of all the threads.
+     * \returns The statistics since the start of the process.
+     */
+    static ThreadCacheStats GetStats();
+
+  private:
+    /**
+     * The blocks cached by all the threads, and the statistics of the
+     * threads.
+     */
+    struct SharedCache
+    {
+        ~SharedCache();
+
+        /**
+         * Get the shared cache.
+         * \returns The shared cache, or nullptr if it was destroyed.
+         */
+        static SharedCache* Get();
+
+        std::mutex m_mutex;                             //!< Lock of all the members.
+        std::vector<Block*> m_lists[Traits::N_CLASSES]; //!< Cached blocks of each class.
+        std::vector<ThreadCache*> m_threads;            //!< The live thread caches.
+        ThreadCacheStats m_stats{0, 0, 0};              //!< Statistics of the exited threads.
+        static inline bool g_destroyed = false;         //!< Whether the cache was destroyed.
+    };
+
+    /**
+     * Create the cache of the calling thread and register it.
+     * \param [in] shared The shared cache.
+     */
+    ThreadCache(SharedCache* shared);
+    ~ThreadCache();
+
+    /**
+     * Increment a counter read by other threads.
+     * \param [in,out] counter The counter, only written by this thread.
+     */
+    static void Increment(std::atomic<uint64_t>& counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Like the original free list of Buffer, the cache pointer of a thread
+     * has three states: uninitialized (null, before the first block of the
+     * thread), initialized, and destroyed.  It is a plain pointer, so it
+     * stays valid after the cache itself was destroyed at the exit of the
+     * thread.
+     * \returns The value of the pointer once the cache was destroyed.
+     */
+    static ThreadCache* Destroyed()
+    {
+        return reinterpret_cast<ThreadCache*>(~static_cast<uintptr_t>(0));
+    }
+
+    SharedCache* m_shared;                                        //!< The shared cache.
+    Block* m_lists[Traits::N_CLASSES][Traits::THREAD_CACHE_SIZE]; //!< Cached blocks of each class.
+    uint32_t m_sizes[Traits::N_CLASSES];                          //!< Number of cached blocks.
+    std::atomic<uint64_t> m_hits{0};                              //!< Blocks reused from a cache.
+    std::atomic<uint64_t> m_misses{0};                            //!< Blocks allocated on the heap.
+    std::atomic<uint64_t> m_releases{0};                          //!< Blocks returned to the heap.
+    static inline thread_local ThreadCache* g_cache = nullptr;    //!< The cache of the thread.
+};
+
+/*************************************************
+ *  Implementation
+ *************************************************/
+
+template <typename Traits>
+typename ThreadCache<Traits>::SharedCache*
+ThreadCache<Traits>::SharedCache::Get()
+{
+    if (g_destroyed)
+    {
+        return nullptr;
+    }
+    static SharedCache shared;
+    return &shared;
+}
+
+template <typename Traits>
+ThreadCache<Traits>::SharedCache::~SharedCache()
+{
+    for (auto& list : m_lists)
+    {
+        for (auto block : list)
+        {
+            Traits::Deallocate(block);
+        }
+    }
+    g_destroyed = true;
+}
+
+template <typename Traits>
+ThreadCache<Traits>::ThreadCache(SharedCache* shared)
+    : m_shared(shared),
+      m_sizes()
+{
+    std::lock_guard<std::mutex> lock(m_shared->m_mutex);
+    m_shared->m_threads.push_back(this);
+}
+
+template <typename Traits>
+ThreadCache<Traits>::~ThreadCache()
+{
+    g_cache = Destroyed();
+    // The thread caches are destroyed before the static objects, so the
+    // shared cache is still alive.
+    std::lock_guard<std::mutex> lock(m_shared->m_mutex);
+    for (uint32_t i = 0; i < Traits::N_CLASSES; ++i)
+    {
+        for (uint32_t j = 0; j < m_sizes[i]; ++j)
+        {
+            if (m_shared->m_lists[i].size() < Traits::SHARED_CACHE_SIZE)
+            {
+                m_shared->m_lists[i].push_back(m_lists[i][j]);
+            }
+            else
+            {
+                Traits::Deallocate(m_lists[i][j]);
+                Increment(m_releases);
+            }
+        }
+    }
+    m_shared->m_stats.hits += m_hits;
+    m_shared->m_stats.misses += m_misses;
+    m_shared->m_stats.releases += m_releases;
+    auto& threads = m_shared->m_threads;
+    threads.erase(std::find(threads.begin(), threads.end(), this));
+}
+
+template <typename Traits>
+ThreadCache<Traits>*
+ThreadCache<Traits>::Get()
+{
+    ThreadCache* cache = g_cache;
+    if (cache == nullptr)
+    {
+        SharedCache* shared = SharedCache::Get();
+        if (shared == nullptr)
+        {
+            return nullptr;
+        }
+        static thread_local ThreadCache threadCache(shared);
+        g_cache = cache = &threadCache;
+    }
+    return cache == Destroyed() ? nullptr : cache;
+}
+
+template <typename Traits>
+typename ThreadCache<Traits>::Block*
+ThreadCache<Traits>::Pop(uint32_t sizeClass)
+{
+    uint32_t& size = m_sizes[sizeClass];
+    if (size == 0)
+    {
+        std::lock_guard<std::mutex> lock(m_shared->m_mutex);
+        std::vector<Block*>& shared = m_shared->m_lists[sizeClass];
+        while (size < Traits::BATCH_SIZE && !shared.empty())
+        {
+            m_lists[sizeClass][size++] = shared.back();
+            shared.pop_back();
+        }
+    }
+    if (size == 0)
+    {
+        Increment(m_misses);
+        return Traits::Allocate(sizeClass);
+    }
+    Increment(m_hits);
+    return m_lists[sizeClass][--size];
+}
+
+template <typename Traits>
+void
+ThreadCache<Traits>::Push(Block* block, uint32_t sizeClass)
+{
+    uint32_t& size = m_sizes[sizeClass];
+    if (size == Traits::THREAD_CACHE_SIZE)
+    {
+        std::lock_guard<std::mutex> lock(m_shared->m_mutex);
+        std::vector<Block*>& shared = m_shared->m_lists[sizeClass];
+        for (uint32_t i = 0; i < Traits::BATCH_SIZE; ++i)
+        {
+            Block* evicted = m_lists[sizeClass][--size];
+            if (shared.size() < Traits::SHARED_CACHE_SIZE)
+            {
+                shared.push_back(evicted);
+            }
+            else
+            {
+                Traits::Deallocate(evicted);
+                Increment(m_releases);
+            }
+        }
+    }
+    m_lists[sizeClass][size++] = block;
+}
+
+template <typename Traits>
+ThreadCacheStats
+ThreadCache<Traits>::GetStats()
+{
+    SharedCache* shared = SharedCache::Get();
+    if (shared == nullptr)
+    {
+        return {0, 0, 0};
+    }
+    std::lock_guard<std::mutex> lock(shared->m_mutex);
+    ThreadCacheStats stats = shared->m_stats;
+    for (auto cache : shared->m_threads)
+    {
+        stats.hits += cache->m_hits.load(std::memory_order_relaxed);
+        stats.misses += cache->m_misses.load(std::memory_order_relaxed);
+        stats.releases += cache->m_releases.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+} // namespace ns3
+
+#endif /* THREAD_CACHE_H */
@@ -0,0 +1,233 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/node-container.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \brief Measure the speed of the simulation of a dumbbell of
+ * PointToPoint links.
+ *
+ * The left leaves send packets to the left router, which forwards them
+ * over the bottleneck link to the right router, which spreads them over
+ * the right leaves.  The links are fast enough to never drop a packet.
+ */
+class PointToPointDumbbellPerformanceTest : public TestCase
+{
+  public:
+    /**
+     * \brief Create the test
+     *
+     * \param leaves The number of leaves on each side.
+     * \param packets The number of packets sent by each left leaf.
+     */
+    PointToPointDumbbellPerformanceTest(uint32_t leaves, uint32_t packets);
+
+    /**
+     * \brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /**
+     * \brief Send a packet, and schedule the next one
+     *
+     * \param device The device of the left leaf.
+     * \param remaining The number of packets left to send.
+     */
+    void Send(Ptr<NetDevice> device, uint32_t remaining);
+    /**
+     * \brief Forward a packet from a left leaf over the bottleneck link
+     *
+     * \param dev The receiving device.
+     * \param pkt The received packet.
+     * \param protocol The protocol number.
+     * \param sender The sender address.
+     *
+     * \return A boolean indicating packet handled properly.
+     */
+    bool ForwardLeft(Ptr<NetDevice> dev,
+                     Ptr<const Packet> pkt,
+                     uint16_t protocol,
+                     const Address& sender);
+    /**
+     * \brief Forward a packet from the bottleneck link to a right leaf
+     *
+     * \param dev The receiving device.
+     * \param pkt The received packet.
+     * \param protocol The protocol number.
+     * \param sender The sender address.
+     *
+     * \return A boolean indicating packet handled properly.
+     */
+    bool ForwardRight(Ptr<NetDevice> dev,
+                      Ptr<const Packet> pkt,
+                      uint16_t protocol,
+                      const Address& sender);
+    /**
+     * \brief Count a packet received by a right leaf
+     *
+     * \param dev The receiving device.
+     * \param pkt The received packet.
+     * \param protocol The protocol number.
+     * \param sender The sender address.
+     *
+     * \return A boolean indicating packet handled properly.
+     */
+    bool Receive(Ptr<NetDevice> dev,
+                 Ptr<const Packet> pkt,
+                 uint16_t protocol,
+                 const Address& sender);
+
+    uint32_t m_leaves;                       //!< The number of leaves on each side.
+    uint32_t m_packets;                      //!< The number of packets of each left leaf.
+    Ptr<NetDevice> m_bottleneck;             //!< The bottleneck device of the left router.
+    std::vector<Ptr<NetDevice>> m_rightDevs; //!< The right router devices to the leaves.
+    uint32_t m_next;                         //!< The next right leaf.
+    uint32_t m_received;                     //!< The packets received by the right leaves.
+};
+
+PointToPointDumbbellPerformanceTest::PointToPointDumbbellPerformanceTest(uint32_t leaves,
+                                                                         uint32_t packets)
+    : TestCase("Dumbbell of " + std::to_string(leaves) + " leaves on each side"),
+      m_leaves(leaves),
+      m_packets(packets),
+      m_next(0),
+      m_received(0)
+{
+}
+
+void
+PointToPointDumbbellPerformanceTest::Send(Ptr<NetDevice> device, uint32_t remaining)
+{
+    device->Send(Create<Packet>(1000), device->GetBroadcast(), 0x800);
+    if (remaining > 1)
+    {
+        Simulator::Schedule(MicroSeconds(20),
+                            &PointToPointDumbbellPerformanceTest::Send,
+                            this,
+                            device,
+                            remaining - 1);
+    }
+}
+
+bool
+PointToPointDumbbellPerformanceTest::ForwardLeft(Ptr<NetDevice> dev,
+                                                 Ptr<const Packet> pkt,
+                                                 uint16_t protocol,
+                                                 const Address& sender)
+{
+    m_bottleneck->Send(pkt->Copy(), m_bottleneck->GetBroadcast(), protocol);
+    return true;
+}
+
+bool
+PointToPointDumbbellPerformanceTest::ForwardRight(Ptr<NetDevice> dev,
+                                                  Ptr<const Packet> pkt,
+                                                  uint16_t protocol,
+                                                  const Address& sender)
+{
+    Ptr<NetDevice> device = m_rightDevs[m_next];
+    m_next = (m_next + 1) % m_leaves;
+    device->Send(pkt->Copy(), device->GetBroadcast(), protocol);
+    return true;
+}
+
+bool
+PointToPointDumbbellPerformanceTest::Receive(Ptr<NetDevice> dev,
+                                             Ptr<const Packet> pkt,
+                                             uint16_t protocol,
+                                             const Address& sender)
+{
+    m_received++;
+    return true;
+}
+
+void
+PointToPointDumbbellPerformanceTest::DoRun()
+{
+    NodeContainer routers(2);
+    NodeContainer leftLeaves(m_leaves);
+    NodeContainer rightLeaves(m_leaves);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("10Gbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("10ms"));
+    NetDeviceContainer bottleneck = p2p.Install(routers.Get(0), routers.Get(1));
+    m_bottleneck = bottleneck.Get(0);
+    bottleneck.Get(1)->SetReceiveCallback(
+        MakeCallback(&PointToPointDumbbellPerformanceTest::ForwardRight, this));
+
+    p2p.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("1ms"));
+    for (uint32_t i = 0; i < m_leaves; ++i)
+    {
+        NetDeviceContainer left = p2p.Install(leftLeaves.Get(i), routers.Get(0));
+        left.Get(1)->SetReceiveCallback(
+            MakeCallback(&PointToPointDumbbellPerformanceTest::ForwardLeft, this));
+        Simulator::Schedule(MicroSeconds(i),
+                            &PointToPointDumbbellPerformanceTest::Send,
+                            this,
+                            left.Get(0),
+                            m_packets);
+
+        NetDeviceContainer right = p2p.Install(routers.Get(1), rightLeaves.Get(i));
+        m_rightDevs.push_back(right.Get(0));
+        right.Get(1)->SetReceiveCallback(
+            MakeCallback(&PointToPointDumbbellPerformanceTest::Receive, this));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t events = Simulator::GetEventCount();
+    Simulator::Destroy();
+    m_bottleneck = nullptr;
+    m_rightDevs.clear();
+
+    NS_TEST_ASSERT_MSG_EQ(m_received, m_leaves * m_packets, "Packets were lost");
+    ReportMetric("events", events / elapsed.count(), "events/s");
+    ReportMetric("packets", m_received / elapsed.count(), "packets/s");
+}
+
+/**
+ * \brief TestSuite for the speed of the PointToPoint model
+ */
+class PointToPointPerformanceTestSuite : public TestSuite
+{
+  public:
+    /**
+     * \brief Constructor
+     */
+    PointToPointPerformanceTestSuite();
+};
+
+PointToPointPerformanceTestSuite::PointToPointPerformanceTestSuite()
+    : TestSuite("devices-point-to-point-performance", PERFORMANCE)
+{
+    AddTestCase(new PointToPointDumbbellPerformanceTest(4, 10000), TestCase::QUICK);
+}
+
+static PointToPointPerformanceTestSuite g_pointToPointPerformanceTestSuite; //!< The testsuite
@@ -0,0 +1,181 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/mobility-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-socket-client.h"
+#include "ns3/packet-socket-helper.h"
+#include "ns3/packet-socket-server.h"
+#include "ns3/position-allocator.h"
+#include "ns3/simulator.h"
+#include "ns3/ssid.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-helper.h"
+#include "ns3/wifi-mac-helper.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <chrono>
+#include <cmath>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Measure the speed of the simulation of an infrastructure network.
+ *
+ * The stations associate with the access point, then each of them sends
+ * packets to the access point.  The offered load is well below the
+ * capacity of the network.
+ */
+class WifiInfrastructurePerformanceTest : public TestCase
+{
+  public:
+    /**
+     * \brief Create the test
+     *
+     * \param stations The number of stations.
+     * \param packets The number of packets sent by each station.
+     */
+    WifiInfrastructurePerformanceTest(uint32_t stations, uint32_t packets);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Count a packet received by the access point
+     *
+     * \param packet The received packet.
+     * \param from The address of the sender.
+     */
+    void Receive(Ptr<const Packet> packet, const Address& from);
+
+    uint32_t m_stations; //!< The number of stations.
+    uint32_t m_packets;  //!< The number of packets of each station.
+    uint32_t m_received; //!< The packets received by the access point.
+};
+
+WifiInfrastructurePerformanceTest::WifiInfrastructurePerformanceTest(uint32_t stations,
+                                                                     uint32_t packets)
+    : TestCase("Infrastructure network of " + std::to_string(stations) + " stations"),
+      m_stations(stations),
+      m_packets(packets),
+      m_received(0)
+{
+}
+
+void
+WifiInfrastructurePerformanceTest::Receive(Ptr<const Packet> packet, const Address& from)
+{
+    m_received++;
+}
+
+void
+WifiInfrastructurePerformanceTest::DoRun()
+{
+    NodeContainer apNode(1);
+    NodeContainer staNodes(m_stations);
+
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel.Create());
+    WifiHelper wifi;
+    WifiMacHelper mac;
+    Ssid ssid("performance");
+    mac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid));
+    NetDeviceContainer staDevices = wifi.Install(phy, mac, staNodes);
+    mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+    NetDeviceContainer apDevice = wifi.Install(phy, mac, apNode);
+    wifi.AssignStreams(apDevice, 0);
+    wifi.AssignStreams(staDevices, 100);
+
+    // The stations are on a circle of 5 m around the access point.
+    Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator>();
+    positions->Add(Vector(0, 0, 0));
+    for (uint32_t i = 0; i < m_stations; ++i)
+    {
+        double angle = 2 * M_PI * i / m_stations;
+        positions->Add(Vector(5 * std::cos(angle), 5 * std::sin(angle), 0));
+    }
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator(positions);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(apNode);
+    mobility.Install(staNodes);
+
+    PacketSocketHelper packetSocket;
+    packetSocket.Install(apNode);
+    packetSocket.Install(staNodes);
+
+    PacketSocketAddress server;
+    server.SetSingleDevice(apDevice.Get(0)->GetIfIndex());
+    server.SetProtocol(1);
+    Ptr<PacketSocketServer> serverApp = CreateObject<PacketSocketServer>();
+    serverApp->SetLocal(server);
+    serverApp->TraceConnectWithoutContext(
+        "Rx",
+        MakeCallback(&WifiInfrastructurePerformanceTest::Receive, this));
+    apNode.Get(0)->AddApplication(serverApp);
+
+    // The stations start sending once they are associated.
+    for (uint32_t i = 0; i < m_stations; ++i)
+    {
+        PacketSocketAddress remote;
+        remote.SetSingleDevice(staDevices.Get(i)->GetIfIndex());
+        remote.SetPhysicalAddress(apDevice.Get(0)->GetAddress());
+        remote.SetProtocol(1);
+        Ptr<PacketSocketClient> client = CreateObject<PacketSocketClient>();
+        client->SetAttribute("PacketSize", UintegerValue(1000));
+        client->SetAttribute("MaxPackets", UintegerValue(m_packets));
+        client->SetAttribute("Interval", TimeValue(MilliSeconds(1)));
+        client->SetRemote(remote);
+        client->SetStartTime(Seconds(1) + MicroSeconds(100 * i));
+        staNodes.Get(i)->AddApplication(client);
+    }
+
+    Simulator::Stop(Seconds(2) + MilliSeconds(m_packets));
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t events = Simulator::GetEventCount();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(m_received, m_stations * m_packets, "Packets were lost");
+    ReportMetric("events", events / elapsed.count(), "events/s");
+    ReportMetric("packets", m_received / elapsed.count(), "packets/s");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief TestSuite for the speed of the wifi model
+ */
+class WifiPerformanceTestSuite : public TestSuite
+{
+  public:
+    WifiPerformanceTestSuite();
+};
+
+WifiPerformanceTestSuite::WifiPerformanceTestSuite()
+    : TestSuite("wifi-performance", PERFORMANCE)
+{
+    AddTestCase(new WifiInfrastructurePerformanceTest(4, 2000), TestCase::QUICK);
+}
+
+static WifiPerformanceTestSuite g_wifiPerformanceTestSuite; //!< the test suite
@@ -26,6 +26,7 @@ import signal
 import xml.dom.minidom
 import shutil
 import fnmatch
+import json
 
 from utils import get_list_from_file
 
@@ -294,6 +295,38 @@ def translate_to_text(results_file, text_file):
 
     print('done.')
 
+#
+# Compare the performance metrics of a test suite, as written in JSON by
+# the test-runner, to those of the same suite in a baseline written by
+# --json.  Only the suites which report metrics are compared, and the
+# peak resident set size is compared with their metrics.  Returns the
+# list of the regressions, as messages.
+#
+def compare_to_baseline(results, baseline, tolerance):
+    regressions = []
+    if not results["metrics"]:
+        return regressions
+    for suite in baseline["suites"]:
+        if suite["suite"] != results["suite"]:
+            continue
+        metrics = list(results["metrics"])
+        reference = dict(((m["test"], m["name"]), m) for m in suite["metrics"])
+        if results["peakRssKiB"] > 0 and suite["peakRssKiB"] > 0:
+            rss = {"test": results["suite"], "name": "peak RSS", "unit": "KiB", "higherIsBetter": False}
+            metrics.append(dict(rss, value=results["peakRssKiB"]))
+            reference[(rss["test"], rss["name"])] = dict(rss, value=suite["peakRssKiB"])
+        for metric in metrics:
+            base = reference.get((metric["test"], metric["name"]))
+            if base is None or base["value"] == 0:
+                continue
+            change = metric["value"] / base["value"] - 1
+            if (metric["higherIsBetter"] and change < -tolerance) or \
+               (not metric["higherIsBetter"] and change > tolerance):
+                regressions.append("%s: %s: %g %s, baseline %g %s (%+.1f%%)" % (metric["test"],
+                    metric["name"], metric["value"], metric["unit"], base["value"], base["unit"],
+                    100 * change))
+    return regressions
+
 #
 # A simple example of writing an HTML file with a test result summary.  It is
 # expected that this will eventually be made prettier as time progresses and
@@ -856,6 +889,7 @@ class Job:
         self.tempdir = ""
         self.cwd = ""
         self.tmp_file_name = ""
+        self.json_file_name = ""
         self.returncode = False
         self.elapsed_time = 0
         self.build_path = ""
@@ -961,6 +995,7 @@ class Job:
     #
     def set_tmp_file_name(self, tmp_file_name):
         self.tmp_file_name = tmp_file_name
+        self.json_file_name = os.path.splitext(tmp_file_name)[0] + ".json"
 
     #
     # The return code received when the job process is executed.
@@ -1039,6 +1074,8 @@ class worker_thread(threading.Thread):
                         update_data = '--update-data'
                     else:
                         update_data = ''
+                    if len(options.json) or len(options.baseline):
+                        update_data += ' --json=%s' % job.json_file_name
                     (job.returncode, standard_out, standard_err, et) = run_job_synchronously(job.shell_command +
                         " --xml --tempdir=%s --out=%s %s" % (job.tempdir, job.tmp_file_name, update_data),
                         job.cwd, options.valgrind, False)
@@ -1421,6 +1458,23 @@ def run_tests():
             processors = options.process_limit
             print('Limiting to %s worker processes' % processors)
 
+    #
+    # Performance test suites measure their own speed, so do not let them
+    # compete with each other for the processors.
+    #
+    if options.constrain == 'performance' and processors > 1:
+        print('Running performance tests one at a time')
+        processors = 1
+
+    #
+    # Read the baseline of the performance metrics, if any.
+    #
+    baseline = None
+    if len(options.baseline):
+        with open(options.baseline) as f:
+            baseline = json.load(f)
+    json_results = []
+
     #
     # Now, spin up one thread per processor which will eventually mean one test
     # per processor running concurrently.
@@ -1727,6 +1781,23 @@ def run_tests():
         else:
             kind = "TestSuite"
 
+        #
+        # Read the performance metrics of a test suite which ran to
+        # completion, and fail it if they regressed from the baseline.
+        #
+        regressions = []
+        if not job.is_skip and kind == "TestSuite" and job.returncode in (0, 1) and \
+           (len(options.json) or baseline is not None) and os.path.exists(job.json_file_name):
+            # The test runner writes an array of the suites it ran.
+            with open(job.json_file_name) as f:
+                suites = json.load(f)
+            json_results.extend(suites)
+            if baseline is not None:
+                for results in suites:
+                    regressions += compare_to_baseline(results, baseline, options.tolerance)
+                if regressions:
+                    job.returncode = 1
+
         if job.is_skip:
             status = "SKIP"
             status_print = colors.GREY + status + colors.NORMAL
@@ -1758,6 +1829,8 @@ def run_tests():
             print("%s (%.3f): %s %s" % (status_print, job.elapsed_time, kind, job.display_name))
         else:
             print("%s: %s %s" % (status_print, kind, job.display_name))
+        for regression in regressions:
+            print("    Performance regression: %s" % regression)
 
         if job.is_example or job.is_pyexample:
             #
@@ -1892,7 +1965,7 @@ def run_tests():
     # The last things to do are to translate the XML results file to "human
     # readable form" if the user asked for it (or make an XML file somewhere)
     #
-    if len(options.html) + len(options.text) + len(options.xml):
+    if len(options.html) + len(options.text) + len(options.xml) + len(options.json):
         print()
 
     if len(options.html):
@@ -1907,6 +1980,14 @@ def run_tests():
         shutil.copyfile(xml_results_file, xml_file)
         print('done.')
 
+    if len(options.json):
+        print('Writing performance results to json file %s...' % options.json, end='')
+        with open(options.json, 'w') as f:
+            json_results.sort(key=lambda results: results["suite"])
+            json.dump({"suites": json_results}, f, indent=2)
+            f.write('\n')
+        print('done.')
+
     #
     # Let the user know if they need to turn on tests or examples.
     #
@@ -2010,6 +2091,18 @@ def main(argv):
                       metavar="XML-FILE",
                       help="write detailed test results into XML-FILE.xml")
 
+    parser.add_option("--json", action="store", type="string", dest="json", default="",
+                      metavar="JSON-FILE",
+                      help="write the timing and the performance metrics of the test suites into JSON-FILE")
+
+    parser.add_option("--baseline", action="store", type="string", dest="baseline", default="",
+                      metavar="JSON-FILE",
+                      help="fail the test suites whose performance metrics regressed from those of JSON-FILE, written by --json")
+
+    parser.add_option("--tolerance", action="store", type="float", dest="tolerance", default=0.1,
+                      metavar="FRACTION",
+                      help="relative change of a performance metric which is a regression (defaults to 0.1)")
+
     parser.add_option("--nocolor", action="store_true", dest="nocolor", default=False,
                       help="do not use colors in the standard output")
     parser.add_option("--jobs", action="store", type="int", dest="process_limit", default=0,
@@ -0,0 +1,178 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/**
+ * \file
+ * Benchmark of the cost of invoking and copying a Callback, compared
+ * to the same operations on a std::function.
+ */
+
+using namespace ns3;
+
+/** Sink of the benchmarked calls, to keep them from being optimized out. */
+volatile uint64_t g_sink = 0;
+
+/**
+ * Target function.
+ * \param [in] a First argument.
+ * \param [in] b Second argument.
+ */
+void
+Function(uint32_t a, uint32_t b)
+{
+    g_sink += a + b;
+}
+
+/** Target object. */
+class Target : public SimpleRefCount<Target>
+{
+  public:
+    /**
+     * Target method.
+     * \param [in] a First argument.
+     * \param [in] b Second argument.
+     */
+    void Method(uint32_t a, uint32_t b)
+    {
+        g_sink += a * b;
+    }
+
+    /**
+     * Target method with a bound argument.
+     * \param [in] c Bound argument.
+     * \param [in] a First argument.
+     * \param [in] b Second argument.
+     */
+    void BoundMethod(uint32_t c, uint32_t a, uint32_t b)
+    {
+        g_sink += a * b + c;
+    }
+};
+
+/**
+ * Print the time per operation of a loop.
+ * \tparam F \deduced The type of the loop.
+ * \param [in] name The name of the benchmark.
+ * \param [in] n The number of iterations.
+ * \param [in] f The loop, called with \p n.
+ */
+template <typename F>
+void
+Run(const std::string& name, uint32_t n, F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f(n);
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / n;
+    std::cout << std::left << std::setw(32) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(10) << ns << " ns" << std::endl;
+}
+
+/**
+ * Benchmark a Callback and the equivalent std::function.
+ * \tparam CB \deduced The Callback type.
+ * \param [in] name The name of the benchmark.
+ * \param [in] n The number of iterations.
+ * \param [in] cb The Callback, called with (i, i).
+ * \param [in] func The equivalent std::function.
+ */
+template <typename CB>
+void
+Bench(const std::string& name,
+      uint32_t n,
+      CB cb,
+      const std::function<void(uint32_t, uint32_t)>& func)
+{
+    Run(name + " invoke", n, [&cb](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            cb(i, i);
+        }
+    });
+    Run("  std::function invoke", n, [&func](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            func(i, i);
+        }
+    });
+    Run(name + " copy", n, [&cb](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            CB copy = cb;
+            copy(i, i);
+        }
+    });
+    Run("  std::function copy", n, [&func](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            std::function<void(uint32_t, uint32_t)> copy = func;
+            copy(i, i);
+        }
+    });
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 10000000;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("n", "Number of iterations of every benchmark", n);
+    cmd.Parse(argc, argv);
+
+    Ptr<Target> target = Create<Target>();
+
+    std::cout << "sizeof(Callback<void, uint32_t, uint32_t>) = "
+              << sizeof(Callback<void, uint32_t, uint32_t>) << std::endl;
+
+    Bench("function", n, MakeCallback(&Function), &Function);
+    Bench("method", n, MakeCallback(&Target::Method, target), [target](uint32_t a, uint32_t b) {
+        target->Method(a, b);
+    });
+    Bench("bound method",
+          n,
+          MakeCallback(&Target::BoundMethod, target, 3),
+          [target](uint32_t a, uint32_t b) { target->BoundMethod(3, a, b); });
+    uint32_t c = 7;
+    Bench(
+        "lambda",
+        n,
+        Callback<void, uint32_t, uint32_t>([c](uint32_t a, uint32_t b) { g_sink += a + b + c; }),
+        [c](uint32_t a, uint32_t b) { g_sink += a + b + c; });
+
+    std::cout << "construct and destroy:" << std::endl;
+    Run("  MakeCallback method", n, [target](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            MakeCallback(&Target::Method, target)(i, i);
+        }
+    });
+    Run("  MakeBoundCallback function", n, [](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            MakeBoundCallback(&Function, i)(i);
+        }
+    });
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the time spent resolving Config paths through
+// the NodeList and DeviceList of topologies of increasing size, both
+// with one path per node and with a single wildcard path.
+// Sample usage:  ./ns3 run 'bench-config --nodes=100,1000,10000'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+/** Number of packets seen by the sinks. */
+uint64_t g_count = 0;
+
+/**
+ * Trace sink.
+ * \param [in] packet The traced packet.
+ */
+void
+Sink(Ptr<const Packet> /* packet */)
+{
+    g_count++;
+}
+
+/**
+ * Trace sink with context.
+ * \param [in] context The context.
+ * \param [in] packet The traced packet.
+ */
+void
+ContextSink(std::string /* context */, Ptr<const Packet> /* packet */)
+{
+    g_count++;
+}
+
+/**
+ * Print the time spent in a loop of Config operations.
+ * \tparam F \deduced The type of the loop.
+ * \param [in] name The name of the benchmark.
+ * \param [in] f The loop.
+ */
+template <typename F>
+void
+Run(const std::string& name, F f)
+{
+    Config::ResetResolutionStats();
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    Config::ResolutionStats stats = Config::GetResolutionStats();
+    std::cout << std::setw(32) << name << std::fixed << std::setprecision(3) << std::setw(14)
+              << std::chrono::duration<double, std::milli>(end - start).count() << std::setw(14)
+              << stats.seconds * 1e3 << std::setw(10) << stats.lookups << std::setw(10)
+              << stats.compiles << std::setw(10) << stats.matches << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string nodes = "100,1000,10000";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("nodes", "Comma separated numbers of nodes", nodes);
+    cmd.Parse(argc, argv);
+
+    const std::string device = "/DeviceList/0/$ns3::SimpleNetDevice/";
+    const std::string wildcard = "/NodeList/*/DeviceList/*/$ns3::SimpleNetDevice/";
+
+    std::istringstream iss(nodes);
+    std::string item;
+    while (std::getline(iss, item, ','))
+    {
+        uint32_t n = std::stoul(item);
+        NodeContainer c;
+        c.Create(n);
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            c.Get(i)->AddDevice(CreateObject<SimpleNetDevice>());
+        }
+
+        std::cout << n << " nodes" << std::endl;
+        std::cout << std::setw(32) << "" << std::setw(14) << "total (ms)" << std::setw(14)
+                  << "resolve (ms)" << std::setw(10) << "lookups" << std::setw(10) << "compiles"
+                  << std::setw(10) << "matches" << std::endl;
+        Run("Set per node", [n, &device]() {
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                Config::Set("/NodeList/" + std::to_string(i) + device + "DataRate",
+                            DataRateValue(DataRate("1Gbps")));
+            }
+        });
+        Run("Set wildcard", [&wildcard]() {
+            Config::Set(wildcard + "DataRate", DataRateValue(DataRate("10Gbps")));
+        });
+        Run("ConnectWithoutContext per node", [n, &device]() {
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                Config::ConnectWithoutContext("/NodeList/" + std::to_string(i) + device +
+                                                  "PhyRxDrop",
+                                              MakeCallback(&Sink));
+            }
+        });
+        Run("Connect wildcard", [&wildcard]() {
+            Config::Connect(wildcard + "PhyRxDrop", MakeCallback(&ContextSink));
+        });
+
+        Simulator::Destroy();
+    }
+
+    return 0;
+}
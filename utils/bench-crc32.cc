@@ -0,0 +1,115 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the throughput of the CRC-32 implementations, and
+// of the FCS computation of EthernetTrailer, for frames of 64 bytes to
+// 9 KB.
+// Sample usage:  ./ns3 run 'bench-crc32 --bytes=100000000 --sizes=64,1518,9216'
+
+#include "ns3/command-line.h"
+#include "ns3/crc32.h"
+#include "ns3/ethernet-trailer.h"
+#include "ns3/packet.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/** Sum of the checksums, so that they are not optimized out. */
+uint32_t g_sum = 0;
+
+/**
+ * Compute the CRC-32 of frames.
+ * \param [in] frame The frame.
+ * \param [in] n The number of times the CRC-32 is computed.
+ * \param [in] implementation The implementation of the CRC-32.
+ * \returns The wall clock time per frame, in ns.
+ */
+double
+RunCrc32(const std::vector<uint8_t>& frame, uint32_t n, Crc32Implementation implementation)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        g_sum += CRC32Calculate(frame.data(), frame.size(), implementation);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / n;
+}
+
+/**
+ * Compute and check the FCS of packets, as a device with FCS enabled does.
+ * \param [in] frame The frame.
+ * \param [in] n The number of packets.
+ * \returns The wall clock time per packet, in ns.
+ */
+double
+RunTrailer(const std::vector<uint8_t>& frame, uint32_t n)
+{
+    Ptr<Packet> packet = Create<Packet>(frame.data(), frame.size());
+    EthernetTrailer trailer;
+    trailer.EnableFcs(true);
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        trailer.CalcFcs(packet);
+        g_sum += trailer.CheckFcs(packet);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / n;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t bytes = 100000000;
+    std::string sizes = "64,128,256,512,1024,1518,4096,9216";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("bytes", "Number of bytes checksummed for each frame size", bytes);
+    cmd.AddValue("sizes", "Comma separated frame sizes, in bytes", sizes);
+    cmd.Parse(argc, argv);
+
+    std::cout << "PCLMUL " << (CRC32IsSupported(CRC32_PCLMUL) ? "supported" : "not supported")
+              << std::endl;
+    std::cout << std::setw(8) << "bytes" << std::setw(12) << "bytewise" << std::setw(12)
+              << "slice-by-8" << std::setw(12) << "pclmul" << std::setw(12) << "trailer"
+              << "   (ns/frame)" << std::endl;
+    std::istringstream iss(sizes);
+    std::string item;
+    while (std::getline(iss, item, ','))
+    {
+        std::vector<uint8_t> frame(std::stoul(item));
+        for (uint32_t i = 0; i < frame.size(); ++i)
+        {
+            frame[i] = i * 7;
+        }
+        uint32_t n = bytes / frame.size() + 1;
+        std::cout << std::setw(8) << frame.size() << std::fixed << std::setprecision(1);
+        for (auto implementation : {CRC32_BYTEWISE, CRC32_SLICE_BY_8, CRC32_PCLMUL})
+        {
+            std::cout << std::setw(12) << RunCrc32(frame, n, implementation);
+        }
+        // Two checksums per packet, and the copies of the packet
+        std::cout << std::setw(12) << RunTrailer(frame, n / 2) << std::endl;
+    }
+
+    return 0;
+}
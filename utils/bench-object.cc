@@ -0,0 +1,179 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the cost of Object::GetObject on an aggregate of
+// several Objects, compared to a linear search of the aggregates which
+// climbs the TypeId parents of each of them.
+// Sample usage:  ./ns3 run 'bench-object --n=1000000'
+
+#include "ns3/core-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+/** Number of Objects found, to keep the lookups from being optimized out. */
+uint64_t g_found = 0;
+
+/**
+ * Base class of the aggregated Objects, giving them a deeper TypeId hierarchy.
+ */
+class BenchBase : public Object
+{
+  public:
+    /**
+     * Register this type.
+     * \return The TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::BenchBase").SetParent<Object>().SetGroupName("Core");
+        return tid;
+    }
+};
+
+/**
+ * An aggregated Object.
+ * \tparam N \explicit The index of the Object type.
+ */
+template <int N>
+class BenchObject : public BenchBase
+{
+  public:
+    /**
+     * Register this type.
+     * \return The TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::BenchObject<" + std::to_string(N) + ">")
+                                .SetParent<BenchBase>()
+                                .SetGroupName("Core")
+                                .AddConstructor<BenchObject<N>>();
+        return tid;
+    }
+};
+
+/**
+ * Find an Object the way GetObject did before the lookup table.
+ * \param [in] object The aggregate.
+ * \param [in] tid The TypeId.
+ * \return The Object, if any.
+ */
+Ptr<const Object>
+LinearGetObject(Ptr<const Object> object, TypeId tid)
+{
+    TypeId objectTid = Object::GetTypeId();
+    Object::AggregateIterator it = object->GetAggregateIterator();
+    while (it.HasNext())
+    {
+        Ptr<const Object> current = it.Next();
+        TypeId cur = current->GetInstanceTypeId();
+        while (cur != tid && cur != objectTid)
+        {
+            cur = cur.GetParent();
+        }
+        if (cur == tid)
+        {
+            return current;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Print the time per lookup of a loop.
+ * \tparam F \deduced The type of the loop.
+ * \param [in] name The name of the benchmark.
+ * \param [in] n The number of lookups.
+ * \param [in] f The loop, called with \p n.
+ */
+template <typename F>
+void
+Run(const std::string& name, uint32_t n, F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f(n);
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / n;
+    std::cout << std::left << std::setw(40) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(10) << ns << " ns" << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 1000000;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("n", "Number of lookups of every benchmark", n);
+    cmd.Parse(argc, argv);
+
+    // An aggregate of eight Objects, like a Node with its protocols.
+    Ptr<Object> object = CreateObject<BenchObject<0>>();
+    object->AggregateObject(CreateObject<BenchObject<1>>());
+    object->AggregateObject(CreateObject<BenchObject<2>>());
+    object->AggregateObject(CreateObject<BenchObject<3>>());
+    object->AggregateObject(CreateObject<BenchObject<4>>());
+    object->AggregateObject(CreateObject<BenchObject<5>>());
+    object->AggregateObject(CreateObject<BenchObject<6>>());
+    object->AggregateObject(CreateObject<BenchObject<7>>());
+
+    Run("GetObject first", n, [object](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            g_found += object->GetObject<BenchObject<0>>() ? 1 : 0;
+        }
+    });
+    Run("GetObject last", n, [object](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            g_found += object->GetObject<BenchObject<7>>() ? 1 : 0;
+        }
+    });
+    Run("GetObject missing", n, [object](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            g_found += object->GetObject<BenchObject<8>>() ? 1 : 0;
+        }
+    });
+    TypeId first = BenchObject<0>::GetTypeId();
+    TypeId last = BenchObject<7>::GetTypeId();
+    TypeId missing = BenchObject<8>::GetTypeId();
+    Run("linear search first", n, [object, first](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            g_found += LinearGetObject(object, first) ? 1 : 0;
+        }
+    });
+    Run("linear search last", n, [object, last](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            g_found += LinearGetObject(object, last) ? 1 : 0;
+        }
+    });
+    Run("linear search missing", n, [object, missing](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            g_found += LinearGetObject(object, missing) ? 1 : 0;
+        }
+    });
+
+    object->Dispose();
+    return 0;
+}
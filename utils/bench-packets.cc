@@ -32,6 +32,7 @@
 #include <sstream>
 #include <stdlib.h> // for exit ()
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -332,6 +333,25 @@ benchFragment(uint32_t n)
     }
 }
 
+static void
+benchReassembly(uint32_t n)
+{
+    BenchHeader<25> ipv4;
+    static uint8_t payload[9000];
+    Ptr<Packet> original = Create<Packet>(payload, sizeof(payload));
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = original->CreateFragment(0, 1000);
+        for (uint32_t offset = 1000; offset < sizeof(payload); offset += 1000)
+        {
+            p->AddAtEnd(original->CreateFragment(offset, 1000));
+        }
+        p->AddHeader(ipv4);
+        p->RemoveHeader(ipv4);
+    }
+}
+
 static void
 benchByteTags(uint32_t n)
 {
@@ -350,6 +370,25 @@ benchByteTags(uint32_t n)
     }
 }
 
+static void
+benchMixedSizes(uint32_t n)
+{
+    BenchHeader<25> ipv4;
+    BenchHeader<8> udp;
+    const uint32_t sizes[] = {64, 1500, 9000};
+    static uint8_t payload[9000];
+    // Keep a few packets alive, like a device queue does.
+    std::vector<Ptr<Packet>> queue(16);
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(payload, sizes[i % 3]);
+        p->AddHeader(udp);
+        p->AddHeader(ipv4);
+        queue[i % queue.size()] = p->Copy();
+    }
+}
+
 static uint64_t
 runBenchOneIteration(void (*bench)(uint32_t), uint32_t n)
 {
@@ -382,6 +421,8 @@ main(int argc, char* argv[])
     uint32_t n = 0;
     uint32_t minIterations = 1;
     bool enablePrinting = false;
+    bool scatterGather = false;
+    bool pool = true;
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark Packet class");
@@ -390,8 +431,23 @@ main(int argc, char* argv[])
                  "number of subiterations to minimize iteration time over",
                  minIterations);
     cmd.AddValue("enable-printing", "enable packet printing", enablePrinting);
+    cmd.AddValue("scatter-gather", "enable scatter-gather packet bodies", scatterGather);
+    cmd.AddValue("pool", "keep the deleted packets in a pool", pool);
     cmd.Parse(argc, argv);
 
+    if (enablePrinting)
+    {
+        Packet::EnablePrinting();
+    }
+    if (scatterGather)
+    {
+        Packet::EnableScatterGather();
+    }
+    if (!pool)
+    {
+        Packet::DisablePool();
+    }
+
     if (n == 0)
     {
         std::cerr << "Error-- number of packets must be specified "
@@ -407,6 +463,18 @@ main(int argc, char* argv[])
     runBench(&benchD, n, minIterations, "Intermixed add/remove headers and tags");
     runBench(&benchFragment, n, minIterations, "Fragmentation and concatenation");
     runBench(&benchByteTags, n, minIterations, "Benchmark byte tags");
+    runBench(&benchReassembly, n, minIterations, "Reassembly of 9 fragments");
+
+    Buffer::AllocatorStats before = Buffer::GetAllocatorStats();
+    runBench(&benchMixedSizes, n, minIterations, "Mixed 64, 1500 and 9000 byte packets");
+    Buffer::AllocatorStats after = Buffer::GetAllocatorStats();
+    std::cout << "Buffer storage of the mixed packets: " << after.hits - before.hits
+              << " reused, " << after.misses - before.misses << " allocated and "
+              << after.releases - before.releases << " freed on the heap" << std::endl;
+
+    Packet::PoolStats poolStats = Packet::GetPoolStats();
+    std::cout << "Packets: " << poolStats.hits << " reused from the pool, " << poolStats.misses
+              << " allocated and " << poolStats.releases << " freed on the heap" << std::endl;
 
     return 0;
 }
@@ -0,0 +1,141 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the per-packet cost of enqueuing packets in a
+// DropTailQueue and dequeuing them, for several queue occupancies, and the
+// cost of the containers a Queue can store its packets in.
+// Sample usage:  ./ns3 run 'bench-queue --n=1000000 --occupancy=1,100,10000'
+
+#include "ns3/command-line.h"
+#include "ns3/drop-tail-queue.h"
+#include "ns3/packet.h"
+#include "ns3/ring-buffer.h"
+
+#include <chrono>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * Enqueue and dequeue packets in a DropTailQueue.
+ * \param [in] n The number of packets.
+ * \param [in] occupancy The number of packets in the queue.
+ * \param [in] burst Whether the packets are enqueued and dequeued by
+ * bursts of occupancy packets, rather than one at a time in a queue
+ * holding occupancy packets.
+ * \returns The wall clock time per packet, in ns.
+ */
+double
+RunQueue(uint32_t n, uint32_t occupancy, bool burst)
+{
+    Ptr<DropTailQueue<Packet>> queue = CreateObject<DropTailQueue<Packet>>();
+    queue->SetMaxSize(QueueSize(QueueSizeUnit::PACKETS, occupancy + 1));
+    Ptr<Packet> packet = Create<Packet>(1000);
+    uint32_t rounds = n / occupancy;
+
+    auto start = std::chrono::steady_clock::now();
+    if (burst)
+    {
+        for (uint32_t r = 0; r < rounds; ++r)
+        {
+            for (uint32_t i = 0; i < occupancy; ++i)
+            {
+                queue->Enqueue(packet);
+            }
+            for (uint32_t i = 0; i < occupancy; ++i)
+            {
+                queue->Dequeue();
+            }
+        }
+    }
+    else
+    {
+        for (uint32_t i = 0; i < occupancy; ++i)
+        {
+            queue->Enqueue(packet);
+        }
+        for (uint32_t i = 0; i < rounds * occupancy; ++i)
+        {
+            queue->Enqueue(packet);
+            queue->Dequeue();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    queue->Dispose();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (rounds * occupancy);
+}
+
+/**
+ * Append packets to a container and pop them from its front, as a
+ * DropTailQueue does.
+ * \tparam Container The container.
+ * \param [in] n The number of packets.
+ * \param [in] occupancy The number of packets in the container.
+ * \returns The wall clock time per packet, in ns.
+ */
+template <typename Container>
+double
+RunContainer(uint32_t n, uint32_t occupancy)
+{
+    Container container;
+    Ptr<Packet> packet = Create<Packet>(1000);
+    for (uint32_t i = 0; i < occupancy; ++i)
+    {
+        container.insert(container.end(), packet);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        container.insert(container.end(), packet);
+        container.erase(container.begin());
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / n;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 1000000;
+    std::string occupancies = "1,10,100,1000,10000";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("n", "Number of packets", n);
+    cmd.AddValue("occupancy", "Comma separated numbers of packets in the queue", occupancies);
+    cmd.Parse(argc, argv);
+
+    std::cout << std::setw(10) << "occupancy" << std::setw(12) << "steady" << std::setw(12)
+              << "burst" << std::setw(12) << "list" << std::setw(12) << "deque" << std::setw(12)
+              << "ring" << "   (ns/packet)" << std::endl;
+    std::istringstream iss(occupancies);
+    std::string item;
+    while (std::getline(iss, item, ','))
+    {
+        uint32_t occupancy = std::stoul(item);
+        std::cout << std::setw(10) << occupancy << std::fixed << std::setprecision(1)
+                  << std::setw(12) << RunQueue(n, occupancy, false) << std::setw(12)
+                  << RunQueue(n, occupancy, true) << std::setw(12)
+                  << RunContainer<std::list<Ptr<Packet>>>(n, occupancy) << std::setw(12)
+                  << RunContainer<std::deque<Ptr<Packet>>>(n, occupancy) << std::setw(12)
+                  << RunContainer<RingBuffer<Ptr<Packet>>>(n, occupancy) << std::endl;
+    }
+
+    return 0;
+}
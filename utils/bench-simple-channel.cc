@@ -0,0 +1,123 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures how the cost of sending a frame through a
+// SimpleChannel scales with the number of devices attached to it, for
+// unicast and broadcast frames.
+// Sample usage:  ./ns3 run 'bench-simple-channel --n=100000 --devices=2,32,1024'
+
+#include "ns3/command-line.h"
+#include "ns3/mac48-address.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+/** Number of frames received. */
+uint64_t g_received = 0;
+
+/**
+ * Receive callback of the devices.
+ * \returns true
+ */
+bool
+Receive(Ptr<NetDevice> /* device */,
+        Ptr<const Packet> /* packet */,
+        uint16_t /* protocol */,
+        const Address& /* sender */)
+{
+    g_received++;
+    return true;
+}
+
+/**
+ * Send frames through a channel, each device in turn sending one frame to
+ * the next device, or to the broadcast address.
+ * \param [in] n The number of frames.
+ * \param [in] devices The number of devices attached to the channel.
+ * \param [in] broadcast Whether the frames are broadcast.
+ * \returns The wall clock time per frame, in ns.
+ */
+double
+Run(uint32_t n, uint32_t devices, bool broadcast)
+{
+    NodeContainer nodes(devices);
+    SimpleNetDeviceHelper helper;
+    NetDeviceContainer container = helper.Install(nodes);
+    for (uint32_t i = 0; i < devices; ++i)
+    {
+        container.Get(i)->SetReceiveCallback(MakeCallback(&Receive));
+    }
+
+    Ptr<Packet> packet = Create<Packet>(1000);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        Ptr<NetDevice> device = container.Get(i % devices);
+        Address destination = broadcast ? device->GetBroadcast()
+                                        : container.Get((i + 1) % devices)->GetAddress();
+        Simulator::Schedule(MicroSeconds(i),
+                            &NetDevice::Send,
+                            device,
+                            packet->Copy(),
+                            destination,
+                            0x0800);
+    }
+
+    g_received = 0;
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    auto end = std::chrono::steady_clock::now();
+    Simulator::Destroy();
+    return std::chrono::duration<double, std::nano>(end - start).count() / n;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 100000;
+    std::string devices = "2,4,16,64,256,1024";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("n", "Number of frames", n);
+    cmd.AddValue("devices", "Comma separated numbers of devices attached to the channel", devices);
+    cmd.Parse(argc, argv);
+
+    std::cout << std::setw(8) << "devices" << std::setw(16) << "unicast" << std::setw(16)
+              << "broadcast" << std::setw(22) << "broadcast/receiver"
+              << "   (ns/frame)" << std::endl;
+    std::istringstream iss(devices);
+    std::string item;
+    while (std::getline(iss, item, ','))
+    {
+        uint32_t count = std::stoul(item);
+        double unicast = Run(n, count, false);
+        // A broadcast frame is received count - 1 times
+        uint32_t frames = std::max<uint32_t>(n / count, 1000);
+        double broadcast = Run(frames, count, true);
+        std::cout << std::setw(8) << count << std::fixed << std::setprecision(1) << std::setw(16)
+                  << unicast << std::setw(16) << broadcast << std::setw(22)
+                  << broadcast / (count - 1) << std::endl;
+    }
+
+    return 0;
+}
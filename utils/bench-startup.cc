@@ -0,0 +1,182 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the time from the start of a process which links
+// all the ns-3 modules to the first event of Simulator::Run.  It runs
+// itself as a child process, which prints the time of its first event,
+// both with the TypeIds registered on demand, and with all of them
+// registered before the run.
+// Sample usage:  ./ns3 run 'bench-startup --runs=50'
+
+#include "ns3/core-module.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <spawn.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+extern char** environ;
+
+using namespace ns3;
+
+/**
+ * Get the time of the monotonic clock, which is shared by the processes.
+ * \return The time, in ns.
+ */
+int64_t
+GetMonotonicTime()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/** Print the time of the first event, for the parent process. */
+void
+PrintTime()
+{
+    std::cout << GetMonotonicTime() << std::endl;
+}
+
+/**
+ * Run the program as a child process, and read the time of its first event.
+ * \param [in] program The path of the program.
+ * \param [in] all Whether the child registers all the TypeIds before the run.
+ * \return The time from the spawn to the first event, in ns, or -1 on error.
+ */
+int64_t
+SpawnChild(const std::string& program, bool all)
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        return -1;
+    }
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&actions, fds[0]);
+    posix_spawn_file_actions_addclose(&actions, fds[1]);
+
+    std::string path = program;
+    std::string child = "--child=1";
+    std::string registerAll = std::string("--all=") + (all ? "1" : "0");
+    char* argv[] = {&path[0], &child[0], &registerAll[0], nullptr};
+
+    int64_t start = GetMonotonicTime();
+    pid_t pid;
+    int error = posix_spawn(&pid, path.c_str(), &actions, nullptr, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fds[1]);
+    if (error != 0)
+    {
+        close(fds[0]);
+        return -1;
+    }
+
+    FILE* output = fdopen(fds[0], "r");
+    long long firstEvent = -1;
+    if (std::fscanf(output, "%lld", &firstEvent) != 1)
+    {
+        firstEvent = -1;
+    }
+    std::fclose(output);
+    int status;
+    waitpid(pid, &status, 0);
+    if (firstEvent < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+        return -1;
+    }
+    return firstEvent - start;
+}
+
+/**
+ * Print the statistics of the startup times of a few child processes.
+ * \param [in] program The path of the program.
+ * \param [in] all Whether the children register all the TypeIds before the run.
+ * \param [in] runs The number of child processes.
+ * \return \c true if all the children ran.
+ */
+bool
+Bench(const std::string& program, bool all, uint32_t runs)
+{
+    std::vector<double> times;
+    for (uint32_t i = 0; i < runs; ++i)
+    {
+        int64_t ns = SpawnChild(program, all);
+        if (ns < 0)
+        {
+            std::cerr << "Failed to run " << program << std::endl;
+            return false;
+        }
+        times.push_back(ns / 1e6);
+    }
+    std::sort(times.begin(), times.end());
+    double mean = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+    std::cout << std::left << std::setw(12) << (all ? "all" : "on demand") << std::right
+              << std::fixed << std::setprecision(3) << std::setw(10) << times.front()
+              << std::setw(10) << times[times.size() / 2] << std::setw(10) << mean
+              << std::setw(10) << times.back() << std::endl;
+    return true;
+}
+
+int
+main(int argc, char* argv[])
+{
+    bool child = false;
+    bool all = false;
+    uint32_t runs = 20;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("child", "Run as a child process, and print the time of the first event", child);
+    cmd.AddValue("all", "In a child process, register all the TypeIds before the run", all);
+    cmd.AddValue("runs", "Number of child processes for each registration", runs);
+    cmd.Parse(argc, argv);
+
+    if (child)
+    {
+        if (all)
+        {
+            TypeId::GetRegisteredN();
+        }
+        Simulator::Schedule(Seconds(0), &PrintTime);
+        Simulator::Run();
+        Simulator::Destroy();
+        return 0;
+    }
+
+    if (runs == 0)
+    {
+        std::cerr << "At least one run is needed" << std::endl;
+        return 1;
+    }
+    std::cout << "Time from the process start to Simulator::Run, in ms, over " << runs
+              << " runs" << std::endl;
+    std::cout << std::left << std::setw(12) << "TypeIds" << std::right << std::setw(10) << "min"
+              << std::setw(10) << "median" << std::setw(10) << "mean" << std::setw(10) << "max"
+              << std::endl;
+    if (!Bench(argv[0], false, runs) || !Bench(argv[0], true, runs))
+    {
+        return 1;
+    }
+    return 0;
+}
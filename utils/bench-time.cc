@@ -0,0 +1,163 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/**
+ * \file
+ * Benchmark of the conversions of Time to and from integers and doubles,
+ * as done by the SimBricks adapters which read Simulator::Now() on every
+ * message.
+ */
+
+using namespace ns3;
+
+/** Sink of the benchmarked conversions, to keep them from being optimized out. */
+volatile uint64_t g_sink = 0;
+
+/**
+ * The clock of the SimBricks adapters, as in src/simbricks/model/simbricks-base.h,
+ * which is not built without the SimBricks libraries.
+ */
+class Adapter
+{
+  public:
+    /**
+     * Get the current time, as the SimBricks protocol timestamps it.
+     * eturns The current time in picoseconds.
+     */
+    uint64_t curTick()
+    {
+        return Simulator::Now().ToInteger(Time::PS);
+    }
+};
+
+/**
+ * Print the time per operation of a loop.
+ * \tparam F \deduced The type of the loop.
+ * \param [in] name The name of the benchmark.
+ * \param [in] n The number of iterations.
+ * \param [in] f The loop, called with \p n.
+ */
+template <typename F>
+void
+Run(const std::string& name, uint32_t n, F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f(n);
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / n;
+    std::cout << std::left << std::setw(40) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(10) << ns << " ns" << std::endl;
+}
+
+/**
+ * Benchmark Simulator::Now() inside an event.
+ * \param [in] n The number of iterations.
+ */
+void
+BenchNow(uint32_t n)
+{
+    Run("Simulator::Now()", n, [](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            g_sink += Simulator::Now().GetTimeStep();
+        }
+    });
+    Adapter adapter;
+    Run("Adapter::curTick()", n, [&adapter](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            g_sink += adapter.curTick();
+        }
+    });
+    // The delay to the next message, as in Adapter::processInEvent().
+    Run("PicoSeconds(nextTs - curTick())", n, [&adapter](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            uint64_t nextTs = 2000000000 + i;
+            g_sink += PicoSeconds(nextTs - adapter.curTick()).GetTimeStep();
+        }
+    });
+    Run("Simulator::Now().ToInteger(Time::NS)", n, [](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            g_sink += Simulator::Now().ToInteger(Time::NS);
+        }
+    });
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 10000000;
+    std::string resolution = "PS";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("n", "Number of iterations of every benchmark", n);
+    cmd.AddValue("resolution", "Time resolution: PS or NS", resolution);
+    cmd.Parse(argc, argv);
+
+    if (resolution == "PS")
+    {
+        Time::SetResolution(Time::PS);
+    }
+    else if (resolution == "NS")
+    {
+        Time::SetResolution(Time::NS);
+    }
+    else
+    {
+        std::cerr << "Unknown resolution " << resolution << std::endl;
+        return 1;
+    }
+    std::cout << "Resolution " << resolution << std::endl;
+
+    Simulator::Schedule(NanoSeconds(1234567), &BenchNow, n);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    Run("PicoSeconds(i)", n, [](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            g_sink += PicoSeconds(i).GetTimeStep();
+        }
+    });
+    Run("NanoSeconds(i)", n, [](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            g_sink += NanoSeconds(i).GetTimeStep();
+        }
+    });
+    Run("Time::ToDouble(Time::PS)", n, [](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            g_sink += static_cast<uint64_t>(Time::From(i).ToDouble(Time::PS));
+        }
+    });
+    Run("Time::GetSeconds()", n, [](uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            g_sink += static_cast<uint64_t>(Time::From(i).GetSeconds() * 1e12);
+        }
+    });
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the per-packet cost of the trace sources of a
+// PointToPointNetDevice pipeline, with zero, one and several sinks
+// connected to every trace source of both devices.
+// Sample usage:  ./ns3 run 'bench-traced-callback --n=100000 --sinks=0,1,4'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-helper.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/** Number of packets seen by the sinks. */
+uint64_t g_count = 0;
+
+/**
+ * Trace sink.
+ * \param [in] packet The traced packet.
+ */
+void
+Sink(Ptr<const Packet> /* packet */)
+{
+    g_count++;
+}
+
+/**
+ * Send packets back to back from the first device to the second one.
+ * \param [in] n The number of packets.
+ * \param [in] sinks The number of sinks connected to every trace source.
+ * \returns The wall clock time per packet, in ns.
+ */
+double
+Run(uint32_t n, uint32_t sinks)
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("10Gbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("1us"));
+    NetDeviceContainer devices = p2p.Install(nodes);
+
+    const std::vector<std::string> sources = {"MacTx",
+                                              "MacRx",
+                                              "PhyTxBegin",
+                                              "PhyTxEnd",
+                                              "PhyRxEnd",
+                                              "Sniffer",
+                                              "PromiscSniffer"};
+    for (uint32_t d = 0; d < devices.GetN(); ++d)
+    {
+        for (const auto& source : sources)
+        {
+            for (uint32_t i = 0; i < sinks; ++i)
+            {
+                devices.Get(d)->TraceConnectWithoutContext(source, MakeCallback(&Sink));
+            }
+        }
+    }
+
+    // 1000 bytes take 800 ns at 10 Gb/s: send one packet every microsecond.
+    Ptr<NetDevice> device = devices.Get(0);
+    Address destination = devices.Get(1)->GetAddress();
+    Ptr<Packet> packet = Create<Packet>(1000);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        Simulator::Schedule(MicroSeconds(i),
+                            &NetDevice::Send,
+                            device,
+                            packet->Copy(),
+                            destination,
+                            0x0800);
+    }
+
+    g_count = 0;
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    auto end = std::chrono::steady_clock::now();
+    Simulator::Destroy();
+    return std::chrono::duration<double, std::nano>(end - start).count() / n;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 100000;
+    std::string sinks = "0,1,4";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("n", "Number of packets", n);
+    cmd.AddValue("sinks", "Comma separated numbers of sinks per trace source", sinks);
+    cmd.Parse(argc, argv);
+
+    std::cout << std::setw(8) << "sinks" << std::setw(16) << "ns/packet" << std::setw(16)
+              << "sink calls" << std::endl;
+    std::istringstream iss(sinks);
+    std::string item;
+    while (std::getline(iss, item, ','))
+    {
+        uint32_t count = std::stoul(item);
+        double ns = Run(n, count);
+        std::cout << std::setw(8) << count << std::setw(16) << std::fixed << std::setprecision(1)
+                  << ns << std::setw(16) << g_count << std::endl;
+    }
+
+    return 0;
+}
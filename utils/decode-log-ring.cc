@@ -0,0 +1,53 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/**
+ * \file
+ * Decode a dump of the binary ring buffer logging backend.
+ *
+ * \see LogRingEnable
+ */
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    std::string filename = "ns3-log.ring";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Decode a dump of the binary ring buffer logging backend to stdout.");
+    cmd.AddNonOption("filename", "The dump to decode", filename);
+    cmd.Parse(argc, argv);
+
+    std::ifstream is(filename, std::ios::binary);
+    if (!is)
+    {
+        std::cerr << "Cannot open " << filename << std::endl;
+        return 1;
+    }
+    if (!LogRingDecode(is, std::cout))
+    {
+        std::cerr << filename << " is not a valid dump" << std::endl;
+        return 1;
+    }
+    return 0;
+}